@@ -1,19 +1,278 @@
 #pragma once
 //  bitblock.hpp : bitblock class
 //
-// Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////////////
+// select the storage engine of the bitblock
+// BITBLOCK_LIMB_ENGINE = 1 stores the bits in 64-bit limbs and implements the arithmetic
+// helpers with word-level operations, BITBLOCK_LIMB_ENGINE = 0 selects the original
+// std::bitset based engine that processes one bit at a time.
+#if !defined(BITBLOCK_LIMB_ENGINE)
+#define BITBLOCK_LIMB_ENGINE 1
+#endif
 
-// this should be removed when we have made the transition away from std::bitset to sw::unum::bitblock
-#include <cassert>
+#if BITBLOCK_LIMB_ENGINE
+#include "limb_functions.hpp"
+#include "limb_division.hpp"
+#else
 #include <bitset>
+#endif
 
 namespace sw {
 	namespace unum {
 
+#if BITBLOCK_LIMB_ENGINE
+		// bitblock is a template class implementing efficient multi-precision binary arithmetic and logic
+		// The bits are stored in 64-bit limbs, least significant limb first. The interface follows std::bitset.
+		template<size_t nbits>
+		class bitblock {
+		public:
+			static constexpr size_t bitsInBlock = 64;
+			static constexpr size_t nrBlocks = (nbits == 0 ? 1 : (nbits + bitsInBlock - 1) / bitsInBlock);
+			static constexpr size_t topBits = (nbits == 0 ? 0 : nbits - (nrBlocks - 1) * bitsInBlock);  // valid bits in the most significant limb
+			static constexpr uint64_t topMask = (topBits == bitsInBlock ? ~uint64_t(0) : (uint64_t(1) << (topBits % bitsInBlock)) - 1);
+
+			// proxy to a single bit
+			class reference {
+			public:
+				reference(bitblock& bb, size_t pos) : _block(bb._block[blockIndex(pos)]), _mask(uint64_t(1) << (pos % bitsInBlock)) {}
+				reference(const reference&) = default;
+				reference& operator=(bool value) {
+					if (value) _block |= _mask; else _block &= ~_mask;
+					return *this;
+				}
+				reference& operator=(const reference& r) { return operator=(bool(r)); }
+				bool operator~() const { return (_block & _mask) == 0; }
+				operator bool() const { return (_block & _mask) != 0; }
+				reference& flip() { _block ^= _mask; return *this; }
+			private:
+				uint64_t& _block;
+				uint64_t  _mask;
+			};
+
+			bitblock() { setToZero(); }
+
+			bitblock(const bitblock&) = default;
+			bitblock(bitblock&&) = default;
+
+			bitblock& operator=(const bitblock&) = default;
+			bitblock& operator=(bitblock&&) = default;
+
+			bitblock& operator=(unsigned long long rhs) {
+				setToZero();
+				setblock(0, uint64_t(rhs));
+				return *this;
+			}
+
+			void setToZero() { for (size_t i = 0; i < nrBlocks; ++i) _block[i] = 0; }
+			bool load_bits(const std::string& string_of_bits) {
+				if (string_of_bits.length() != nbits) return false;
+				setToZero();
+				int msb = nbits - 1;
+				for (std::string::const_iterator it = string_of_bits.begin(); it != string_of_bits.end(); ++it) {
+					if (*it == '0') {
+						this->reset(msb--);
+					}
+					else if (*it == '1') {
+						this->set(msb--);
+					}
+					else {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			// limb access
+			uint64_t block(size_t i) const { return _block[i]; }
+			void setblock(size_t i, uint64_t value) { _block[i] = (i == nrBlocks - 1 ? value & topMask : value); }
+			// the 64 bits starting at bit position lsb, zero-filled outside of [0, nbits)
+			uint64_t block_at(long long lsb) const {
+				if (lsb <= -(long long)bitsInBlock || lsb >= (long long)nbits) return 0;
+				if (lsb < 0) return _block[0] << size_t(-lsb);
+				size_t i = size_t(lsb) / bitsInBlock;
+				size_t shift = size_t(lsb) % bitsInBlock;
+				uint64_t lo = _block[i] >> shift;
+				if (shift == 0 || i + 1 >= nrBlocks) return lo;
+				return lo | (_block[i + 1] << (bitsInBlock - shift));
+			}
+
+			// bit access
+			bool operator[](size_t pos) const { return (_block[blockIndex(pos)] >> (pos % bitsInBlock)) & 1; }
+			reference operator[](size_t pos) { return reference(*this, pos); }
+			bool test(size_t pos) const {
+				if (pos >= nbits) throw std::out_of_range("bitblock::test argument out of range");
+				return operator[](pos);
+			}
+
+			// modifiers
+			bitblock& set() {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] = ~uint64_t(0);
+				_block[nrBlocks - 1] &= topMask;
+				return *this;
+			}
+			bitblock& set(size_t pos, bool value = true) {
+				if (pos >= nbits) throw std::out_of_range("bitblock::set argument out of range");
+				operator[](pos) = value;
+				return *this;
+			}
+			bitblock& reset() { setToZero(); return *this; }
+			bitblock& reset(size_t pos) {
+				if (pos >= nbits) throw std::out_of_range("bitblock::reset argument out of range");
+				operator[](pos) = false;
+				return *this;
+			}
+			bitblock& flip() {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] = ~_block[i];
+				_block[nrBlocks - 1] &= topMask;
+				return *this;
+			}
+			bitblock& flip(size_t pos) {
+				if (pos >= nbits) throw std::out_of_range("bitblock::flip argument out of range");
+				operator[](pos).flip();
+				return *this;
+			}
+
+			// queries
+			constexpr size_t size() const { return nbits; }
+			size_t count() const {
+				size_t cnt = 0;
+				for (size_t i = 0; i < nrBlocks; ++i) cnt += size_t(popcount(_block[i]));
+				return cnt;
+			}
+			bool any() const { return !limb_is_zero<nrBlocks>(_block); }
+			bool none() const { return !any(); }
+			bool all() const {
+				for (size_t i = 0; i < nrBlocks - 1; ++i) if (_block[i] != ~uint64_t(0)) return false;
+				return _block[nrBlocks - 1] == topMask;
+			}
+
+			// conversions
+			unsigned long long to_ullong() const {
+				for (size_t i = 1; i < nrBlocks; ++i) if (_block[i]) throw std::overflow_error("bitblock::to_ullong value too large");
+				return (unsigned long long)_block[0];
+			}
+			unsigned long to_ulong() const {
+				unsigned long long v = to_ullong();
+				if (v > (unsigned long long)std::numeric_limits<unsigned long>::max()) throw std::overflow_error("bitblock::to_ulong value too large");
+				return (unsigned long)v;
+			}
+			std::string to_string(char zero = '0', char one = '1') const {
+				std::string str(nbits, zero);
+				for (size_t i = 0; i < nbits; ++i) {
+					if (operator[](i)) str[nbits - 1 - i] = one;
+				}
+				return str;
+			}
+
+			// logic operators
+			bitblock& operator&=(const bitblock& rhs) {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] &= rhs._block[i];
+				return *this;
+			}
+			bitblock& operator|=(const bitblock& rhs) {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] |= rhs._block[i];
+				return *this;
+			}
+			bitblock& operator^=(const bitblock& rhs) {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] ^= rhs._block[i];
+				return *this;
+			}
+			bitblock operator~() const {
+				bitblock tmp(*this);
+				return tmp.flip();
+			}
+			bitblock& operator<<=(size_t shift) {
+				if (shift >= nbits) return reset();
+				limb_shift_left<nrBlocks>(_block, shift);
+				_block[nrBlocks - 1] &= topMask;
+				return *this;
+			}
+			bitblock& operator>>=(size_t shift) {
+				if (shift >= nbits) return reset();
+				limb_shift_right<nrBlocks>(_block, shift);
+				return *this;
+			}
+			bitblock operator<<(size_t shift) const {
+				bitblock tmp(*this);
+				return tmp <<= shift;
+			}
+			bitblock operator>>(size_t shift) const {
+				bitblock tmp(*this);
+				return tmp >>= shift;
+			}
+
+		private:
+			uint64_t _block[nrBlocks];
+
+			// single limb blocks, including the empty bitblock<0>, always address limb 0
+			static constexpr size_t blockIndex(size_t pos) { return (nrBlocks == 1 ? 0 : pos / bitsInBlock); }
+		};
+
+		template<size_t nbits>
+		bitblock<nbits> operator&(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			bitblock<nbits> result(lhs);
+			return result &= rhs;
+		}
+		template<size_t nbits>
+		bitblock<nbits> operator|(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			bitblock<nbits> result(lhs);
+			return result |= rhs;
+		}
+		template<size_t nbits>
+		bitblock<nbits> operator^(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			bitblock<nbits> result(lhs);
+			return result ^= rhs;
+		}
+
+		// print the bits msb first, like std::bitset
+		template<size_t nbits>
+		std::ostream& operator<<(std::ostream& ostr, const bitblock<nbits>& bits) {
+			return ostr << bits.to_string();
+		}
+
+		// read at most nbits characters of '0' and '1', like std::bitset
+		template<size_t nbits>
+		std::istream& operator>>(std::istream& istr, bitblock<nbits>& bits) {
+			std::string str;
+			std::istream::sentry s(istr);
+			if (s) {
+				while (str.length() < nbits) {
+					int c = istr.peek();
+					if (c != '0' && c != '1') break;
+					str.push_back(char(istr.get()));
+				}
+			}
+			if (str.empty() && nbits > 0) {
+				istr.setstate(std::ios_base::failbit);
+				return istr;
+			}
+			bits.reset();
+			for (size_t i = 0; i < str.length(); ++i) {
+				if (str[str.length() - 1 - i] == '1') bits.set(i);
+			}
+			return istr;
+		}
+
+		// copy the bits of src into tgt such that tgt[i] = src[i + offset], zero-filling outside of src
+		template<size_t src_size, size_t tgt_size>
+		void copy_window(const bitblock<src_size>& src, long long offset, bitblock<tgt_size>& tgt) {
+			for (size_t i = 0; i < bitblock<tgt_size>::nrBlocks; ++i) {
+				tgt.setblock(i, src.block_at(offset + (long long)(i * bitblock<tgt_size>::bitsInBlock)));
+			}
+		}
+#else
 		// bitblock is a template class implementing efficient multi-precision binary arithmetic and logic
 		template<size_t nbits>
 		class bitblock : public std::bitset<nbits> {
@@ -50,6 +309,16 @@ namespace sw {
 			}
 		};
 
+		// copy the bits of src into tgt such that tgt[i] = src[i + offset], zero-filling outside of src
+		template<size_t src_size, size_t tgt_size>
+		void copy_window(const bitblock<src_size>& src, long long offset, bitblock<tgt_size>& tgt) {
+			for (size_t i = 0; i < tgt_size; ++i) {
+				long long pos = (long long)i + offset;
+				tgt.set(i, pos >= 0 && pos < (long long)src_size && src[size_t(pos)]);
+			}
+		}
+#endif
+
 		// logic operators
 
 		// this comparison is for a two's complement number only
@@ -59,16 +328,68 @@ namespace sw {
 			if (lhs[nbits - 1] == 0 && rhs[nbits - 1] == 1)	return false;
 			if (lhs[nbits - 1] == 1 && rhs[nbits - 1] == 0) return true;
 			// sign is equal, compare the remaining bits
+#if BITBLOCK_LIMB_ENGINE
+			for (size_t i = bitblock<nbits>::nrBlocks; i-- > 0; ) {
+				if (lhs.block(i) != rhs.block(i)) return lhs.block(i) < rhs.block(i);
+			}
+#else
 			if (nbits > 1) {
 				for (int i = static_cast<int>(nbits) - 2; i >= 0; --i) {
 					if (lhs[i] == 0 && rhs[i] == 1)	return true;
 					if (lhs[i] == 1 && rhs[i] == 0) return false;
 				}
 			}
+#endif
 			// numbers are equal
 			return false;
 		}
 
+#if BITBLOCK_LIMB_ENGINE
+		// three-way comparison of two unsigned numbers: -1, 0, or 1
+		template<size_t nbits>
+		int compare_unsigned(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			for (size_t i = bitblock<nbits>::nrBlocks; i-- > 0; ) {
+				if (lhs.block(i) != rhs.block(i)) return (lhs.block(i) < rhs.block(i) ? -1 : 1);
+			}
+			return 0;
+		}
+
+		// this comparison works for any number
+		template<size_t nbits>
+		bool operator==(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			return compare_unsigned(lhs, rhs) == 0;
+		}
+
+		// this comparison works for any number
+		template<size_t nbits>
+		bool operator!=(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			return compare_unsigned(lhs, rhs) != 0;
+		}
+
+		// this comparison is for unsigned numbers only
+		template<size_t nbits>
+		bool operator< (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			return compare_unsigned(lhs, rhs) < 0;
+		}
+
+		// this comparison is for unsigned numbers only
+		template<size_t nbits>
+		bool operator<= (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			return compare_unsigned(lhs, rhs) <= 0;
+		}
+
+		// this comparison is for unsigned numbers only
+		template<size_t nbits>
+		bool operator> (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			return compare_unsigned(lhs, rhs) > 0;
+		}
+
+		// this comparison is for unsigned numbers only
+		template<size_t nbits>
+		bool operator>= (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			return compare_unsigned(lhs, rhs) >= 0;
+		}
+#else
 		// this comparison works for any number
 		template<size_t nbits>
 		bool operator==(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
@@ -127,6 +448,7 @@ namespace sw {
 			// numbers are equal
 			return true;
 		}
+#endif
 
 		////////////////////////////// ARITHMETIC functions
 
@@ -137,6 +459,17 @@ namespace sw {
 		// increment the input bitset in place, and return true if there is a carry generated.
 		template<size_t nbits>
 		bool increment_bitset(bitblock<nbits>& number) {
+#if BITBLOCK_LIMB_ENGINE
+			constexpr size_t nrBlocks = bitblock<nbits>::nrBlocks;
+			constexpr size_t topBits = bitblock<nbits>::topBits;
+			uint64_t carry = 1;
+			for (size_t i = 0; i < nrBlocks && carry; ++i) {
+				uint64_t sum = addcarry(number.block(i), 0, carry);
+				if (i == nrBlocks - 1 && topBits < 64) carry = (sum >> (topBits % 64)) & 1;
+				number.setblock(i, sum);
+			}
+			return carry != 0;
+#else
 			bool carry = true;  // ripple carry
 			for (size_t i = 0; i < nbits; i++) {
 				bool _a = number[i];
@@ -144,6 +477,7 @@ namespace sw {
 				carry = carry & (_a ^ false);
 			}
 			return carry;
+#endif
 		}
 
 		// increment the input bitset in place, and return true if there is a carry generated.
@@ -154,6 +488,23 @@ namespace sw {
 		// [1 1 0 0] nrBits = 3 is the word [1 1 0], etc.
 		template<size_t nbits>
 		bool increment_unsigned(bitblock<nbits>& number, size_t nrBits = nbits - 1) {
+#if BITBLOCK_LIMB_ENGINE
+			constexpr size_t nrBlocks = bitblock<nbits>::nrBlocks;
+			constexpr size_t topBits = bitblock<nbits>::topBits;
+			if (nrBits > nbits - 1) nrBits = nbits - 1;  // check/fix argument
+			size_t lsb = nbits - nrBits;
+			if (lsb >= nbits) return true;  // there is no word to increment: the carry ripples through
+			uint64_t carry = 0;
+			uint64_t addend = uint64_t(1) << (lsb % 64);
+			for (size_t i = lsb / 64; i < nrBlocks; ++i) {
+				uint64_t sum = addcarry(number.block(i), addend, carry);
+				if (i == nrBlocks - 1 && topBits < 64) carry = (sum >> (topBits % 64)) & 1;
+				number.setblock(i, sum);
+				if (carry == 0) break;
+				addend = 0;
+			}
+			return carry != 0;
+#else
 			if (nrBits > nbits - 1) nrBits = nbits - 1;  // check/fix argument
 			bool carry = 1;  // ripple carry
 			size_t lsb = nbits - nrBits;
@@ -163,11 +514,20 @@ namespace sw {
 				carry = (_a & false) | (carry & (_a ^ false));
 			}
 			return carry;
+#endif
 		}
 
 		// decrement the input bitset in place, and return true if there is a borrow generated.
 		template<size_t nbits>
 		bool decrement_bitset(bitblock<nbits>& number) {
+#if BITBLOCK_LIMB_ENGINE
+			constexpr size_t nrBlocks = bitblock<nbits>::nrBlocks;
+			uint64_t borrow = 1;
+			for (size_t i = 0; i < nrBlocks && borrow; ++i) {
+				number.setblock(i, subborrow(number.block(i), 0, borrow));
+			}
+			return borrow != 0;
+#else
 			bool borrow = true;
 			for (size_t i = 0; i < nbits; i++) {
 				bool _a = number[i];
@@ -175,6 +535,7 @@ namespace sw {
 				borrow = (!(!_a ^ true) & borrow);
 			}
 			return borrow;
+#endif
 		}
 
 		//////////////////////////////////////////////////////////////////////////////////////
@@ -183,6 +544,18 @@ namespace sw {
 		// add bitsets a and b and return result in bitset sum. Return true if there is a carry generated.
 		template<size_t nbits>
 		bool add_unsigned(bitblock<nbits> a, bitblock<nbits> b, bitblock<nbits + 1>& sum) {
+#if BITBLOCK_LIMB_ENGINE
+			constexpr size_t nrBlocks = bitblock<nbits>::nrBlocks;
+			constexpr size_t topBits = bitblock<nbits>::topBits;
+			uint64_t carry = 0;
+			for (size_t i = 0; i < nrBlocks; ++i) {
+				uint64_t s = addcarry(a.block(i), b.block(i), carry);
+				if (i == nrBlocks - 1 && topBits < 64) carry = (s >> (topBits % 64)) & 1;
+				sum.setblock(i, s);
+			}
+			sum.set(nbits, carry != 0);
+			return carry != 0;
+#else
 			bool carry = false;  // ripple carry
 			for (size_t i = 0; i < nbits; i++) {
 				bool _a = a[i];
@@ -192,11 +565,23 @@ namespace sw {
 			}
 			sum.set(nbits, carry);
 			return carry;
+#endif
 		}
 
 		// subtract bitsets a and b and return result in bitset dif. Return true if there is a borrow generated.
 		template<size_t nbits>
 		bool subtract_unsigned(bitblock<nbits> a, bitblock<nbits> b, bitblock<nbits + 1>& dif) {
+#if BITBLOCK_LIMB_ENGINE
+			constexpr size_t nrBlocks = bitblock<nbits>::nrBlocks;
+			uint64_t borrow = 0;
+			for (size_t i = 0; i < nrBlocks; ++i) {
+				uint64_t d = subborrow(a.block(i), b.block(i), borrow);
+				if (i == nrBlocks - 1) d &= bitblock<nbits>::topMask;
+				dif.setblock(i, d);
+			}
+			dif.set(nbits, borrow != 0);
+			return borrow != 0;
+#else
 			bool borrow = false;  // ripple borrow
 			for (size_t i = 0; i < nbits; i++) {
 				bool _a = a[i];
@@ -206,6 +591,7 @@ namespace sw {
 			}
 			dif.set(nbits, borrow);
 			return borrow;
+#endif
 		}
 
 		template<size_t nbits>
@@ -251,6 +637,13 @@ namespace sw {
 
 		template<size_t nbits>
 		bitblock<nbits> extract_23b_fraction(uint32_t _23b_fraction_without_hidden_bit) {
+#if BITBLOCK_LIMB_ENGINE
+			bitblock<23> raw;
+			raw.setblock(0, _23b_fraction_without_hidden_bit);
+			bitblock<nbits> _fraction;
+			copy_window(raw, 23 - (long long)nbits, _fraction);
+			return _fraction;
+#else
 			bitblock<nbits> _fraction;
 			uint32_t mask = uint32_t(0x00400000ul);
 			unsigned int ub = (nbits < 23 ? nbits : 23);
@@ -259,10 +652,18 @@ namespace sw {
 				mask >>= 1;
 			}
 			return _fraction;
+#endif
 		}
 
 		template<size_t nbits>
 		bitblock<nbits> extract_52b_fraction(uint64_t _52b_fraction_without_hidden_bit) {
+#if BITBLOCK_LIMB_ENGINE
+			bitblock<52> raw;
+			raw.setblock(0, _52b_fraction_without_hidden_bit);
+			bitblock<nbits> _fraction;
+			copy_window(raw, 52 - (long long)nbits, _fraction);
+			return _fraction;
+#else
 			bitblock<nbits> _fraction;
 			uint64_t mask = uint64_t(0x0008000000000000ull);
 			unsigned int ub = (nbits < 52 ? nbits : 52);
@@ -271,10 +672,18 @@ namespace sw {
 				mask >>= 1;
 			}
 			return _fraction;
+#endif
 		}
 
 		template<size_t nbits>
 		bitblock<nbits> extract_63b_fraction(uint64_t _63b_fraction_without_hidden_bit) {
+#if BITBLOCK_LIMB_ENGINE
+			bitblock<63> raw;
+			raw.setblock(0, _63b_fraction_without_hidden_bit);
+			bitblock<nbits> _fraction;
+			copy_window(raw, 63 - (long long)nbits, _fraction);
+			return _fraction;
+#else
 			bitblock<nbits> _fraction;
 			uint64_t mask = uint64_t(0x4000000000000000ull);
 			unsigned int ub = (nbits < 63 ? nbits : 63);
@@ -283,6 +692,7 @@ namespace sw {
 				mask >>= 1;
 			}
 			return _fraction;
+#endif
 		}
 
 		// 128 bit unsigned int mapped to two uint64_t elements
@@ -294,6 +704,14 @@ namespace sw {
 		// take in a long double mapped to two uint64_t elements
 		template<size_t nbits>
 		bitblock<nbits> extract_long_double_fraction(uint128* _112b_fraction_without_hidden_bit) {
+#if BITBLOCK_LIMB_ENGINE
+			bitblock<112> raw;
+			raw.setblock(0, _112b_fraction_without_hidden_bit->lower);
+			raw.setblock(1, _112b_fraction_without_hidden_bit->upper);
+			bitblock<nbits> _fraction;
+			copy_window(raw, 112 - (long long)nbits, _fraction);
+			return _fraction;
+#else
 			bitblock<nbits> _fraction;
 			int msb = nbits - 1;
 			uint64_t mask = uint64_t(0x0000800000000000ull);
@@ -309,10 +727,18 @@ namespace sw {
 				mask >>= 1;
 			}
 			return _fraction;
+#endif
 		}
 
 		template<size_t nbits>
 		bitblock<nbits> copy_integer_fraction(unsigned long long _fraction_without_hidden_bit) {
+#if BITBLOCK_LIMB_ENGINE
+			bitblock<64> raw;
+			raw.setblock(0, _fraction_without_hidden_bit);
+			bitblock<nbits> _fraction;
+			copy_window(raw, 64 - (long long)nbits, _fraction);
+			return _fraction;
+#else
 			bitblock<nbits> _fraction;
 			uint64_t mask = uint64_t(0x8000000000000000ull);
 			unsigned int ub = (nbits < 64 ? nbits : 64);
@@ -321,6 +747,7 @@ namespace sw {
 				mask >>= 1;
 			}
 			return _fraction;
+#endif
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////
@@ -329,9 +756,15 @@ namespace sw {
 		// copy a bitset into a bigger bitset starting at position indicated by the shift value
 		template<size_t src_size, size_t tgt_size>
 		void copy_into(const bitblock<src_size>& src, size_t shift, bitblock<tgt_size>& tgt) {
+#if BITBLOCK_LIMB_ENGINE
+			// same range check as the bit-wise tgt.set(i + shift, src[i])
+			if (src_size > 0 && src_size - 1 + shift >= tgt_size) throw std::out_of_range("copy_into target too small");
+			copy_window(src, -(long long)shift, tgt);
+#else
 			tgt.reset();
 			for (size_t i = 0; i < src_size; i++)
 				tgt.set(i + shift, src[i]);
+#endif
 		}
 
 		// copy a slice of a bitset into a bigger bitset starting at position indicated by the shift value
@@ -346,6 +779,14 @@ namespace sw {
 
 		template<size_t from, size_t to, size_t src_size>
 		bitblock<to - from> fixed_subset(const bitblock<src_size>& src) {
+#if BITBLOCK_LIMB_ENGINE
+			static_assert(from <= to, "from cannot be larger than to");
+			static_assert(to <= src_size, "to is larger than src_size");
+
+			bitblock<to - from> result;
+			copy_window(src, (long long)from, result);
+			return result;
+#else
 			static_assert(from <= to, "from cannot be larger than to");
 			static_assert(to <= src_size, "to is larger than src_size");
 
@@ -353,6 +794,7 @@ namespace sw {
 			for (size_t i = 0, end = to - from; i < end; ++i)
 				result[i] = src[i + from];
 			return result;
+#endif
 		}
 
 		//////////////////////////////////////////////////////////////////////////////////////
@@ -361,6 +803,25 @@ namespace sw {
 		// accumulate the addend to a running accumulator
 		template<size_t src_size, size_t tgt_size>
 		bool accumulate(const bitblock<src_size>& addend, bitblock<tgt_size>& accumulator) {
+#if BITBLOCK_LIMB_ENGINE
+			constexpr size_t nrLimbs = (src_size + 63) / 64;
+			constexpr size_t topBits = src_size - (nrLimbs > 0 ? (nrLimbs - 1) * 64 : 0);
+			uint64_t carry = 0;
+			for (size_t i = 0; i < nrLimbs; ++i) {
+				uint64_t acc = accumulator.block(i);
+				if (i == nrLimbs - 1 && topBits < 64) {
+					// only the lower topBits of the accumulator limb participate
+					uint64_t mask = (uint64_t(1) << (topBits % 64)) - 1;
+					uint64_t sum = (acc & mask) + addend.block(i) + carry;
+					carry = (sum >> (topBits % 64)) & 1;
+					accumulator.setblock(i, (acc & ~mask) | (sum & mask));
+				}
+				else {
+					accumulator.setblock(i, addcarry(acc, addend.block(i), carry));
+				}
+			}
+			return carry != 0;
+#else
 			bool carry = 0;  // ripple carry
 			for (size_t i = 0; i < src_size; i++) {
 				bool _a = addend[i];
@@ -369,11 +830,25 @@ namespace sw {
 				carry = (_a & _b) | (carry & (_a ^ _b));
 			}
 			return carry;
+#endif
 		}
 
 		// multiply bitsets a and b and return result in bitset result.
 		template<size_t operand_size>
 		void multiply_unsigned(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<2 * operand_size>& result) {
+#if BITBLOCK_LIMB_ENGINE
+			// Comba product on 64-bit limbs, split with Karatsuba for wide operands
+			constexpr size_t n = bitblock<operand_size>::nrBlocks;
+			uint64_t av[n], bv[n], r[2 * n];
+			for (size_t i = 0; i < n; ++i) {
+				av[i] = a.block(i);
+				bv[i] = b.block(i);
+			}
+			limb_multiply<n>(av, bv, r);
+			for (size_t i = 0; i < bitblock<2 * operand_size>::nrBlocks; ++i) {
+				result.setblock(i, r[i]);
+			}
+#else
 			constexpr size_t result_size = 2 * operand_size;
 			bitblock<result_size> addend;
 			result.reset();
@@ -391,12 +866,31 @@ namespace sw {
 #endif
 				}
 			}
+#endif
 		}
 
 
 		// subtract a subtractand from a running accumulator
 		template<size_t src_size, size_t tgt_size>
 		bool subtract(bitblock<tgt_size>& accumulator, const bitblock<src_size>& subtractand) {
+#if BITBLOCK_LIMB_ENGINE
+			constexpr size_t nrLimbs = (src_size + 63) / 64;
+			constexpr size_t topBits = src_size - (nrLimbs > 0 ? (nrLimbs - 1) * 64 : 0);
+			uint64_t borrow = 0;
+			for (size_t i = 0; i < nrLimbs; ++i) {
+				uint64_t acc = accumulator.block(i);
+				if (i == nrLimbs - 1 && topBits < 64) {
+					// only the lower topBits of the accumulator limb participate
+					uint64_t mask = (uint64_t(1) << (topBits % 64)) - 1;
+					uint64_t dif = subborrow(acc & mask, subtractand.block(i), borrow);
+					accumulator.setblock(i, (acc & ~mask) | (dif & mask));
+				}
+				else {
+					accumulator.setblock(i, subborrow(acc, subtractand.block(i), borrow));
+				}
+			}
+			return borrow != 0;
+#else
 			bool borrow = 0;  // ripple borrow
 			for (size_t i = 0; i < src_size; i++) {
 				bool _a = accumulator[i];
@@ -405,11 +899,24 @@ namespace sw {
 				borrow = ((!_a) & _b) | (!((!_a) ^ (!_b)) & borrow);
 			}
 			return borrow;
+#endif
 		}
 
 		// divide bitsets a and b and return result in bitset result.
 		template<size_t operand_size>
 		void integer_divide_unsigned(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<2 * operand_size>& result) {
+#if BITBLOCK_LIMB_ENGINE
+			constexpr size_t n = bitblock<operand_size>::nrBlocks;
+			uint64_t u[n], v[n], q[n], r[n];
+			for (size_t i = 0; i < n; ++i) {
+				u[i] = a.block(i);
+				v[i] = b.block(i);
+			}
+			if (b.none()) throw integer_divide_by_zero{};
+			limb_divide<n, n>(u, v, q, r);
+			result.reset();
+			for (size_t i = 0; i < n; ++i) result.setblock(i, q[i]);
+#else
 			bitblock<operand_size> subtractand, accumulator;
 			result.reset();
 			accumulator = a;
@@ -438,6 +945,7 @@ namespace sw {
 					subtractand >>= 1;
 				}
 			}
+#endif
 		}
 
 		// divide bitsets a and b and return result in bitset result. 
@@ -445,6 +953,19 @@ namespace sw {
 		// Radix point must be maintained by calling function.
 		template<size_t operand_size, size_t result_size>
 		void divide_with_fraction(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<result_size>& result) {
+#if BITBLOCK_LIMB_ENGINE
+			// quotient floor((a << (result_size - operand_size)) / b) of the widened dividend
+			constexpr size_t m = bitblock<result_size>::nrBlocks;
+			constexpr size_t n = bitblock<operand_size>::nrBlocks;
+			if (b.none()) throw integer_divide_by_zero{};
+			bitblock<result_size> accumulator;
+			copy_into<operand_size, result_size>(a, result_size - operand_size, accumulator);
+			uint64_t u[m], v[n], q[m], r[n];
+			for (size_t i = 0; i < m; ++i) u[i] = accumulator.block(i);
+			for (size_t i = 0; i < n; ++i) v[i] = b.block(i);
+			limb_divide<m, n>(u, v, q, r);
+			for (size_t i = 0; i < m; ++i) result.setblock(i, q[i]);
+#else
 			bitblock<result_size> subtractand, accumulator;
 			result.reset();
 			copy_into<operand_size, result_size>(a, result_size - operand_size, accumulator);
@@ -476,6 +997,7 @@ namespace sw {
 					subtractand >>= 1;
 				}
 			}
+#endif
 		}
 
 		//////////////////////////////////////////////////////////////////////////////////////
@@ -484,9 +1006,13 @@ namespace sw {
 		// truncate right-side
 		template<size_t src_size, size_t tgt_size>
 		void truncate(bitblock<src_size>& src, bitblock<tgt_size>& tgt) {
+#if BITBLOCK_LIMB_ENGINE
+			copy_window(src, (long long)src_size - (long long)tgt_size, tgt);
+#else
 			tgt.reset();
 			for (size_t i = 0; i < tgt_size; i++)
 				tgt.set(tgt_size - 1 - i, src[src_size - 1 - i]);
+#endif
 		}
 
 		// round
@@ -555,6 +1081,13 @@ namespace sw {
 		// find the MSB, return position if found, return -1 if no bits are set
 		template<size_t nbits>
 		int findMostSignificantBit(const bitblock<nbits>& bits) {
+#if BITBLOCK_LIMB_ENGINE
+			for (size_t i = bitblock<nbits>::nrBlocks; i-- > 0; ) {
+				uint64_t limb = bits.block(i);
+				if (limb) return int(i * 64 + 63) - nlz(limb);
+			}
+			return -1; // indicative of no bits set
+#else
 			int msb = -1; // indicative of no bits set
 			for (int i = nbits - 1; i >= 0; i--) {
 				if (bits.test(i)) {
@@ -563,21 +1096,31 @@ namespace sw {
 				}
 			}
 			return msb;
+#endif
 		}
 
 		// calculate the 1's complement of a sign-magnitude encoded number
 		template<size_t nbits>
 		bitblock<nbits> ones_complement(bitblock<nbits> number) {
+#if BITBLOCK_LIMB_ENGINE
+			return number.flip();
+#else
 			bitblock<nbits> complement;
 			for (size_t i = 0; i < nbits; i++) {
 				complement.set(i, !number[i]);
 			}
 			return complement;
+#endif
 		}
 
 		// calculate the 2's complement of a 2's complement encoded number
 		template<size_t nbits>
 		bitblock<nbits> twos_complement(bitblock<nbits> number) {
+#if BITBLOCK_LIMB_ENGINE
+			number.flip();
+			increment_bitset(number);
+			return number;
+#else
 			bitblock<nbits> complement;
 			uint8_t _slice = 0;
 			uint8_t carry = 1;
@@ -587,12 +1130,18 @@ namespace sw {
 				complement[i] = (0x1 & _slice);
 			}
 			return complement;
+#endif
 		}
 
 		// DANGER: this depends on the implicit type conversion of number to a uint64_t to sign extent a 2's complement number system
 		// if nbits > 64 then this code breaks.
 		template<size_t nbits, class Type>
 		bitblock<nbits> convert_to_bitblock(Type number) {
+#if BITBLOCK_LIMB_ENGINE
+			bitblock<nbits> _Bits;
+			_Bits.setblock(0, uint64_t(number));
+			return _Bits;
+#else
 			bitblock<nbits> _Bits;
 			uint64_t mask = uint64_t(1);
 			for (std::size_t i = 0; i < nbits; i++) {
@@ -600,6 +1149,7 @@ namespace sw {
 				mask <<= 1;
 			}
 			return _Bits;
+#endif
 		}
 
 		template<size_t nbits>
@@ -665,12 +1215,24 @@ namespace sw {
 		// sticky bit representation of all the bits from [msb, lsb], that is, msb is included
 		template<size_t nbits>
 		bool anyAfter(const bitblock<nbits>& bits, int msb) {
+#if BITBLOCK_LIMB_ENGINE
+			if (msb < 0) return false;	// bad input
+			if (size_t(msb) >= nbits) throw std::out_of_range("anyAfter argument out of range");
+			size_t top = size_t(msb) / 64;
+			for (size_t i = 0; i < top; ++i) {
+				if (bits.block(i)) return true;
+			}
+			size_t width = size_t(msb) % 64 + 1;
+			uint64_t mask = (width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1);
+			return (bits.block(top) & mask) != 0;
+#else
 			if (msb < 0) return false;	// bad input
 			bool running = false;
 			for (int i = msb; i >= 0; i--) {
 				running |= bits.test(i);
 			}
 			return running;
+#endif
 		}
 
 	} // namespace unum
@@ -0,0 +1,215 @@
+#pragma once
+//  limb_division.hpp : division of multi-limb integers with a precomputed reciprocal of the divisor
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include "limb_functions.hpp"
+
+// The quotient digits come from multiplications with the reciprocal of the normalized divisor instead of
+// hardware or bit-serial division: the reciprocal is seeded from a 256-entry table, refined with Newton-Raphson
+// iterations on 64-bit integers, and each quotient digit is fixed up with at most two correction steps.
+// See N. Moller and T. Granlund, "Improved division by invariant integers", IEEE Trans. Computers, 2011.
+
+namespace sw {
+	namespace unum {
+
+		// 11-bit seed of the reciprocal: floor((2^19 - 3*2^8) / d9) for the top nine bits 256 <= d9 < 512 of the divisor
+		inline uint64_t reciprocal_seed(uint64_t d9) {
+			static const uint16_t table[256] = {
+				2045, 2037, 2029, 2021, 2013, 2005, 1998, 1990, 1983, 1975, 1968, 1960, 1953, 1946, 1938, 1931,
+				1924, 1917, 1910, 1903, 1896, 1889, 1883, 1876, 1869, 1863, 1856, 1849, 1843, 1836, 1830, 1824,
+				1817, 1811, 1805, 1799, 1792, 1786, 1780, 1774, 1768, 1762, 1756, 1750, 1745, 1739, 1733, 1727,
+				1722, 1716, 1710, 1705, 1699, 1694, 1688, 1683, 1677, 1672, 1667, 1661, 1656, 1651, 1646, 1641,
+				1636, 1630, 1625, 1620, 1615, 1610, 1605, 1600, 1596, 1591, 1586, 1581, 1576, 1572, 1567, 1562,
+				1558, 1553, 1548, 1544, 1539, 1535, 1530, 1526, 1521, 1517, 1513, 1508, 1504, 1500, 1495, 1491,
+				1487, 1483, 1478, 1474, 1470, 1466, 1462, 1458, 1454, 1450, 1446, 1442, 1438, 1434, 1430, 1426,
+				1422, 1418, 1414, 1411, 1407, 1403, 1399, 1396, 1392, 1388, 1384, 1381, 1377, 1374, 1370, 1366,
+				1363, 1359, 1356, 1352, 1349, 1345, 1342, 1338, 1335, 1332, 1328, 1325, 1322, 1318, 1315, 1312,
+				1308, 1305, 1302, 1299, 1295, 1292, 1289, 1286, 1283, 1280, 1276, 1273, 1270, 1267, 1264, 1261,
+				1258, 1255, 1252, 1249, 1246, 1243, 1240, 1237, 1234, 1231, 1228, 1226, 1223, 1220, 1217, 1214,
+				1211, 1209, 1206, 1203, 1200, 1197, 1195, 1192, 1189, 1187, 1184, 1181, 1179, 1176, 1173, 1171,
+				1168, 1165, 1163, 1160, 1158, 1155, 1153, 1150, 1148, 1145, 1143, 1140, 1138, 1135, 1133, 1130,
+				1128, 1125, 1123, 1121, 1118, 1116, 1113, 1111, 1109, 1106, 1104, 1102, 1099, 1097, 1095, 1092,
+				1090, 1088, 1086, 1083, 1081, 1079, 1077, 1074, 1072, 1070, 1068, 1066, 1064, 1061, 1059, 1057,
+				1055, 1053, 1051, 1049, 1047, 1044, 1042, 1040, 1038, 1036, 1034, 1032, 1030, 1028, 1026, 1024
+			};
+			return table[d9 - 256];
+		}
+
+		// reciprocal of a normalized limb d >= 2^63: floor((2^128 - 1) / d) - 2^64
+		inline uint64_t reciprocal_word(uint64_t d) {
+			uint64_t d0 = d & 1;
+			uint64_t d40 = (d >> 24) + 1;
+			uint64_t d63 = (d >> 1) + d0;   // ceil(d / 2)
+			uint64_t v0 = reciprocal_seed(d >> 55);
+			// Newton-Raphson iterations v <- v + v * (1 - d * v) at 22, 35, and 64 bits of accuracy
+			uint64_t v1 = (v0 << 11) - ((v0 * v0 * d40) >> 40) - 1;
+			uint64_t v2 = (v1 << 13) + ((v1 * ((uint64_t(1) << 60) - v1 * d40)) >> 47);
+			uint64_t e = ((v2 >> 1) & (0 - d0)) - v2 * d63;
+			uint64_t hi;
+			mul128(v2, e, hi);
+			uint64_t v3 = (v2 << 31) + (hi >> 1);
+			// final correction: v3 can be one too small
+			uint64_t lo = mul128(v3, d, hi);
+			uint64_t carry = 0;
+			addcarry(lo, d, carry);
+			return v3 - (hi + carry) - d;
+		}
+
+		// reciprocal of a normalized two-limb divisor (d1,d0) with d1 >= 2^63: floor((2^192 - 1) / (d1,d0)) - 2^64
+		inline uint64_t reciprocal_3by2(uint64_t d1, uint64_t d0) {
+			uint64_t v = reciprocal_word(d1);
+			uint64_t p = d1 * v;
+			p += d0;
+			if (p < d0) {
+				--v;
+				if (p >= d1) {
+					--v;
+					p -= d1;
+				}
+				p -= d1;
+			}
+			uint64_t t1;
+			uint64_t t0 = mul128(v, d0, t1);
+			p += t1;
+			if (p < t1) {
+				--v;
+				if (p > d1 || (p == d1 && t0 >= d0)) --v;
+			}
+			return v;
+		}
+
+		// (u1,u0) / d for a normalized d with its reciprocal v, requires u1 < d: return the quotient, and the remainder in rem
+		inline uint64_t divide_2by1(uint64_t u1, uint64_t u0, uint64_t d, uint64_t v, uint64_t& rem) {
+			uint64_t q1;
+			uint64_t q0 = mul128(v, u1, q1);
+			uint64_t carry = 0;
+			q0 = addcarry(q0, u0, carry);
+			q1 = q1 + u1 + 1 + carry;
+			uint64_t r = u0 - q1 * d;
+			if (r > q0) {
+				--q1;
+				r += d;
+			}
+			if (r >= d) {
+				++q1;
+				r -= d;
+			}
+			rem = r;
+			return q1;
+		}
+
+		// (u2,u1,u0) / (d1,d0) for a normalized divisor with its reciprocal v, requires (u2,u1) < (d1,d0):
+		// return the quotient, and the remainder in (r1,r0)
+		inline uint64_t divide_3by2(uint64_t u2, uint64_t u1, uint64_t u0, uint64_t d1, uint64_t d0, uint64_t v, uint64_t& r1, uint64_t& r0) {
+			uint64_t q1;
+			uint64_t q0 = mul128(v, u2, q1);
+			uint64_t carry = 0;
+			q0 = addcarry(q0, u1, carry);
+			q1 = q1 + u2 + carry;
+			r1 = u1 - q1 * d1;
+			uint64_t t1;
+			uint64_t t0 = mul128(d0, q1, t1);
+			uint64_t borrow = 0;
+			r0 = subborrow(u0, t0, borrow);
+			r1 = subborrow(r1, t1, borrow);
+			borrow = 0;
+			r0 = subborrow(r0, d0, borrow);
+			r1 = subborrow(r1, d1, borrow);
+			++q1;
+			if (r1 >= q0) {
+				--q1;
+				carry = 0;
+				r0 = addcarry(r0, d0, carry);
+				r1 = addcarry(r1, d1, carry);
+			}
+			if (r1 > d1 || (r1 == d1 && r0 >= d0)) {
+				++q1;
+				borrow = 0;
+				r0 = subborrow(r0, d0, borrow);
+				r1 = subborrow(r1, d1, borrow);
+			}
+			return q1;
+		}
+
+		// Knuth's Algorithm D on 64-bit digits with quotient digits from divide_3by2:
+		// q[0, M) = u[0, M) / v[0, N) and r[0, N) = u mod v, where v may carry leading zero limbs but must be nonzero
+		template<size_t M, size_t N>
+		inline void limb_divide(const uint64_t* u, const uint64_t* v, uint64_t* q, uint64_t* r) {
+			size_t n = N;
+			while (n > 0 && v[n - 1] == 0) --n;
+			for (size_t i = 0; i < M; ++i) q[i] = 0;
+			for (size_t i = 0; i < N; ++i) r[i] = 0;
+			if (n > M) {
+				for (size_t i = 0; i < M; ++i) r[i] = u[i];
+				return;
+			}
+			// normalize the divisor so that its top limb carries the most significant bit, and shift the dividend alike
+			int s = nlz(v[n - 1]);
+			uint64_t vn[N] = { 0 }, un[M + 1];
+			for (size_t i = n; i-- > 0; ) vn[i] = (s ? (v[i] << s) | (i > 0 ? v[i - 1] >> (64 - s) : 0) : v[i]);
+			un[M] = (s ? u[M - 1] >> (64 - s) : 0);
+			for (size_t i = M; i-- > 0; ) un[i] = (s ? (u[i] << s) | (i > 0 ? u[i - 1] >> (64 - s) : 0) : u[i]);
+
+			if (N == 1 || n == 1) {
+				uint64_t d = vn[0], inv = reciprocal_word(d), rem = un[M];
+				for (size_t j = M; j-- > 0; ) q[j] = divide_2by1(rem, un[j], d, inv, rem);
+				r[0] = rem >> s;
+				return;
+			}
+
+			uint64_t d1 = vn[n - 1], d0 = vn[n - 2], inv = reciprocal_3by2(d1, d0);
+			for (size_t j = M - n + 1; j-- > 0; ) {
+				uint64_t qhat, carry = 0, borrow = 0;
+				if (un[j + n] == d1 && un[j + n - 1] == d0) {
+					// the top limbs equal the divisor's: the digit saturates, and the full multiply and subtract corrects it
+					qhat = ~uint64_t(0);
+					for (size_t i = 0; i < n; ++i) {
+						uint64_t hi, c = 0;
+						uint64_t lo = addcarry(mul128(qhat, vn[i], hi), carry, c);
+						carry = hi + c;
+						un[i + j] = subborrow(un[i + j], lo, borrow);
+					}
+					un[j + n] = subborrow(un[j + n], carry, borrow);
+					while (borrow) {
+						--qhat;
+						uint64_t c = 0;
+						for (size_t i = 0; i < n; ++i) un[i + j] = addcarry(un[i + j], vn[i], c);
+						un[j + n] = addcarry(un[j + n], 0, c);
+						borrow = !c;
+					}
+				}
+				else {
+					// the digit of the top three limbs leaves the remainder (r1,r0), so only the lower n - 2 limbs
+					// of the divisor remain to be multiplied and subtracted; the digit is at most one too large
+					uint64_t r1, r0;
+					qhat = divide_3by2(un[j + n], un[j + n - 1], un[j + n - 2], d1, d0, inv, r1, r0);
+					for (size_t i = 0; i + 2 < n; ++i) {
+						uint64_t hi, c = 0;
+						uint64_t lo = addcarry(mul128(qhat, vn[i], hi), carry, c);
+						carry = hi + c;
+						un[i + j] = subborrow(un[i + j], lo, borrow);
+					}
+					r0 = subborrow(r0, carry, borrow);
+					r1 = subborrow(r1, 0, borrow);
+					if (borrow) {
+						--qhat;
+						uint64_t c = 0;
+						for (size_t i = 0; i + 2 < n; ++i) un[i + j] = addcarry(un[i + j], vn[i], c);
+						r0 = addcarry(r0, d0, c);
+						r1 = addcarry(r1, d1, c);
+					}
+					un[j + n - 2] = r0;
+					un[j + n - 1] = r1;
+					un[j + n] = 0;
+				}
+				q[j] = qhat;
+			}
+			for (size_t i = 0; i < n; ++i) r[i] = (s ? (un[i] >> s) | (un[i + 1] << (64 - s)) : un[i]);
+		}
+
+	} // namespace unum
+
+} // namespace sw
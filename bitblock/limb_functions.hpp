@@ -0,0 +1,401 @@
+#pragma once
+//  limb_functions.hpp : word-level primitives used by the limb-based bitblock engine
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+// operand width in 64-bit limbs from which limb_multiply splits the product with Karatsuba;
+// below the threshold the column-wise Comba product is faster, see perf/limb_multiply.cpp for the crossover
+#if !defined(BITBLOCK_KARATSUBA_THRESHOLD)
+#define BITBLOCK_KARATSUBA_THRESHOLD 12
+#endif
+
+namespace sw {
+	namespace unum {
+
+#if defined(__SIZEOF_INT128__)
+		// native 128-bit integers of gcc/clang; __extension__ silences -Wpedantic
+		__extension__ typedef unsigned __int128 uint128_native;
+		__extension__ typedef __int128 int128_native;
+#endif
+
+		// add with carry: return a + b + carry, and set carry to the carry out of the 64-bit limb
+		inline uint64_t addcarry(uint64_t a, uint64_t b, uint64_t& carry) {
+#if defined(_M_X64) || defined(__x86_64__)
+			unsigned long long sum;
+			carry = _addcarry_u64((unsigned char)carry, a, b, &sum);
+			return uint64_t(sum);
+#else
+			uint64_t s = a + b;
+			uint64_t c = (s < a);
+			uint64_t r = s + carry;
+			carry = c | (r < s);
+			return r;
+#endif
+		}
+
+		// subtract with borrow: return a - b - borrow, and set borrow to the borrow out of the 64-bit limb
+		inline uint64_t subborrow(uint64_t a, uint64_t b, uint64_t& borrow) {
+#if defined(_M_X64) || defined(__x86_64__)
+			unsigned long long dif;
+			borrow = _subborrow_u64((unsigned char)borrow, a, b, &dif);
+			return uint64_t(dif);
+#else
+			uint64_t d = a - b;
+			uint64_t c = (a < b);
+			uint64_t r = d - borrow;
+			borrow = c | (d < borrow);
+			return r;
+#endif
+		}
+
+		// full 64x64 -> 128 bit product: return the lower limb, and the upper limb in hi
+		inline uint64_t mul128(uint64_t a, uint64_t b, uint64_t& hi) {
+#if defined(__SIZEOF_INT128__)
+			uint128_native p = uint128_native(a) * b;
+			hi = uint64_t(p >> 64);
+			return uint64_t(p);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long long h;
+			unsigned long long lo = _umul128(a, b, &h);
+			hi = h;
+			return lo;
+#else
+			uint64_t a_lo = a & 0xFFFFFFFFull, a_hi = a >> 32;
+			uint64_t b_lo = b & 0xFFFFFFFFull, b_hi = b >> 32;
+			uint64_t p0 = a_lo * b_lo;
+			uint64_t p1 = a_lo * b_hi;
+			uint64_t p2 = a_hi * b_lo;
+			uint64_t p3 = a_hi * b_hi;
+			uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFFull) + (p2 & 0xFFFFFFFFull);
+			hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+			return (mid << 32) | (p0 & 0xFFFFFFFFull);
+#endif
+		}
+
+		// r[0, nx) = |x[0, nx) - y[0, ny)| for nx >= ny, returning true when x < y
+		template<size_t nx, size_t ny>
+		inline bool absolute_difference(const uint64_t* x, const uint64_t* y, uint64_t* r) {
+			uint64_t borrow = 0;
+			for (size_t i = 0; i < nx; ++i) r[i] = subborrow(x[i], (i < ny ? y[i] : 0), borrow);
+			if (borrow == 0) return false;
+			// negate the two's complement difference
+			uint64_t carry = 1;
+			for (size_t i = 0; i < nx; ++i) r[i] = addcarry(~r[i], 0, carry);
+			return true;
+		}
+
+		// three-limb column accumulator of the Comba product: (c2,c1,c0) += a * b
+		inline void multiply_accumulate(uint64_t a, uint64_t b, uint64_t& c0, uint64_t& c1, uint64_t& c2) {
+#if defined(__SIZEOF_INT128__)
+			uint128_native p = uint128_native(a) * b;
+			uint128_native acc = ((uint128_native(c1) << 64) | c0) + p;
+			c2 += (acc < p);
+			c0 = uint64_t(acc);
+			c1 = uint64_t(acc >> 64);
+#else
+			uint64_t hi, carry = 0;
+			uint64_t lo = mul128(a, b, hi);
+			c0 = addcarry(c0, lo, carry);
+			c1 = addcarry(c1, hi, carry);
+			c2 += carry;
+#endif
+		}
+
+		// compile-time unrolled Comba columns for narrow operands: the partial products a[i] * b[k - i]
+		// of column k, followed by the columns above it
+		template<size_t n, size_t k, size_t i, bool inside = (i <= k && k - i < n), bool done = (i >= n)>
+		struct comba_column {
+			static void accumulate(const uint64_t* a, const uint64_t* b, uint64_t& c0, uint64_t& c1, uint64_t& c2) {
+				multiply_accumulate(a[i], b[k - i], c0, c1, c2);
+				comba_column<n, k, i + 1>::accumulate(a, b, c0, c1, c2);
+			}
+		};
+		template<size_t n, size_t k, size_t i>
+		struct comba_column<n, k, i, false, false> {
+			static void accumulate(const uint64_t* a, const uint64_t* b, uint64_t& c0, uint64_t& c1, uint64_t& c2) {
+				comba_column<n, k, i + 1>::accumulate(a, b, c0, c1, c2);
+			}
+		};
+		template<size_t n, size_t k, size_t i, bool inside>
+		struct comba_column<n, k, i, inside, true> {
+			static void accumulate(const uint64_t*, const uint64_t*, uint64_t&, uint64_t&, uint64_t&) {}
+		};
+		template<size_t n, size_t k, bool last = (k == 2 * n - 1)>
+		struct comba_columns {
+			static void multiply(const uint64_t* a, const uint64_t* b, uint64_t* r, uint64_t c0, uint64_t c1) {
+				uint64_t c2 = 0;
+				comba_column<n, k, 0>::accumulate(a, b, c0, c1, c2);
+				r[k] = c0;
+				comba_columns<n, k + 1>::multiply(a, b, r, c1, c2);
+			}
+		};
+		template<size_t n, size_t k>
+		struct comba_columns<n, k, true> {
+			static void multiply(const uint64_t*, const uint64_t*, uint64_t* r, uint64_t c0, uint64_t) {
+				r[k] = c0;
+			}
+		};
+
+		// product-scanning (Comba) multiplication: r[0, 2n) = a[0, n) * b[0, n)
+		// each column of partial products is summed in a three-limb accumulator and retired once;
+		// operands up to 8 limbs are fully unrolled at compile time
+		template<size_t n>
+		inline void comba_multiply(const uint64_t* a, const uint64_t* b, uint64_t* r) {
+			if (n <= 8) {
+				comba_columns<n, 0>::multiply(a, b, r, 0, 0);
+				return;
+			}
+			uint64_t c0 = 0, c1 = 0, c2 = 0;
+			for (size_t k = 0; k < 2 * n - 1; ++k) {
+				size_t first = (k < n ? 0 : k - n + 1);
+				size_t last = (k < n ? k : n - 1);
+				for (size_t i = first; i <= last; ++i) multiply_accumulate(a[i], b[k - i], c0, c1, c2);
+				r[k] = c0;
+				c0 = c1;
+				c1 = c2;
+				c2 = 0;
+			}
+			r[2 * n - 1] = c0;
+		}
+
+		template<size_t n>
+		inline void limb_multiply(const uint64_t* a, const uint64_t* b, uint64_t* r);
+
+		// one level of Karatsuba: r[0, 2n) = a[0, n) * b[0, n) from three half-size products.
+		// The subtractive form a1*b0 + a0*b1 = a0*b0 + a1*b1 + (a1 - a0)*(b0 - b1) keeps the
+		// middle operands at h limbs; the halves recurse through limb_multiply.
+		template<size_t n>
+		inline void karatsuba_multiply(const uint64_t* a, const uint64_t* b, uint64_t* r) {
+			constexpr size_t m = n / 2;   // limbs in the lower halves
+			constexpr size_t h = n - m;   // limbs in the upper halves, h >= m
+			limb_multiply<m>(a, b, r);                   // z0 in r[0, 2m)
+			limb_multiply<h>(a + m, b + m, r + 2 * m);   // z2 in r[2m, 2n)
+
+			// |a1 - a0| and |b1 - b0| with the lower halves zero extended to h limbs
+			uint64_t da[h], db[h];
+			bool negA = absolute_difference<h, m>(a + m, a, da);
+			bool negB = absolute_difference<h, m>(b + m, b, db);
+			uint64_t t[2 * h];
+			limb_multiply<h>(da, db, t);
+
+			// middle term z0 + z2 - (a1 - a0)*(b1 - b0), which is nonnegative and fits in 2h + 1 limbs
+			uint64_t mid[2 * h + 1];
+			uint64_t carry = 0;
+			for (size_t i = 0; i < 2 * h; ++i) mid[i] = addcarry((i < 2 * m ? r[i] : 0), r[2 * m + i], carry);
+			mid[2 * h] = carry;
+			carry = 0;
+			if (negA == negB) {
+				for (size_t i = 0; i < 2 * h; ++i) mid[i] = subborrow(mid[i], t[i], carry);
+				mid[2 * h] -= carry;
+			}
+			else {
+				for (size_t i = 0; i < 2 * h; ++i) mid[i] = addcarry(mid[i], t[i], carry);
+				mid[2 * h] += carry;
+			}
+
+			// r += mid * 2^(64m)
+			carry = 0;
+			for (size_t i = 0; i < 2 * h + 1; ++i) r[m + i] = addcarry(r[m + i], mid[i], carry);
+			for (size_t i = m + 2 * h + 1; i < 2 * n && carry; ++i) r[i] = addcarry(r[i], 0, carry);
+		}
+
+		// select Comba or Karatsuba by operand width
+		template<size_t n, bool split = (n >= BITBLOCK_KARATSUBA_THRESHOLD && n >= 2)>
+		struct limb_multiplier {
+			static void multiply(const uint64_t* a, const uint64_t* b, uint64_t* r) { comba_multiply<n>(a, b, r); }
+		};
+		template<size_t n>
+		struct limb_multiplier<n, true> {
+			static void multiply(const uint64_t* a, const uint64_t* b, uint64_t* r) { karatsuba_multiply<n>(a, b, r); }
+		};
+
+		// full product of two n-limb unsigned numbers: r[0, 2n) = a[0, n) * b[0, n)
+		template<size_t n>
+		inline void limb_multiply(const uint64_t* a, const uint64_t* b, uint64_t* r) {
+			limb_multiplier<n>::multiply(a, b, r);
+		}
+
+		// 128 by 64 bit division: return (hi,lo) / d, and the remainder in rem
+		// requires hi < d so that the quotient fits in a single limb
+		inline uint64_t div128(uint64_t hi, uint64_t lo, uint64_t d, uint64_t& rem) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+			uint64_t q, r;
+			__asm__("divq %4" : "=a"(q), "=d"(r) : "a"(lo), "d"(hi), "rm"(d));
+			rem = r;
+			return q;
+#elif defined(__SIZEOF_INT128__)
+			uint128_native n = (uint128_native(hi) << 64) | lo;
+			uint64_t q = uint64_t(n / d);
+			rem = lo - q * d;
+			return q;
+#else
+			// restoring shift-subtract division, one quotient bit per step
+			uint64_t q = 0;
+			for (int i = 0; i < 64; ++i) {
+				uint64_t top = hi >> 63;
+				hi = (hi << 1) | (lo >> 63);
+				lo <<= 1;
+				q <<= 1;
+				if (top || hi >= d) {
+					hi -= d;
+					q |= 1;
+				}
+			}
+			rem = hi;
+			return q;
+#endif
+		}
+
+		// floor(sqrt(hi,lo)) for radicands in [2^126, 2^128), with inexact set when the remainder is nonzero
+		inline uint64_t sqrt128(uint64_t hi, uint64_t lo, bool& inexact) {
+			// a floating-point estimate rounded up, so that Newton's iteration descends onto the floor
+			double estimate = std::sqrt(std::ldexp(double(hi), 64) + double(lo));
+			uint64_t r = ~uint64_t(0);
+			if (estimate < 18446744073709551616.0) {
+				r = uint64_t(estimate);
+				r = (r > ~uint64_t(0) - (uint64_t(1) << 14) ? ~uint64_t(0) : r + (uint64_t(1) << 14));
+			}
+			for (;;) {
+				uint64_t rem;
+				uint64_t q = div128(hi, lo, r, rem);
+				uint64_t next = (r >> 1) + (q >> 1) + (r & q & 1);
+				if (next >= r) break;
+				r = next;
+			}
+			uint64_t sqhi;
+			uint64_t sqlo = mul128(r, r, sqhi);
+			inexact = (sqhi != hi || sqlo != lo);
+			return r;
+		}
+
+		// number of leading zeros of a 64-bit limb, 64 when the limb is 0
+		inline int nlz(uint64_t x) {
+			if (x == 0) return 64;
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanReverse64(&index, x);
+			return 63 - int(index);
+#else
+			int n = 0;
+			if (x <= 0x00000000FFFFFFFFull) { n += 32; x <<= 32; }
+			if (x <= 0x0000FFFFFFFFFFFFull) { n += 16; x <<= 16; }
+			if (x <= 0x00FFFFFFFFFFFFFFull) { n += 8; x <<= 8; }
+			if (x <= 0x0FFFFFFFFFFFFFFFull) { n += 4; x <<= 4; }
+			if (x <= 0x3FFFFFFFFFFFFFFFull) { n += 2; x <<= 2; }
+			if (x <= 0x7FFFFFFFFFFFFFFFull) { n += 1; }
+			return n;
+#endif
+		}
+
+		// number of trailing zeros of a 64-bit limb, 64 when the limb is 0
+		inline int ntz(uint64_t x) {
+			if (x == 0) return 64;
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanForward64(&index, x);
+			return int(index);
+#else
+			int n = 0;
+			while ((x & 1) == 0) { ++n; x >>= 1; }
+			return n;
+#endif
+		}
+
+		// number of set bits in a 64-bit limb
+		inline int popcount(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_popcountll(x);
+#else
+			x = x - ((x >> 1) & 0x5555555555555555ull);
+			x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+			x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+			return int((x * 0x0101010101010101ull) >> 56);
+#endif
+		}
+
+		// multi-limb helpers on n little-endian limbs, shared by the limb bitblock and the limb posit engine
+
+		template<size_t n>
+		inline bool limb_is_zero(const uint64_t* x) {
+			for (size_t i = 0; i < n; ++i) if (x[i]) return false;
+			return true;
+		}
+
+		// number of leading zeros of x, 64 * n when x is 0
+		template<size_t n>
+		inline int limb_leading_zeros(const uint64_t* x) {
+			for (size_t i = n; i-- > 0; ) {
+				if (x[i]) return int(64 * (n - 1 - i)) + nlz(x[i]);
+			}
+			return int(64 * n);
+		}
+
+		// number of leading ones of x, 64 * n when all bits are set
+		template<size_t n>
+		inline int limb_leading_ones(const uint64_t* x) {
+			for (size_t i = n; i-- > 0; ) {
+				if (~x[i]) return int(64 * (n - 1 - i)) + nlz(~x[i]);
+			}
+			return int(64 * n);
+		}
+
+		// three-way comparison of two unsigned numbers: -1, 0, or 1
+		template<size_t n>
+		inline int limb_compare(const uint64_t* a, const uint64_t* b) {
+			for (size_t i = n; i-- > 0; ) {
+				if (a[i] != b[i]) return (a[i] < b[i] ? -1 : 1);
+			}
+			return 0;
+		}
+
+		// logical left shift, dropping the bits shifted out of the top limb
+		template<size_t n>
+		inline void limb_shift_left(uint64_t* x, size_t shift) {
+			size_t limbShift = shift / 64;
+			unsigned bitShift = unsigned(shift % 64);
+			for (size_t i = n; i-- > 0; ) {
+				uint64_t v = 0;
+				if (i >= limbShift) {
+					v = x[i - limbShift] << bitShift;
+					if (bitShift != 0 && i > limbShift) v |= x[i - limbShift - 1] >> (64 - bitShift);
+				}
+				x[i] = v;
+			}
+		}
+
+		// logical right shift, returning true when nonzero bits are shifted out
+		template<size_t n>
+		inline bool limb_shift_right(uint64_t* x, size_t shift) {
+			size_t limbShift = shift / 64;
+			unsigned bitShift = unsigned(shift % 64);
+			bool sticky = false;
+			for (size_t i = 0; i < limbShift && i < n; ++i) sticky |= (x[i] != 0);
+			if (bitShift != 0 && limbShift < n) sticky |= (x[limbShift] << (64 - bitShift)) != 0;
+			for (size_t i = 0; i < n; ++i) {
+				uint64_t v = 0;
+				if (i + limbShift < n) {
+					v = x[i + limbShift] >> bitShift;
+					if (bitShift != 0 && i + limbShift + 1 < n) v |= x[i + limbShift + 1] << (64 - bitShift);
+				}
+				x[i] = v;
+			}
+			return sticky;
+		}
+
+	} // namespace unum
+
+} // namespace sw
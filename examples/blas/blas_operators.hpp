@@ -44,25 +44,17 @@ Ty dot(size_t n, const std::vector<Ty>& x, size_t incx, const std::vector<Ty>& y
 	}
 	return sum_of_products;
 }
-// fused dot product operators
+// fused dot product operators: the posit library provides the strided fused dot product over raw arrays
 // Fused dot product with quire continuation
-template<typename Qy, typename Ty>
-void fused_dot(Qy& sum_of_products, size_t n, const std::vector<Ty>& x, size_t incx, const std::vector<Ty>& y, size_t incy) {
-	size_t ix, iy;
-	for (ix = 0, iy = 0; ix < n && iy < n; ix = ix + incx, iy = iy + incy) {
-		sum_of_products += sw::unum::quire_mul(x[ix], y[iy]);
-	}
+template<size_t nbits, size_t es, size_t capacity>
+void fused_dot(sw::unum::quire<nbits, es, capacity>& sum_of_products, size_t n, const std::vector< sw::unum::posit<nbits, es> >& x, size_t incx, const std::vector< sw::unum::posit<nbits, es> >& y, size_t incy) {
+	sw::unum::fdp_accumulate(sum_of_products, n, x.data(), incx, y.data(), incy);
 }
 // Standalone fused dot product
 template<size_t nbits, size_t es, size_t capacity = 10>
 sw::unum::posit<nbits, es> fused_dot(size_t n, const std::vector< sw::unum::posit<nbits, es> >& x, size_t incx, const std::vector< sw::unum::posit<nbits, es> >& y, size_t incy) {
 	sw::unum::quire<nbits, es, capacity> sum_of_products;   // initialized to 0 by constructor
-	size_t ix, iy;
-	for (ix = 0, iy = 0; ix < n && iy < n; ix = ix + incx, iy = iy + incy) {
-		sw::unum::value<2*(nbits - 2 - es)> unrounded_product = sw::unum::quire_mul(x[ix], y[iy]);
-		sum_of_products += unrounded_product;
-		if (sw::unum::_trace_quire_add) std::cout << sum_of_products << '\n';
-	}
+	sw::unum::fdp_accumulate(sum_of_products, n, x.data(), incx, y.data(), incy);
 	sw::unum::posit<nbits, es> sum;
 	convert(sum_of_products.to_value(), sum);     // one and only rounding step of the fused-dot product
 	return sum;
@@ -107,10 +99,8 @@ void matvec(const std::vector< sw::unum::posit<nbits, es> >& A, const std::vecto
 	for (size_t i = 0; i < d; ++i) {
 		b[i] = 0;
 		sw::unum::quire<nbits, es, capacity> q;   // initialized to 0 by constructor
-		for (size_t j = 0; j < d; ++j) {
-			q += sw::unum::quire_mul(A[i*d + j], x[j]);
-			if (sw::unum::_trace_quire_add) std::cout << q << '\n';
-		}  
+		sw::unum::fdp_accumulate(q, d, &A[i*d], 1, x.data(), 1);   // row i of A
+		if (sw::unum::_trace_quire_add) std::cout << q << '\n';
 		convert(q.to_value(), b[i]);  // one and only rounding step of the fused-dot product
 		//std::cout << "b[" << i << "] = " << b[i] << std::endl;
 	}
@@ -159,11 +149,9 @@ void matmul(const std::vector<sw::unum::posit<nbits,es> >& A, const std::vector<
 		for (size_t j = 0; j < d; ++j) {
 			C[i*d + j] = 0;
 			sw::unum::quire<nbits, es, capacity> q;   // initialized to 0 by constructor
-			for (size_t k = 0; k < d; ++k) {
-				// C[i*d + j] = C[i*d + j] + A[i*d + k] * B[k*d + j];
-				q += sw::unum::quire_mul(A[i*d + k], B[k*d + j]);
-				if (sw::unum::_trace_quire_add) std::cout << q << '\n';
-			}
+			// C[i*d + j] = sum over k of A[i*d + k] * B[k*d + j]: row i of A and column j of B
+			sw::unum::fdp_accumulate(q, d, &A[i*d], 1, &B[j], d);
+			if (sw::unum::_trace_quire_add) std::cout << q << '\n';
 			convert(q.to_value(), C[i*d + j]);  // one and only rounding step of the fused-dot product
 		}
 	}
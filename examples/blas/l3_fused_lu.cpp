@@ -84,16 +84,14 @@ void CroutFDP(std::vector< sw::unum::posit<nbits, es> >& S, std::vector< sw::unu
 	for (int k = 0; k < d; ++k) {
 		for (int i = k; i < d; ++i) {
 			quire<nbits, es, capacity> q = 0.0;
-			//for (int p = 0; p < k; ++p) q += D[i*d + p] * D[p*d + k];   if we had expression templates for the quire
-			for (int p = 0; p < k; ++p) q += quire_mul(D[i*d + p], D[p*d + k]);
+			for (int p = 0; p < k; ++p) q += fused(D[i*d + p]) * D[p*d + k];
 			posit<nbits, es> sum;
 			sum.convert(q.to_value());     // one and only rounding step of the fused-dot product
 			D[i*d + k] = S[i*d + k] - sum; // not dividing by diagonals
 		}
 		for (int j = k + 1; j < d; ++j) {
 			quire<nbits, es, capacity> q = 0.0;
-			//for (int p = 0; p < k; ++p) q += D[k*d + p] * D[p*d + j];   if we had expression templates for the quire
-			for (int p = 0; p < k; ++p) q += quire_mul(D[k*d + p], D[p*d + j]);
+			for (int p = 0; p < k; ++p) q += fused(D[k*d + p]) * D[p*d + j];
 			posit<nbits, es> sum;
 			sum.convert(q.to_value());   // one and only rounding step of the fused-dot product
 			D[k*d + j] = (S[k*d + j] - sum) / D[k*d + k];
@@ -109,19 +107,14 @@ void SolveCroutFDP(const std::vector< sw::unum::posit<nbits, es> >& LU, const st
 	std::vector< posit<nbits, es> > y(d);
 	for (int i = 0; i < d; ++i) {
 		quire<nbits, es, capacity> q = 0.0;
-		// for (int k = 0; k < i; ++k) q += LU[i*d + k] * y[k];   if we had expression templates for the quire
-		for (int k = 0; k < i; ++k) q += quire_mul(LU[i*d + k], y[k]);
+		q += fused_dot(LU.begin() + i*d, LU.begin() + i*d + i, y.begin());
 		posit<nbits, es> sum;
 		sum.convert(q.to_value());   // one and only rounding step of the fused-dot product
 		y[i] = (b[i] - sum) / LU[i*d + i];
 	}
 	for (int i = d - 1; i >= 0; --i) {
 		quire<nbits, es, capacity> q = 0.0;
-		// for (int k = i + 1; k < d; ++k) q += LU[i*d + k] * x[k];   if we had expression templates for the quire
-		for (int k = i + 1; k < d; ++k) {
-			//cout << "lu[] = " << LU[i*d + k] << " x[" << k << "] = " << x[k] << endl;
-			q += quire_mul(LU[i*d + k], x[k]);
-		}
+		q += fused_dot(LU.begin() + i*d + i + 1, LU.begin() + (i + 1)*d, x.begin() + i + 1);
 		posit<nbits, es> sum;
 		sum.convert(q.to_value());   // one and only rounding step of the fused-dot product
 		//cout << "sum " << sum << endl;
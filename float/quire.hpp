@@ -4,156 +4,104 @@
 // Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <iostream>
+#include "../bitblock/limb_functions.hpp"
 
 namespace sw {
 	namespace ieee {
 
-// template class representing a quire associated with an ieee float configuration
-// capacity indicates the power of 2 number of accumulations the quire can support
+/*
+ quire: template class representing a quire associated with an ieee float configuration.
+ capacity indicates the power of 2 number of accumulations the quire can support.
+
+ The accumulator is a sign and a magnitude held in contiguous 64-bit limbs, least significant bit first:
+ the lower segment holds the bits below 2^0, followed by the upper and capacity segments, the same layout as the
+ posit quire. Every finite value of the configuration, and every product of two of them, including the subnormals,
+ is added exactly, and quires merge exactly. A sum in the quire is therefore independent of the order of its terms,
+ and it is rounded to the IEEE type once, with round-to-nearest-even.
+ */
 template<size_t nbits, size_t es, size_t capacity = 30>
 class quire {
 public:
-	// fixed-point representation of a float multiply requires 1 + 2*(2^ebits + mbits), where ebits and mbits are the number of bits in exponent and mantissa, respectively
-//	type	size	ebits	mbits	exponent range	capacity	quire size	total
-//	float	 32		 8		 24		256				30			561			  591
-//	double	 64		11		 53		2048			30			4203		 4233
-//	lng dbl	128		15		113		32768			30			65763		65793
+	// fixed-point representation of a float multiply: the product of two subnormals has its lsb at 2*(emin - mbits + 1),
+	// and the product of two maximum values its msb below 2^(2^es), where ebits and mbits are the number of bits
+	// in exponent and significand, respectively
+//	type	size	ebits	mbits	range	capacity	quire size	total
+//	float	 32		 8		 24		  608		30			  638	  639
+//	double	 64		11		 53		 4308		30			 4338	 4339
+//	lng dbl	128		15		113		65988		30			66018	66019
 
 	static constexpr size_t ebits = es;
 	static constexpr size_t mbits = nbits - es;
-	static constexpr size_t escale = 2*((size_t(1) << es) + mbits + 1);
+	static constexpr size_t escale = 2*((size_t(1) << es) + 2 * mbits);
 	static constexpr size_t range = escale; 		  // dynamic range of the float configuration
 	static constexpr size_t half_range = range >> 1;          // position of the fixed point
 	static constexpr size_t upper_range = half_range + 1;     // size of the upper accumulator
 	static constexpr size_t qbits = range + capacity;         // size of the quire minus the sign bit: we are managing the sign explicitly
-	
-	quire() : _sign(false) { _capacity.reset(); _upper.reset(); _lower.reset(); }
-	quire(int8_t initial_value) {
+	static constexpr size_t qlimbs = (qbits + 1 + 63) / 64;   // limbs holding the lower, upper, and capacity segments
+	static constexpr uint64_t top_mask = ((qbits + 1) % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << ((qbits + 1) % 64)) - 1);
+
+	quire() : _sign(false) {
+		for (size_t i = 0; i < qlimbs; ++i) _limb[i] = 0;
+	}
+	quire(int8_t initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(int16_t initial_value) {
+	quire(int16_t initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(int32_t initial_value) {
+	quire(int32_t initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(int64_t initial_value) {
+	quire(int64_t initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(uint64_t initial_value) {
+	quire(uint64_t initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(float initial_value) {
+	quire(float initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(double initial_value) {
+	quire(double initial_value) : quire() {
 		*this = initial_value;
 	}
 	template<size_t fbits>
-	quire(const sw::unum::value<fbits>& rhs) {
+	quire(const sw::unum::value<fbits>& rhs) : quire() {
 		*this = rhs;
 	}
-	// TODO: we are clamping the values of the RHS to be withing the dynamic range of the float
-	// TODO: however, on the upper side we also have the capacity bits, which gives us the opportunity to accept larger scale values than the dynamic range of the float.
-	// TODO: is that a good idea?
+
 	template<size_t fbits>
 	quire& operator=(const sw::unum::value<fbits>& rhs) {
 		reset();
-		_sign = rhs.sign();
-		int i,f, scale = rhs.scale();
-		if (scale > int(half_range)) {
-			throw operand_too_large_for_quire{};
-		}
-		if (scale < -int(half_range)) {
-			throw operand_too_small_for_quire{};
-		}
-		sw::unum::bitblock<fbits+1> fraction = rhs.get_fixed_point();
-		// divide bits between upper and lower accumulator
-		if (scale - int(fbits) >= 0) {
-			// all upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-		}
-		else if (scale < 0) {
-			// all lower accumulator
-			for (i = half_range + scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
-		else {
-			// part upper, and part lower accumulator
-			// first assign the bits in the upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-			// next assign the bits in the lower accumulator
-			for (i = half_range - 1; i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
-		return *this;
+		return *this += rhs;
 	}
-	quire& operator=(signed char rhs) {
-		*this = (long long)(rhs);
+	quire& operator=(int8_t rhs) {
+		*this = int64_t(rhs);
 		return *this;
 	}
-	quire& operator=(short int rhs) {
-		*this = (long long)(rhs);
+	quire& operator=(int16_t rhs) {
+		*this = int64_t(rhs);
 		return *this;
 	}
-	quire& operator=(int rhs) {
-		*this = (long long)(rhs);
+	quire& operator=(int32_t rhs) {
+		*this = int64_t(rhs);
 		return *this;
 	}
-	quire& operator=(long long rhs) {
-		clear();
+	quire& operator=(int64_t rhs) {
+		reset();
 		// transform to sign-magnitude
-		_sign = rhs & 0x8000000000000000;
-		unsigned long long magnitude;
-		magnitude = _sign ? -rhs : rhs;
-		unsigned msb = sw::unum::findMostSignificantBit(magnitude);
-		if (msb > half_range + capacity) {
-			throw operand_too_large_for_quire{};
-		}
-		else {
-			// copy the value into the quire
-			unsigned i, c;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = magnitude & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = magnitude & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		_sign = rhs < 0;
+		unsigned long long magnitude = _sign ? 0ull - (unsigned long long)(rhs) : (unsigned long long)(rhs);
+		accumulate_integer(false, 0, magnitude, 0);
 		return *this;
 	}
-	quire& operator=(long long unsigned rhs) {
+	quire& operator=(unsigned long long rhs) {
 		reset();
-		unsigned msb = sw::unum::findMostSignificantBit(rhs);
-		if (msb > half_range + capacity) {
-			throw operand_too_large_for_quire{};
-		}
-		else {
-			// copy the value into the quire
-			unsigned i, c;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = rhs & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = rhs & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		accumulate_integer(false, 0, rhs, 0);
 		return *this;
 	}
 	quire& operator=(float rhs) {
@@ -167,245 +115,49 @@ public:
 		return *this;
 	}
 	quire& operator=(long double rhs) {
-		constexpr int bits = std::numeric_limits<long double>::digits - 1;	
+		constexpr int bits = std::numeric_limits<long double>::digits - 1;
 		*this = sw::unum::value<bits>(rhs);
 		return *this;
 	}
-	
+
+	// add a normalized value to the quire
 	template<size_t fbits>
 	quire& operator+=(const sw::unum::value<fbits>& rhs) {
 		if (rhs.iszero()) return *this;
-		int i, f, scale = rhs.scale();
+		int scale = rhs.scale();
 		if (scale >  int(half_range)) {
 			throw operand_too_large_for_quire{};
 		}
 		if (scale < -int(half_range)) {
 			throw operand_too_small_for_quire{};
 		}
-		if (rhs.sign()) {			// subtract
-			// lsb in the quire of the lowest bit of the explicit fixed point value including the hidden bit of the fraction
-			int lsb = scale - int(fbits);  
-			bool borrow = false;
-			sw::unum::bitblock<fbits + 1> fraction = rhs.get_fixed_point();
-			// divide bits between upper and lower accumulator
-			if (scale < 0) {		// all lower accumulator
-				int lsb = int(half_range) + scale - int(fbits);
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = _a ^ _b ^ borrow;
-					borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-				}
-				// propagate any borrows to the end of the lower accumulator
-				while (borrow && i < int(half_range)) {
-					bool _a = _lower[i];
-					_lower[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-				if (borrow) { // borrow propagate to the _upper accumulator
-							  // need to decrement the _upper
-					i = 0;
-					while (borrow && i < int(upper_range)) {
-						bool _a = _upper[i];
-						_upper[i] = _a ^ borrow;
-						borrow = borrow & !_a;
-						i++;
-					}
-					if (borrow) {
-						// propagate the borrow into the capacity segment
-						i = 0;
-						while (borrow && i < int(capacity)) {
-							bool _a = _capacity[i];
-							_capacity[i] = _a ^ borrow;
-							borrow = borrow & !_a;
-							i++;
-						}
-					}
-				}
-			}
-			else if (lsb >= 0) {	// all upper accumulator
-				for (i = lsb, f = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = _a ^ _b ^ borrow;
-					borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-				}
-				// propagate any borrows to the end of the upper accumulator
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ borrow;
-						borrow = borrow & !_a;
-						i++;
-					}
-				}
-			}
-			else {   // lsb < 0 && scale >= 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-				lsb = int(half_range) + lsb; // remember lsb is negative in this block
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = _a ^ _b ^ borrow;
-					borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-				}
-				// next add the bits in the upper accumulator
-				for (i = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = _a ^ _b ^ borrow;
-					borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-				}
-				// propagate any borrows to the end of the upper accumulator
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ borrow;
-						borrow = borrow & !_a;
-						i++;
-					}
-				}			
-			}
-		}
-		else {			// add
-			// scale is the location of the msb in the fixed point representation
-			// so scale  =  0 is the hidden bit at location 0, scale 1 = bit 1, etc.
-			// and scale = -1 is the first bit of the fraction
-			// we manage scale >= 0 in the _upper accumulator, and scale < 0 in the _lower accumulator
-			int lsb = scale - int(fbits);
-			bool carry = false;
-			sw::unum::bitblock<fbits + 1> fraction = rhs.get_fixed_point();
-			// divide bits between upper and lower accumulator
-			if (scale < 0) {		// all lower accumulator
-				int lsb = int(half_range) + scale - int(fbits);
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = _a ^ _b ^ carry;
-					carry = (_a & _b) | (carry & (_a ^ _b));
-				}
-				// propagate any carries to the end of the lower accumulator
-				while (carry && i < int(half_range)) {
-					bool _a = _lower[i];
-					_lower[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-				if (carry) {  // carry propagate to the _upper accumulator
-							  // need to increment the _upper
-					i = 0;
-					while (carry && i < int(upper_range)) {
-						bool _a = _upper[i];
-						_upper[i] = _a ^ carry;
-						carry = carry & _a;
-						i++;
-					}
-					if (carry) {
-						// next add the bits to the capacity segment
-						i = 0;
-						while (carry && i < int(capacity)) {
-							bool _a = _capacity[i];
-							_capacity[i] = _a ^ carry;
-							carry = carry & _a;
-							i++;
-						}
-					}
-				}
-			}
-			else if (lsb >= 0) {	// all upper accumulator
-				for (i = lsb, f = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = _a ^ _b ^ carry;
-					carry = (_a & _b) | (carry & (_a ^ _b));
-				}
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-				if (carry) {
-					// next add the bits to the capacity segment
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ carry;
-						carry = carry & _a;
-						i++;
-					}
-				}
-			}
-			else {  // lsb < 0 && scale > 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-				lsb = int(half_range) + lsb; // remember lsb is negative in this block
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = _a ^ _b ^ carry;
-					carry = (_a & _b) | (carry & (_a ^ _b));
-				}
-				// next add the bits in the upper accumulator
-				for (i = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = _a ^ _b ^ carry;
-					carry = (_a & _b) | (carry & (_a ^ _b));
-				}
-				// propagate any carries to the end of the upper accumulator
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-				// next add the bits to the capacity segment
-				if (carry) {
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ carry;
-						carry = carry & _a;
-						i++;
-					}
-				}
-			}
-		}
+		long long lsb = (long long)half_range + scale - (long long)fbits;   // quire position of the lsb of the significand
+		sw::unum::bitblock<fbits> fraction = rhs.fraction();
+		accumulate(rhs.sign(), [&fraction](long long pos) { return significand_word(fraction, pos); }, lsb, size_t((long long)half_range + scale) / 64);
 		return *this;
 	}
+	template<size_t fbits>
+	quire& operator-=(const sw::unum::value<fbits>& rhs) {
+		return *this += -rhs;
+	}
+	// add two quires: the magnitudes are merged limb by limb, so no bits of either quire are lost
+	quire& operator+=(const quire& q) {
+		return merge(q, false);
+	}
+	quire& operator-=(const quire& q) {
+		return merge(q, true);
+	}
+
+	// add a finite float or double, or the exact product of two of them, directly from their encoding
+	quire& add(float x) { return add_native(x); }
+	quire& add(double x) { return add_native(x); }
+	quire& add_product(float a, float b) { return add_native_product(a, b); }
+	quire& add_product(double a, double b) { return add_native_product(a, b); }
+
 	// reset the state of a quire to zero
 	void reset() {
 		_sign  = false;
-		_lower.reset();
-		_upper.reset();
-		_capacity.reset();
+		for (size_t i = 0; i < qlimbs; ++i) _limb[i] = 0;
 	}
 	// clear the state of a quire to zero
 	void clear() { reset(); }
@@ -416,7 +168,10 @@ public:
 	int capacity_range() const { return capacity; }
 	bool isneg() const { return _sign; }
 	bool ispos() const { return !_sign; }
-	bool iszero() const { return _capacity.none() && _upper.none() && _lower.none(); }
+	bool iszero() const {
+		for (size_t i = 0; i < qlimbs; ++i) if (_limb[i]) return false;
+		return true;
+	}
 
 	// Return value of the sign bit: true indicates a negative number, false a positive number or zero
 	bool get_sign() const { return _sign; }
@@ -424,80 +179,216 @@ public:
 	sw::unum::value<qbits> to_value() const {
 		// find the MSB and build the fraction
 		sw::unum::bitblock<qbits> fraction;
-		bool isZero = false;
-		bool isNaR = false;   // TODO
-		int i;
-		int qbit = int(qbits);
-		int fbit = qbit - 1;
-		int scale = qbits;
-		for (i = int(capacity) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_capacity.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _capacity[i];
-			}
-		}
-		for (i = int(upper_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_upper.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _upper[i];
-			}
-		}
-		for (i = int(half_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_lower.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _lower[i];
-			}
-		}
-		if (scale == qbits) {
-			isZero = true;
-			scale = 0;
+		int msbit = msb();
+		if (msbit < 0) return sw::unum::value<qbits>(_sign, 0, fraction, true, false);
+		// the fraction bits are the quire bits below the msb, left aligned in the qbits of the value
+		long long offset = (long long)msbit - (long long)qbits;
+#if BITBLOCK_LIMB_ENGINE
+		for (size_t i = 0; i < sw::unum::bitblock<qbits>::nrBlocks; ++i) fraction.setblock(i, word_at(offset + (long long)(64 * i)));
+#else
+		for (size_t i = 0; i < qbits; ++i) fraction[i] = (offset + (long long)i >= 0 && bit(size_t(offset + (long long)i)));
+#endif
+		return sw::unum::value<qbits>(_sign, msbit - int(half_range), fraction, false, false);
+	}
+	// round the quire to the nearest IEEE value, ties to even: subnormal results and overflow to infinity
+	// follow IEEE-754, and an exact zero rounds to +0
+	template<typename Real>
+	Real round_to() const {
+		constexpr int digits = std::numeric_limits<Real>::digits;
+		constexpr int emin = std::numeric_limits<Real>::min_exponent - 1;   // scale of the smallest normal value
+		int msbit = msb();
+		if (msbit < 0) return Real(0);
+		int scale = msbit - int(half_range);
+		int precision = digits - (scale < emin ? emin - scale : 0);     // significand bits available at this scale
+		if (precision < 0) return (_sign ? -Real(0) : Real(0));
+		long long lsb = (long long)msbit - precision + 1;                // quire position of the lsb of the result
+		uint64_t significand = 0;
+		if (precision > 0) significand = word_at(lsb) & (precision == 64 ? ~uint64_t(0) : (uint64_t(1) << precision) - 1);
+		bool guard = (lsb >= 1 && bit(size_t(lsb - 1)));
+		bool sticky = (lsb >= 2 && any_below(size_t(lsb - 1)));
+		if (guard && (sticky || (significand & 1)) && ++significand == 0) {
+			// a 64-bit significand carried out: 2^64 is 2^63 one position up
+			significand = uint64_t(1) << 63;
+			++lsb;
 		}
-		return sw::unum::value<qbits>(_sign, scale, fraction, isZero, isNaR);
+		Real r = std::ldexp(Real(significand), int(lsb - (long long)half_range));
+		return (_sign ? -r : r);
 	}
+	float to_float() const { return round_to<float>(); }
+	double to_double() const { return round_to<double>(); }
+	long double to_long_double() const { return round_to<long double>(); }
 
 private:
 	bool				   _sign;
-	// segmented accumulator to demonstrate potential hw concurrency for high performance quires
-	// TODO: don't pull a type from sw::unum
-	sw::unum::bitblock<half_range>   _lower;
-	sw::unum::bitblock<upper_range>  _upper;
-	sw::unum::bitblock<capacity>     _capacity;
-
-#if TEMPLATIZED_TYPE
-	//  when we figure out how to templatize the extraction of exponent bits from type
+	uint64_t               _limb[qlimbs];   // magnitude: lower segment at bit 0, then the upper and capacity segments
 
-	// template parameters need names different from class template parameters (for gcc and clang)
-	template<typename TTy, size_t ncapacity>
-	friend std::ostream& operator<< (std::ostream& ostr, const quire<TTy,ncapacity>& q);
-	template<typename TTy, size_t ncapacity>
-	friend std::istream& operator>> (std::istream& istr, quire<TTy, ncapacity>& q);
+	bool bit(size_t i) const { return ((_limb[i / 64] >> (i % 64)) & 1) != 0; }
+	// true when any bit below position pos is set
+	bool any_below(size_t pos) const {
+		for (size_t i = 0; i < pos / 64; ++i) if (_limb[i]) return true;
+		return (pos % 64) && (_limb[pos / 64] & ((uint64_t(1) << (pos % 64)) - 1));
+	}
+	// position of the most significant bit of the magnitude, -1 when the quire is zero
+	int msb() const {
+		for (size_t i = qlimbs; i-- > 0; ) {
+			if (_limb[i]) return int(64 * i) + 63 - sw::unum::nlz(_limb[i]);
+		}
+		return -1;
+	}
+	// the 64 bits of the magnitude starting at bit position lsb, zero-filled outside of the limbs
+	uint64_t word_at(long long lsb) const {
+		if (lsb <= -64 || lsb >= (long long)(64 * qlimbs)) return 0;
+		if (lsb < 0) return _limb[0] << size_t(-lsb);
+		size_t i = size_t(lsb) / 64;
+		size_t shift = size_t(lsb) % 64;
+		uint64_t lo = _limb[i] >> shift;
+		if (shift == 0 || i + 1 >= qlimbs) return lo;
+		return lo | (_limb[i + 1] << (64 - shift));
+	}
+	// the 64 bits of the fixed-point significand 1.fraction starting at bit position lsb of the significand
+	template<size_t fbits>
+	static uint64_t significand_word(const sw::unum::bitblock<fbits>& fraction, long long lsb) {
+#if BITBLOCK_LIMB_ENGINE
+		uint64_t w = fraction.block_at(lsb);
+#else
+		uint64_t w = 0;
+		for (long long i = 0; i < 64; ++i) {
+			long long pos = lsb + i;
+			if (pos >= 0 && pos < (long long)fbits && fraction[size_t(pos)]) w |= uint64_t(1) << i;
+		}
+#endif
+		long long hidden = (long long)fbits - lsb;
+		if (hidden >= 0 && hidden < 64) w |= uint64_t(1) << hidden;
+		return w;
+	}
+	// the 64 bits of a 128-bit integer hi.lo starting at bit position lsb
+	static uint64_t wide_word(uint64_t hi, uint64_t lo, long long lsb) {
+		if (lsb <= -64 || lsb >= 128) return 0;
+		if (lsb < 0) return lo << size_t(-lsb);
+		if (lsb == 0) return lo;
+		if (lsb < 64) return (lo >> size_t(lsb)) | (hi << size_t(64 - lsb));
+		return hi >> size_t(lsb - 64);
+	}
 
-	template<size_t nnbits, size_t nes, size_t ncapacity>
-	friend bool operator==(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, size_t ncapacity>
-	friend bool operator!=(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, size_t ncapacity>
-	friend bool operator< (const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, size_t ncapacity>
-	friend bool operator> (const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, size_t ncapacity>
-	friend bool operator<=(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, size_t ncapacity>
-	friend bool operator>=(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
+	// decompose a finite IEEE value into (-1)^sign * significand * 2^exponent with an integer significand
+	static void decompose(double x, bool& sign, int& exponent, uint64_t& significand) {
+		uint64_t bits;
+		std::memcpy(&bits, &x, sizeof(bits));
+		sign = (bits >> 63) != 0;
+		int biased = int((bits >> 52) & 0x7FF);
+		if (biased == 0x7FF) throw operand_too_large_for_quire("quire cannot accumulate an infinity or NaN");
+		significand = bits & ((uint64_t(1) << 52) - 1);
+		if (biased == 0) {
+			exponent = -1074;
+		}
+		else {
+			significand |= uint64_t(1) << 52;
+			exponent = biased - 1075;
+		}
+	}
+	static void decompose(float x, bool& sign, int& exponent, uint64_t& significand) {
+		uint32_t bits;
+		std::memcpy(&bits, &x, sizeof(bits));
+		sign = (bits >> 31) != 0;
+		int biased = int((bits >> 23) & 0xFF);
+		if (biased == 0xFF) throw operand_too_large_for_quire("quire cannot accumulate an infinity or NaN");
+		significand = bits & ((uint32_t(1) << 23) - 1);
+		if (biased == 0) {
+			exponent = -149;
+		}
+		else {
+			significand |= uint64_t(1) << 23;
+			exponent = biased - 150;
+		}
+	}
+	template<typename Real>
+	quire& add_native(Real x) {
+		bool sign;
+		int exponent;
+		uint64_t significand;
+		decompose(x, sign, exponent, significand);
+		accumulate_integer(sign, 0, significand, exponent);
+		return *this;
+	}
+	template<typename Real>
+	quire& add_native_product(Real a, Real b) {
+		bool sa, sb;
+		int ea, eb;
+		uint64_t ma, mb;
+		decompose(a, sa, ea, ma);
+		decompose(b, sb, eb, mb);
+		if (ma == 0 || mb == 0) return *this;
+		uint64_t hi;
+		uint64_t lo = sw::unum::mul128(ma, mb, hi);
+		accumulate_integer(sa != sb, hi, lo, ea + eb);
+		return *this;
+	}
+	// add (-1)^sign * hi.lo * 2^exponent, a 128-bit integer, to the quire
+	void accumulate_integer(bool sign, uint64_t hi, uint64_t lo, int exponent) {
+		if (hi == 0 && lo == 0) return;
+		long long lsb = (long long)half_range + exponent;
+		long long msbit = lsb + (hi ? 127 - sw::unum::nlz(hi) : 63 - sw::unum::nlz(lo));
+		if (msbit > (long long)qbits) throw operand_too_large_for_quire{};
+		if (lsb < 0) throw operand_too_small_for_quire{};
+		accumulate(sign, [hi, lo](long long pos) { return wide_word(hi, lo, pos); }, lsb, size_t(msbit) / 64);
+	}
 
-#else
+	// add or subtract a significand in sign/magnitude form.
+	// word(pos) returns the 64 bits of the significand starting at bit position pos, which has its lsb at quire bit lsb
+	// and its msb in limb last
+	template<typename Significand>
+	void accumulate(bool sign, const Significand& word, long long lsb, size_t last) {
+		size_t first = (lsb > 0 ? size_t(lsb) / 64 : 0);
+		size_t i;
+		if (_sign == sign) {
+			uint64_t carry = 0;
+			for (i = first; i <= last; ++i) _limb[i] = sw::unum::addcarry(_limb[i], word((long long)(64 * i) - lsb), carry);
+			for (; carry && i < qlimbs; ++i) _limb[i] = sw::unum::addcarry(_limb[i], 0, carry);
+			_limb[qlimbs - 1] &= top_mask;   // carries out of the capacity segment are lost
+			return;
+		}
+		uint64_t borrow = 0;
+		for (i = first; i <= last; ++i) _limb[i] = sw::unum::subborrow(_limb[i], word((long long)(64 * i) - lsb), borrow);
+		for (; borrow && i < qlimbs; ++i) _limb[i] = sw::unum::subborrow(_limb[i], 0, borrow);
+		if (borrow) {
+			// the addend was bigger: negate the magnitude into addend - quire
+			negate_magnitude();
+			_sign = sign;
+		}
+		else {
+			// the magnitude can only have become zero when the limbs that were updated are zero
+			for (size_t k = first; k < i; ++k) if (_limb[k]) return;
+			if (iszero()) _sign = false;
+		}
+	}
+	quire& merge(const quire& q, bool negate) {
+		bool sign = (q._sign != negate);
+		if (_sign == sign) {
+			uint64_t carry = 0;
+			for (size_t i = 0; i < qlimbs; ++i) _limb[i] = sw::unum::addcarry(_limb[i], q._limb[i], carry);
+			_limb[qlimbs - 1] &= top_mask;   // carries out of the capacity segment are lost
+			return *this;
+		}
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < qlimbs; ++i) _limb[i] = sw::unum::subborrow(_limb[i], q._limb[i], borrow);
+		if (borrow) {
+			negate_magnitude();
+			_sign = sign;
+		}
+		else if (iszero()) {
+			_sign = false;
+		}
+		return *this;
+	}
+	void negate_magnitude() {
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < qlimbs; ++i) _limb[i] = sw::unum::subborrow(0, _limb[i], borrow);
+		_limb[qlimbs - 1] &= top_mask;
+	}
 
 	// template parameters need names different from class template parameters (for gcc and clang)
 	template<size_t nnbits, size_t nes, size_t ncapacity>
 	friend std::ostream& operator<< (std::ostream& ostr, const quire<nnbits, nes, ncapacity>& q);
-	template<size_t nnbits, size_t nes, size_t ncapacity>
-	friend std::istream& operator>> (std::istream& istr, quire<nnbits, nes, ncapacity>& q);
 
 	template<size_t nnbits, size_t nes, size_t ncapacity>
 	friend bool operator==(const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
@@ -511,66 +402,8 @@ private:
 	friend bool operator<=(const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
 	template<size_t nnbits, size_t nes, size_t ncapacity>
 	friend bool operator>=(const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
-
-#endif // TEMPLATIZED_TYPE
 };
 
-#if TEMPLATIZED_TYPE
-
-// QUIRE BINARY ARITHMETIC OPERATORS
-template<typename Ty, size_t capacity>
-inline quire<Ty, capacity> operator+(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) {
-	quire<Ty, capacity> sum = lhs;
-	sum += rhs;
-	return sum;
-}
-
-
-////////////////// QUIRE operators
-template<typename Ty, size_t capacity>
-inline std::ostream& operator<<(std::ostream& ostr, const quire<Ty, capacity>& q) {
-	ostr << (q._sign ? "-1" : " 1") << ": " << q._capacity << "_" << q._upper << "." << q._lower;
-	return ostr;
-}
-
-template<typename Ty, size_t capacity>
-inline std::istream& operator>> (std::istream& istr, const quire<Ty, capacity>& q) {
-	istr >> q._accu;
-	return istr;
-}
-
-template<typename Ty, size_t capacity>
-inline bool operator==(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
-template<typename Ty, size_t capacity>
-inline bool operator!=(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return !operator==(lhs, rhs); }
-template<typename Ty, size_t capacity>
-inline bool operator< (const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { 
-	bool bSmaller = false;
-	if (!lhs._sign && rhs._sign) {
-		bSmaller = true;
-	}
-	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-			bSmaller = true;
-		}
-	}
-	return bSmaller;
-}
-template<typename Ty, size_t capacity>
-inline bool operator> (const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return  operator< (rhs, lhs); }
-template<typename Ty, size_t capacity>
-inline bool operator<=(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return !operator> (lhs, rhs) || lhs == rhs; }
-template<typename Ty, size_t capacity>
-inline bool operator>=(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return !operator< (lhs, rhs) || lhs == rhs; }
-
-#else
-
 // QUIRE BINARY ARITHMETIC OPERATORS
 template<size_t nbits, size_t es, size_t capacity>
 inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
@@ -583,18 +416,24 @@ inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lh
 ////////////////// QUIRE operators
 template<size_t nnbits, size_t nes, size_t capacity>
 inline std::ostream& operator<<(std::ostream& ostr, const quire<nnbits, nes, capacity>& q) {
-	ostr << (q._sign ? "-1" : " 1") << ": " << q._capacity << "_" << q._upper << "." << q._lower;
-	return ostr;
-}
-
-template<size_t nnbits, size_t nes, size_t capacity>
-inline std::istream& operator>> (std::istream& istr, const quire<nnbits, nes, capacity>& q) {
-	istr >> q._accu;
-	return istr;
+	typedef quire<nnbits, nes, capacity> Quire;
+	std::string bits;
+	bits.reserve(Quire::qbits + 6);
+	bits += (q._sign ? "-1: " : " 1: ");
+	for (size_t i = Quire::qbits + 1; i-- > 0; ) {
+		if (i + 1 == Quire::half_range + Quire::upper_range) bits += '_';   // capacity_upper.lower
+		if (i + 1 == Quire::half_range) bits += '.';
+		bits += (q.bit(i) ? '1' : '0');
+	}
+	return ostr << bits;
 }
 
 template<size_t nbits, size_t es, size_t capacity>
-inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
+inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
+	if (lhs._sign != rhs._sign) return false;
+	for (size_t i = 0; i < quire<nbits, es, capacity>::qlimbs; ++i) if (lhs._limb[i] != rhs._limb[i]) return false;
+	return true;
+}
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator!=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
 template<size_t nbits, size_t es, size_t capacity>
@@ -604,17 +443,14 @@ inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits,
 		bSmaller = true;
 	}
 	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-		bSmaller = true;
-	}
-	else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-		bSmaller = true;
-	}
-	else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-		bSmaller = true;
+		for (size_t i = quire<nbits, es, capacity>::qlimbs; i-- > 0; ) {
+			if (lhs._limb[i] != rhs._limb[i]) {
+				bSmaller = lhs._limb[i] < rhs._limb[i];
+				break;
+			}
+		}
 	}
-}
-return bSmaller;
+	return bSmaller;
 }
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator> (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return  operator< (rhs, lhs); }
@@ -622,7 +458,6 @@ template<size_t nbits, size_t es, size_t capacity>
 inline bool operator<=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator> (lhs, rhs) || lhs == rhs; }
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator>=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator< (lhs, rhs) || lhs == rhs; }
-#endif
 
 }  // namespace ieee
 
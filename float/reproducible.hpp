@@ -0,0 +1,159 @@
+#pragma once
+// reproducible.hpp: exact and reproducible sums, dot products, and matrix-vector products of IEEE float and double arrays
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace sw {
+	namespace ieee {
+
+/*
+ The reproducible operators accumulate every term, or every product, exactly in a quire of the IEEE type
+ and round the sum once to nearest-even. The arrays are partitioned over a number of threads, every thread
+ accumulates its slice in a private quire, and the partial quires are merged exactly. No partial sum is rounded,
+ so the results are correctly rounded and bit-identical for any order of the terms and any number of threads.
+ Infinities and NaNs do not enter the quire: they are tracked as flags and produce the IEEE result of the sum.
+ */
+
+// the quire configuration that accumulates the products of an IEEE type
+template<typename Real> struct reproducible_quire;
+template<> struct reproducible_quire<float>  { typedef quire<32,  8, 30> type; };
+template<> struct reproducible_quire<double> { typedef quire<64, 11, 30> type; };
+
+// exact accumulator of terms and products of an IEEE type, including the special values
+template<typename Real>
+class reproducible_accumulator {
+public:
+	typedef typename reproducible_quire<Real>::type Quire;
+
+	reproducible_accumulator() : _nan(false), _pinf(false), _ninf(false) {}
+
+	void reset() {
+		_q.reset();
+		_nan = _pinf = _ninf = false;
+	}
+	void add(Real x) {
+		if (std::isfinite(x)) _q.add(x); else special(x);
+	}
+	void add_product(Real a, Real b) {
+		if (std::isfinite(a) && std::isfinite(b)) {
+			_q.add_product(a, b);
+		}
+		else {
+			special(a * b);   // a NaN operand or inf * 0 yields NaN, otherwise a signed infinity
+		}
+	}
+	reproducible_accumulator& operator+=(const reproducible_accumulator& rhs) {
+		_q += rhs._q;
+		_nan  |= rhs._nan;
+		_pinf |= rhs._pinf;
+		_ninf |= rhs._ninf;
+		return *this;
+	}
+	// the sum rounded to nearest-even
+	Real value() const {
+		if (_nan || (_pinf && _ninf)) return std::numeric_limits<Real>::quiet_NaN();
+		if (_pinf) return std::numeric_limits<Real>::infinity();
+		if (_ninf) return -std::numeric_limits<Real>::infinity();
+		return _q.template round_to<Real>();
+	}
+	const Quire& get_quire() const { return _q; }
+
+private:
+	Quire _q;
+	bool  _nan, _pinf, _ninf;
+
+	void special(Real x) {
+		if (std::isnan(x)) _nan = true; else if (x > 0) _pinf = true; else _ninf = true;
+	}
+};
+
+// accumulate the slices [n*t/nrSlices, n*(t+1)/nrSlices) of an index range in private accumulators and merge them
+// in slice order. The calling thread reduces the first slice while the others run asynchronously
+template<typename Real, typename Slice>
+inline reproducible_accumulator<Real> reproducible_reduce(size_t n, size_t nrThreads, const Slice& slice) {
+	size_t nrSlices = (nrThreads < 1 ? 1 : (nrThreads > n ? n : nrThreads));
+	reproducible_accumulator<Real> sum;
+	if (nrSlices <= 1) {
+		slice(size_t(0), n, sum);
+		return sum;
+	}
+	std::vector< std::future< reproducible_accumulator<Real> > > partials;
+	partials.reserve(nrSlices - 1);
+	for (size_t t = 1; t < nrSlices; ++t) {
+		size_t begin = n * t / nrSlices, end = n * (t + 1) / nrSlices;
+		partials.push_back(std::async(std::launch::async, [&slice, begin, end]() {
+			reproducible_accumulator<Real> partial;
+			slice(begin, end, partial);
+			return partial;
+		}));
+	}
+	slice(size_t(0), n / nrSlices, sum);
+	for (auto& partial : partials) sum += partial.get();
+	return sum;
+}
+
+// the sum of the strided array x[0], x[incx], ..., x[(n-1)*incx], correctly rounded
+template<typename Real>
+inline Real reproducible_sum(size_t n, const Real* x, size_t incx = 1, size_t nrThreads = 1) {
+	return reproducible_reduce<Real>(n, nrThreads, [x, incx](size_t begin, size_t end, reproducible_accumulator<Real>& acc) {
+		for (size_t i = begin; i < end; ++i) acc.add(x[i * incx]);
+	}).value();
+}
+template<typename Real>
+inline Real reproducible_sum(const std::vector<Real>& x, size_t nrThreads = 1) {
+	return reproducible_sum(x.size(), x.data(), 1, nrThreads);
+}
+
+// the dot product of the strided arrays x and y, correctly rounded
+template<typename Real>
+inline Real reproducible_dot(size_t n, const Real* x, size_t incx, const Real* y, size_t incy, size_t nrThreads = 1) {
+	return reproducible_reduce<Real>(n, nrThreads, [x, incx, y, incy](size_t begin, size_t end, reproducible_accumulator<Real>& acc) {
+		for (size_t i = begin; i < end; ++i) acc.add_product(x[i * incx], y[i * incy]);
+	}).value();
+}
+template<typename Real>
+inline Real reproducible_dot(const std::vector<Real>& x, const std::vector<Real>& y, size_t nrThreads = 1) {
+	if (x.size() != y.size()) throw std::runtime_error("reproducible_dot: vectors of different size");
+	return reproducible_dot(x.size(), x.data(), 1, y.data(), 1, nrThreads);
+}
+
+// y = A * x + beta * y for the m x n row-major matrix A with leading dimension lda.
+// Every element of y is a single correctly rounded dot product of a row of A with x, including the beta * y term.
+// When beta is zero, y is not read. The rows are partitioned over the threads, so each element of y
+// is computed by one thread and is independent of the number of threads
+template<typename Real>
+inline void reproducible_gemv(size_t m, size_t n, const Real* A, size_t lda, const Real* x, size_t incx, Real beta, Real* y, size_t incy, size_t nrThreads = 1) {
+	auto rows = [=](size_t begin, size_t end) {
+		reproducible_accumulator<Real> acc;
+		for (size_t i = begin; i < end; ++i) {
+			acc.reset();
+			const Real* row = A + i * lda;
+			for (size_t j = 0; j < n; ++j) acc.add_product(row[j], x[j * incx]);
+			if (beta != Real(0)) acc.add_product(beta, y[i * incy]);
+			y[i * incy] = acc.value();
+		}
+	};
+	size_t nrSlices = (nrThreads < 1 ? 1 : (nrThreads > m ? m : nrThreads));
+	if (nrSlices <= 1) {
+		rows(0, m);
+		return;
+	}
+	std::vector< std::future<void> > slices;
+	slices.reserve(nrSlices - 1);
+	for (size_t t = 1; t < nrSlices; ++t) {
+		slices.push_back(std::async(std::launch::async, rows, m * t / nrSlices, m * (t + 1) / nrSlices));
+	}
+	rows(0, m / nrSlices);
+	for (auto& slice : slices) slice.get();
+}
+
+}  // namespace ieee
+
+}  // namespace sw
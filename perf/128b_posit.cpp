@@ -0,0 +1,54 @@
+// 128b_posit.cpp: performance characterization of standard posit<128,4> configuration
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+// Configure the posit template environment
+// first: enable fast specialized posit<128,4>
+#define POSIT_FAST_POSIT_128_4 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <posit>
+#include "posit_performance.hpp"
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	constexpr size_t nbits = 128;
+	constexpr size_t es = 4;
+	//constexpr size_t capacity = 6;   // 2^6 accumulations of maxpos^2
+
+	OperatorPerformance perfReport;
+	GeneratePerformanceReport<nbits, es>(perfReport);
+	ReportPerformance<nbits, es>(cout, "posit<128,4>", perfReport);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
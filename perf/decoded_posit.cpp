@@ -0,0 +1,153 @@
+// decoded_posit.cpp: performance characterization of chained arithmetic on unpacked posits
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <algorithm>
+// disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <posit>
+
+// Time the axpy and dot kernels on posits, where every operation decodes its operands and encodes its result,
+// against the same kernels on unpacked posits, which unpack the inputs once and pack the results once.
+// Both variants round every intermediate onto the posit grid, so their results must be identical.
+
+struct KernelTiming {
+	double packed;     // nanoseconds per element
+	double unpacked;   // nanoseconds per element
+	bool   match;      // both kernels produce the same result
+};
+
+template<size_t nbits, size_t es>
+KernelTiming MeasureAxpy(const std::vector<sw::unum::posit<nbits, es> >& x, std::vector<sw::unum::posit<nbits, es> >& y, int reps) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	typedef posit<nbits, es> Posit;
+	typedef posit_decoded<nbits, es> Decoded;
+	const size_t n = x.size();
+	const Posit a(0.75);
+	std::vector<Posit> yp(y), yd(y);
+
+	KernelTiming timing;
+	timing.packed = timing.unpacked = 1.0e30;
+	for (int trial = 0; trial < 3; ++trial) {
+		// y = a*x + y, applied reps times to form a chain of dependent operations per element
+		steady_clock::time_point begin = steady_clock::now();
+		yp = y;
+		for (int r = 0; r < reps; ++r) {
+			for (size_t i = 0; i < n; ++i) yp[i] = a * x[i] + yp[i];
+		}
+		steady_clock::time_point end = steady_clock::now();
+		timing.packed = std::min(timing.packed, duration_cast<duration<double, std::nano>>(end - begin).count() / double(n * reps));
+
+		begin = steady_clock::now();
+		std::vector<Decoded> xd(n), acc(n);
+		for (size_t i = 0; i < n; ++i) {
+			xd[i] = x[i];
+			acc[i] = y[i];
+		}
+		const Decoded ad(a);
+		for (int r = 0; r < reps; ++r) {
+			for (size_t i = 0; i < n; ++i) acc[i] = ad * xd[i] + acc[i];
+		}
+		for (size_t i = 0; i < n; ++i) yd[i] = acc[i].pack();
+		end = steady_clock::now();
+		timing.unpacked = std::min(timing.unpacked, duration_cast<duration<double, std::nano>>(end - begin).count() / double(n * reps));
+	}
+	timing.match = (yp == yd);
+	return timing;
+}
+
+template<size_t nbits, size_t es>
+KernelTiming MeasureDot(const std::vector<sw::unum::posit<nbits, es> >& x, const std::vector<sw::unum::posit<nbits, es> >& y, int reps) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	typedef posit<nbits, es> Posit;
+	typedef posit_decoded<nbits, es> Decoded;
+	const size_t n = x.size();
+	Posit sp, sd;
+
+	KernelTiming timing;
+	timing.packed = timing.unpacked = 1.0e30;
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (int r = 0; r < reps; ++r) {
+			sp = 0;
+			for (size_t i = 0; i < n; ++i) sp += x[i] * y[i];
+		}
+		steady_clock::time_point end = steady_clock::now();
+		timing.packed = std::min(timing.packed, duration_cast<duration<double, std::nano>>(end - begin).count() / double(n * reps));
+
+		// the vectors are unpacked once, as a kernel reusing its operands in many products would
+		begin = steady_clock::now();
+		std::vector<Decoded> xd(n), yd(n);
+		for (size_t i = 0; i < n; ++i) {
+			xd[i] = x[i];
+			yd[i] = y[i];
+		}
+		for (int r = 0; r < reps; ++r) {
+			Decoded sum;
+			for (size_t i = 0; i < n; ++i) sum += xd[i] * yd[i];
+			sd = sum.pack();
+		}
+		end = steady_clock::now();
+		timing.unpacked = std::min(timing.unpacked, duration_cast<duration<double, std::nano>>(end - begin).count() / double(n * reps));
+	}
+	timing.match = (sp == sd);
+	return timing;
+}
+
+template<size_t nbits, size_t es>
+int ReportKernels(std::ostream& ostr, const std::string& tag, size_t n, int reps) {
+	std::mt19937_64 eng(nbits);
+	std::uniform_real_distribution<double> distr(-1.0, 1.0);
+	std::vector<sw::unum::posit<nbits, es> > x(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = distr(eng);
+		y[i] = distr(eng);
+	}
+	KernelTiming axpy = MeasureAxpy(x, y, reps);
+	KernelTiming dot = MeasureDot(x, y, reps);
+	int nrOfFailedTestCases = 0;
+	for (const KernelTiming* t : { &axpy, &dot }) {
+		ostr << std::setw(14) << tag << std::setw(6) << (t == &axpy ? "axpy" : "dot")
+			<< std::fixed << std::setprecision(1) << std::setw(14) << t->packed << std::setw(14) << t->unpacked
+			<< std::setprecision(2) << std::setw(10) << t->packed / t->unpacked << (t->match ? "" : "  FAIL: results differ") << std::endl;
+		if (!t->match) ++nrOfFailedTestCases;
+	}
+	return nrOfFailedTestCases;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	constexpr size_t n = 4096;
+	constexpr int reps = 64;
+
+	cout << "Chained arithmetic: posit versus unpacked posit (ns per element)" << endl;
+	cout << setw(14) << "config" << setw(6) << "op" << setw(14) << "posit" << setw(14) << "unpacked" << setw(10) << "speedup" << endl;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportKernels<10, 1>(cout, "posit<10,1>", n, reps);
+	nrOfFailedTestCases += ReportKernels<24, 1>(cout, "posit<24,1>", n, reps);
+	nrOfFailedTestCases += ReportKernels<32, 2>(cout, "posit<32,2>", n, reps);
+	nrOfFailedTestCases += ReportKernels<48, 2>(cout, "posit<48,2>", n, reps);
+	nrOfFailedTestCases += ReportKernels<64, 3>(cout, "posit<64,3>", n, reps);
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
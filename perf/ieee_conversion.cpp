@@ -0,0 +1,154 @@
+// ieee_conversion.cpp: performance characterization of the conversions between IEEE floating-point and posits
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <algorithm>
+#include "../posit/posit.hpp"
+
+// Time the assignment of doubles to posits through the bit pattern of the IEEE value
+// against the reference conversion that extracts the fields with frexp into a value<52> and rounds it with convert(),
+// and the conversion of posits to doubles that assembles the IEEE bit pattern against the product
+// of the floating-point values of the regime, exponent, and fraction fields.
+
+struct ConversionTiming {
+	double direct;     // nanoseconds per conversion
+	double reference;  // nanoseconds per conversion
+	bool   match;      // both conversions produce the same posits
+};
+
+template<size_t nbits, size_t es>
+ConversionTiming MeasureConversion(std::mt19937_64& eng) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	constexpr size_t NR_OPERANDS = 1024;
+	std::uniform_real_distribution<double> significand(1.0, 2.0);
+	std::uniform_int_distribution<int> scale(-int(nbits) * (1 << es) / 2, int(nbits) * (1 << es) / 2);
+	std::vector<double> x(NR_OPERANDS);
+	for (size_t i = 0; i < NR_OPERANDS; ++i) x[i] = std::ldexp(i % 2 ? -significand(eng) : significand(eng), scale(eng));
+
+	std::vector< posit<nbits, es> > direct(NR_OPERANDS), reference(NR_OPERANDS);
+	ConversionTiming timing;
+	timing.direct = timing.reference = 1.0e30;
+	const size_t reps = std::max(size_t(1), 64 / (1 + nbits / 64));
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (size_t r = 0; r < reps; ++r) {
+			for (size_t i = 0; i < NR_OPERANDS; ++i) direct[i] = x[i];
+		}
+		steady_clock::time_point end = steady_clock::now();
+		timing.direct = std::min(timing.direct, duration_cast<duration<double, std::nano>>(end - begin).count() / double(reps * NR_OPERANDS));
+		begin = steady_clock::now();
+		for (size_t r = 0; r < reps; ++r) {
+			for (size_t i = 0; i < NR_OPERANDS; ++i) convert(value<52>(x[i]), reference[i]);
+		}
+		end = steady_clock::now();
+		timing.reference = std::min(timing.reference, duration_cast<duration<double, std::nano>>(end - begin).count() / double(reps * NR_OPERANDS));
+	}
+	timing.match = (direct == reference);
+	return timing;
+}
+
+template<size_t nbits, size_t es>
+int ReportConversion(std::ostream& ostr, std::mt19937_64& eng) {
+	ConversionTiming timing = MeasureConversion<nbits, es>(eng);
+	std::string tag = "posit<" + std::to_string(nbits) + "," + std::to_string(es) + ">";
+	ostr << std::setw(14) << tag << std::fixed << std::setprecision(1)
+		<< std::setw(14) << timing.direct << std::setw(14) << timing.reference << std::setw(10) << timing.reference / timing.direct << 'x'
+		<< std::defaultfloat << (timing.match ? "" : "  FAIL: conversions differ") << std::endl;
+	return (timing.match ? 0 : 1);
+}
+
+// the value of the posit as the product of its fields, as computed before the direct conversion
+template<size_t nbits, size_t es>
+double FieldProduct(const sw::unum::posit<nbits, es>& p) {
+	using namespace sw::unum;
+	if (p.iszero()) return 0.0;
+	if (p.isnar()) return NAN;
+	constexpr size_t fbits = posit<nbits, es>::fbits;
+	bool sign;
+	regime<nbits, es> r;
+	exponent<nbits, es> e;
+	fraction<fbits> f;
+	decode(p.get(), sign, r, e, f);
+	return (sign ? -1.0 : 1.0) * r.value() * e.value() * (1.0 + f.value());
+}
+
+template<size_t nbits, size_t es>
+int ReportToDouble(std::ostream& ostr, std::mt19937_64& eng) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	constexpr size_t NR_OPERANDS = 1024;
+	std::uniform_real_distribution<double> distr(-1.0e6, 1.0e6);
+	std::vector< posit<nbits, es> > p(NR_OPERANDS);
+	for (auto& v : p) v = posit<nbits, es>(distr(eng)) / posit<nbits, es>(distr(eng));
+	std::vector<double> direct(NR_OPERANDS), product(NR_OPERANDS);
+	double direct_time = 1.0e30, product_time = 1.0e30;
+	const size_t reps = std::max(size_t(1), 64 / (1 + nbits / 64));
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (size_t r = 0; r < reps; ++r) {
+			for (size_t i = 0; i < NR_OPERANDS; ++i) direct[i] = double(p[i]);
+		}
+		steady_clock::time_point end = steady_clock::now();
+		direct_time = std::min(direct_time, duration_cast<duration<double, std::nano>>(end - begin).count() / double(reps * NR_OPERANDS));
+		begin = steady_clock::now();
+		for (size_t r = 0; r < reps; ++r) {
+			for (size_t i = 0; i < NR_OPERANDS; ++i) product[i] = FieldProduct(p[i]);
+		}
+		end = steady_clock::now();
+		product_time = std::min(product_time, duration_cast<duration<double, std::nano>>(end - begin).count() / double(reps * NR_OPERANDS));
+	}
+	// the field product rounds more than once when the posit has more fraction bits than a double
+	size_t differences = 0;
+	for (size_t i = 0; i < NR_OPERANDS; ++i) differences += (direct[i] != product[i]);
+	std::string tag = "posit<" + std::to_string(nbits) + "," + std::to_string(es) + ">";
+	ostr << std::setw(14) << tag << std::fixed << std::setprecision(1)
+		<< std::setw(14) << direct_time << std::setw(14) << product_time << std::setw(10) << product_time / direct_time << 'x'
+		<< std::defaultfloat << std::setw(14) << differences << std::endl;
+	return 0;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	std::mt19937_64 eng(0);
+	cout << "double to posit conversion (nanoseconds per conversion)" << endl;
+	cout << setw(14) << "type" << setw(14) << "direct" << setw(14) << "value<52>" << setw(11) << "speedup" << endl;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportConversion<  8, 0>(cout, eng);
+	nrOfFailedTestCases += ReportConversion< 16, 1>(cout, eng);
+	nrOfFailedTestCases += ReportConversion< 32, 2>(cout, eng);
+	nrOfFailedTestCases += ReportConversion< 64, 3>(cout, eng);
+	nrOfFailedTestCases += ReportConversion< 24, 5>(cout, eng);
+	nrOfFailedTestCases += ReportConversion<128, 4>(cout, eng);
+	nrOfFailedTestCases += ReportConversion<256, 5>(cout, eng);
+
+	cout << "\nposit to double conversion (nanoseconds per conversion)" << endl;
+	cout << setw(14) << "type" << setw(14) << "direct" << setw(14) << "fields" << setw(11) << "speedup" << setw(14) << "differences" << endl;
+	nrOfFailedTestCases += ReportToDouble<  8, 0>(cout, eng);
+	nrOfFailedTestCases += ReportToDouble< 16, 1>(cout, eng);
+	nrOfFailedTestCases += ReportToDouble< 32, 2>(cout, eng);
+	nrOfFailedTestCases += ReportToDouble< 64, 3>(cout, eng);
+	nrOfFailedTestCases += ReportToDouble< 24, 5>(cout, eng);
+	nrOfFailedTestCases += ReportToDouble<128, 4>(cout, eng);
+	nrOfFailedTestCases += ReportToDouble<256, 5>(cout, eng);
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,126 @@
+// limb_multiply.cpp: performance characterization of the multi-limb multipliers and their Karatsuba crossover
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <cstring>
+#include <algorithm>
+#include "../bitblock/limb_functions.hpp"
+
+// Time n-limb products with the Comba kernel and with one level of Karatsuba on top of limb_multiply.
+// The crossover is the smallest width from which Karatsuba is faster at every measured width;
+// BITBLOCK_KARATSUBA_THRESHOLD should be set close to it for the target machine.
+
+struct MultiplierTiming {
+	size_t limbs;
+	double comba;      // nanoseconds per product
+	double karatsuba;  // nanoseconds per product
+	bool   match;      // both kernels produce the same product
+};
+
+template<size_t n>
+MultiplierTiming MeasureMultiplier(std::mt19937_64& eng) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	constexpr size_t NR_OPERANDS = 16;
+	uint64_t a[NR_OPERANDS][n], b[NR_OPERANDS][n], r[2 * n], s[2 * n];
+	for (size_t k = 0; k < NR_OPERANDS; ++k) {
+		for (size_t i = 0; i < n; ++i) {
+			a[k][i] = eng();
+			b[k][i] = eng();
+		}
+	}
+	MultiplierTiming timing;
+	timing.limbs = n;
+	timing.match = true;
+	for (size_t k = 0; k < NR_OPERANDS; ++k) {
+		comba_multiply<n>(a[k], b[k], r);
+		karatsuba_multiply<n>(a[k], b[k], s);
+		timing.match &= (std::memcmp(r, s, sizeof(r)) == 0);
+	}
+
+	// scale the repetitions with the quadratic cost so that each width takes similar time,
+	// and keep the fastest of a few trials to suppress scheduling noise
+	const size_t reps = 1 + 4000000 / (n * n);
+	uint64_t checksum = 0;
+	timing.comba = timing.karatsuba = 1.0e30;
+	for (int trial = 0; trial < 5; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (size_t i = 0; i < reps; ++i) {
+			comba_multiply<n>(a[i % NR_OPERANDS], b[i % NR_OPERANDS], r);
+			checksum += r[n];
+		}
+		steady_clock::time_point end = steady_clock::now();
+		timing.comba = std::min(timing.comba, duration_cast<duration<double, std::nano>>(end - begin).count() / double(reps));
+		begin = steady_clock::now();
+		for (size_t i = 0; i < reps; ++i) {
+			karatsuba_multiply<n>(a[i % NR_OPERANDS], b[i % NR_OPERANDS], s);
+			checksum += s[n];
+		}
+		end = steady_clock::now();
+		timing.karatsuba = std::min(timing.karatsuba, duration_cast<duration<double, std::nano>>(end - begin).count() / double(reps));
+	}
+	if (checksum == 0) std::cout << ' ';   // keep the products alive
+	return timing;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	std::mt19937_64 eng(0);
+	MultiplierTiming timings[] = {
+		MeasureMultiplier<  2>(eng),
+		MeasureMultiplier<  4>(eng),
+		MeasureMultiplier<  8>(eng),
+		MeasureMultiplier< 12>(eng),
+		MeasureMultiplier< 16>(eng),
+		MeasureMultiplier< 24>(eng),
+		MeasureMultiplier< 32>(eng),
+		MeasureMultiplier< 48>(eng),
+		MeasureMultiplier< 64>(eng),
+		MeasureMultiplier< 96>(eng),
+		MeasureMultiplier<128>(eng),
+	};
+	constexpr size_t nrTimings = sizeof(timings) / sizeof(timings[0]);
+
+	cout << "Multi-limb multiplication: Comba versus one level of Karatsuba (threshold " << BITBLOCK_KARATSUBA_THRESHOLD << " limbs)" << endl;
+	cout << setw(8) << "limbs" << setw(8) << "bits" << setw(16) << "Comba ns" << setw(16) << "Karatsuba ns" << setw(10) << "ratio" << endl;
+	int nrOfFailedTestCases = 0;
+	size_t crossover = 0;
+	for (size_t i = 0; i < nrTimings; ++i) {
+		const MultiplierTiming& t = timings[i];
+		cout << setw(8) << t.limbs << setw(8) << 64 * t.limbs << fixed << setprecision(1) << setw(16) << t.comba << setw(16) << t.karatsuba
+			<< setprecision(2) << setw(10) << t.comba / t.karatsuba << (t.match ? "" : "  FAIL: products differ") << endl;
+		if (!t.match) ++nrOfFailedTestCases;
+		if (t.karatsuba < t.comba) {
+			if (crossover == 0) crossover = t.limbs;
+		}
+		else {
+			crossover = 0;
+		}
+	}
+	if (crossover) {
+		cout << "Karatsuba crossover: " << crossover << " limbs (" << 64 * crossover << " bits)" << endl;
+	}
+	else {
+		cout << "Karatsuba crossover: beyond " << timings[nrTimings - 1].limbs << " limbs" << endl;
+	}
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
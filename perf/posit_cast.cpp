@@ -0,0 +1,100 @@
+// posit_cast.cpp: performance characterization of the conversion between posit configurations
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <algorithm>
+#include "../posit/posit.hpp"
+#include "../posit/posit_cast.hpp"
+
+// Time posit_cast, which re-encodes the decoded posit in the target configuration, against the conversion
+// through a double and the conversion through a value<> that holds all fraction bits of the source.
+// The conversion through double rounds twice when the source has more fraction bits than a double.
+
+template<size_t tnbits, size_t tes, size_t nbits, size_t es>
+sw::unum::posit<tnbits, tes> ValueConversion(const sw::unum::posit<nbits, es>& p) {
+	using namespace sw::unum;
+	constexpr size_t fbits = posit<nbits, es>::fbits;
+	posit<tnbits, tes> t;
+	if (p.iszero()) return t.setzero(), t;
+	if (p.isnar()) return t.setnar(), t;
+	bool sign;
+	int scale;
+	bitblock<fbits> fraction;
+	decode<nbits, es>(p.get(), sign, scale, fraction);
+	return convert_<tnbits, tes, fbits>(sign, scale, fraction, t);
+}
+
+template<size_t tnbits, size_t tes, size_t nbits, size_t es>
+int ReportPositCast(std::ostream& ostr, std::mt19937_64& eng) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	constexpr size_t NR_OPERANDS = 1024;
+	std::uniform_real_distribution<double> distr(-1.0e6, 1.0e6);
+	std::vector< posit<nbits, es> > x(NR_OPERANDS);
+	for (auto& v : x) v = posit<nbits, es>(distr(eng)) / posit<nbits, es>(distr(eng));
+	std::vector< posit<tnbits, tes> > direct(NR_OPERANDS), through_double(NR_OPERANDS), through_value(NR_OPERANDS);
+	double direct_time = 1.0e30, double_time = 1.0e30, value_time = 1.0e30;
+	const size_t reps = std::max(size_t(1), 64 / (1 + std::max(nbits, tnbits) / 64));
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (size_t r = 0; r < reps; ++r) posit_cast(NR_OPERANDS, x.data(), 1, direct.data(), 1);
+		steady_clock::time_point end = steady_clock::now();
+		direct_time = std::min(direct_time, duration_cast<duration<double, std::nano>>(end - begin).count() / double(reps * NR_OPERANDS));
+		begin = steady_clock::now();
+		for (size_t r = 0; r < reps; ++r) {
+			for (size_t i = 0; i < NR_OPERANDS; ++i) through_double[i] = double(x[i]);
+		}
+		end = steady_clock::now();
+		double_time = std::min(double_time, duration_cast<duration<double, std::nano>>(end - begin).count() / double(reps * NR_OPERANDS));
+		begin = steady_clock::now();
+		for (size_t r = 0; r < reps; ++r) {
+			for (size_t i = 0; i < NR_OPERANDS; ++i) through_value[i] = ValueConversion<tnbits, tes>(x[i]);
+		}
+		end = steady_clock::now();
+		value_time = std::min(value_time, duration_cast<duration<double, std::nano>>(end - begin).count() / double(reps * NR_OPERANDS));
+	}
+	size_t differences = 0;
+	for (size_t i = 0; i < NR_OPERANDS; ++i) differences += (direct[i] != through_double[i]);
+	bool match = (direct == through_value);
+	std::string tag = "posit<" + std::to_string(nbits) + "," + std::to_string(es) + "> to posit<" + std::to_string(tnbits) + "," + std::to_string(tes) + ">";
+	ostr << std::setw(30) << tag << std::fixed << std::setprecision(1)
+		<< std::setw(12) << direct_time << std::setw(12) << double_time << std::setw(12) << value_time << std::setw(10) << value_time / direct_time << 'x'
+		<< std::defaultfloat << std::setw(14) << differences << (match ? "" : "  FAIL: posit_cast differs from value<>") << std::endl;
+	return (match ? 0 : 1);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	std::mt19937_64 eng(0);
+	cout << "posit to posit conversion (nanoseconds per conversion)" << endl;
+	cout << setw(30) << "conversion" << setw(12) << "posit_cast" << setw(12) << "double" << setw(12) << "value<>" << setw(11) << "speedup" << setw(14) << "differences" << endl;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportPositCast< 16, 1,  32, 2>(cout, eng);
+	nrOfFailedTestCases += ReportPositCast<  8, 0,  32, 2>(cout, eng);
+	nrOfFailedTestCases += ReportPositCast< 32, 2,  16, 1>(cout, eng);
+	nrOfFailedTestCases += ReportPositCast< 32, 2,  64, 3>(cout, eng);
+	nrOfFailedTestCases += ReportPositCast< 64, 3,  32, 2>(cout, eng);
+	nrOfFailedTestCases += ReportPositCast< 64, 3, 128, 4>(cout, eng);
+	nrOfFailedTestCases += ReportPositCast<128, 4, 256, 5>(cout, eng);
+	nrOfFailedTestCases += ReportPositCast<256, 5, 128, 4>(cout, eng);
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
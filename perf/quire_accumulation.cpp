@@ -0,0 +1,316 @@
+// quire_accumulation.cpp: performance characterization of fused dot products in the quire
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+// disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <posit>
+
+// Time the fused dot product of two vectors of posits: every product is accumulated exactly in the quire
+// and the sum is rounded once. The accumulation of the product into the limbs of the quire dominates the
+// products of small posits, the unrounded multiply takes over for the larger configurations.
+// The deferred quire accumulates the same products without propagating carries, and resolves them once at the end.
+// The native multiply-accumulate of the quire multiplies the significands of posits that fit in a machine word
+// into a 128-bit integer and adds it to the limbs, bypassing the value<> product.
+// The fdp kernels of posit<8,0> and posit<16,1> sum the products in fixed-point integer lanes, with AVX2 when
+// the processor supports it, and reduce the lanes into the quire once.
+// The concurrent quire lets many threads add products to one sum with atomic limbs instead of a lock.
+
+// sustained accumulation rate in millions of terms per second
+template<typename Accumulator, size_t nbits, size_t es>
+double MeasureFusedDot(const std::vector<sw::unum::posit<nbits, es> >& x, const std::vector<sw::unum::posit<nbits, es> >& y, int reps, sw::unum::posit<nbits, es>& result) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	const size_t n = x.size();
+	double elapsed = 1.0e30;
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (int r = 0; r < reps; ++r) {
+			Accumulator q;
+			for (size_t i = 0; i < n; ++i) q += quire_mul(x[i], y[i]);
+			convert(q.to_value(), result);
+		}
+		steady_clock::time_point end = steady_clock::now();
+		elapsed = std::min(elapsed, duration_cast<duration<double, std::micro>>(end - begin).count());
+	}
+	return double(n * reps) / elapsed;
+}
+
+template<size_t nbits, size_t es, size_t capacity>
+double MeasureNativeDot(const std::vector<sw::unum::posit<nbits, es> >& x, const std::vector<sw::unum::posit<nbits, es> >& y, int reps, sw::unum::posit<nbits, es>& result) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	const size_t n = x.size();
+	double elapsed = 1.0e30;
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (int r = 0; r < reps; ++r) {
+			quire<nbits, es, capacity> q;
+			for (size_t i = 0; i < n; ++i) q.add_product(x[i], y[i]);
+			convert(q.to_value(), result);
+		}
+		steady_clock::time_point end = steady_clock::now();
+		elapsed = std::min(elapsed, duration_cast<duration<double, std::micro>>(end - begin).count());
+	}
+	return double(n * reps) / elapsed;
+}
+
+// sustained rate of accumulating precomputed products, in millions of terms per second
+template<typename Accumulator, size_t mbits, size_t nbits, size_t es>
+double MeasureAccumulation(const std::vector<sw::unum::value<mbits> >& products, int reps, sw::unum::posit<nbits, es>& result) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	const size_t n = products.size();
+	double elapsed = 1.0e30;
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (int r = 0; r < reps; ++r) {
+			Accumulator q;
+			for (size_t i = 0; i < n; ++i) q += products[i];
+			convert(q.to_value(), result);
+		}
+		steady_clock::time_point end = steady_clock::now();
+		elapsed = std::min(elapsed, duration_cast<duration<double, std::micro>>(end - begin).count());
+	}
+	return double(n * reps) / elapsed;
+}
+
+template<size_t nbits, size_t es, size_t capacity = 30>
+int ReportAccumulation(std::ostream& ostr, const std::string& tag, size_t n, int reps) {
+	std::mt19937_64 eng(nbits);
+	std::uniform_real_distribution<double> distr(-1.0, 1.0);
+	std::vector<sw::unum::value<2 * (nbits - 2 - es)> > products(n);
+	for (size_t i = 0; i < n; ++i) products[i] = sw::unum::quire_mul(sw::unum::posit<nbits, es>(distr(eng)), sw::unum::posit<nbits, es>(distr(eng)));
+	sw::unum::posit<nbits, es> result, deferred_result;
+	double quire_rate = MeasureAccumulation<sw::unum::quire<nbits, es, capacity> >(products, reps, result);
+	double deferred_rate = MeasureAccumulation<sw::unum::deferred_quire<nbits, es, capacity> >(products, reps, deferred_result);
+	ostr << std::setw(14) << tag << std::setw(8) << sw::unum::quire<nbits, es, capacity>::qbits + 1
+		<< std::fixed << std::setprecision(1) << std::setw(14) << quire_rate << std::setw(14) << deferred_rate
+		<< std::setw(20) << std::setprecision(10) << result << (result == deferred_result ? "" : "  FAIL: results differ") << std::endl;
+	return (result == deferred_result ? 0 : 1);
+}
+
+template<size_t nbits, size_t es, size_t capacity = 30>
+int ReportFusedDot(std::ostream& ostr, const std::string& tag, size_t n, int reps) {
+	std::mt19937_64 eng(nbits);
+	std::uniform_real_distribution<double> distr(-1.0, 1.0);
+	std::vector<sw::unum::posit<nbits, es> > x(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = distr(eng);
+		y[i] = distr(eng);
+	}
+	sw::unum::posit<nbits, es> result, deferred_result, native_result;
+	double quire_rate = MeasureFusedDot<sw::unum::quire<nbits, es, capacity> >(x, y, reps, result);
+	double deferred_rate = MeasureFusedDot<sw::unum::deferred_quire<nbits, es, capacity> >(x, y, reps, deferred_result);
+	double native_rate = MeasureNativeDot<nbits, es, capacity>(x, y, reps, native_result);
+	bool match = (result == deferred_result) && (result == native_result);
+	ostr << std::setw(14) << tag << std::setw(8) << sw::unum::quire<nbits, es, capacity>::qbits + 1
+		<< std::fixed << std::setprecision(1) << std::setw(14) << quire_rate << std::setw(14) << deferred_rate << std::setw(14) << native_rate
+		<< std::setw(20) << std::setprecision(10) << result << (match ? "" : "  FAIL: results differ") << std::endl;
+	return (match ? 0 : 1);
+}
+
+// sustained rate of a dot product kernel on arrays of encodings, in millions of terms per second
+template<size_t nbits, size_t es, typename Kernel>
+double MeasureKernel(const Kernel& kernel, const std::vector<typename sw::unum::fdp_kernel<nbits, es>::encoding_type>& x, const std::vector<typename sw::unum::fdp_kernel<nbits, es>::encoding_type>& y, int reps, sw::unum::posit<nbits, es>& result) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	const size_t n = x.size();
+	double elapsed = 1.0e30;
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (int r = 0; r < reps; ++r) {
+			quire<nbits, es> q;
+			typename fdp_kernel<nbits, es>::lanes acc;
+			kernel(x.data(), y.data(), n, acc);
+			fdp_kernel<nbits, es>::reduce(acc, q);
+			convert(q.to_value(), result);
+		}
+		steady_clock::time_point end = steady_clock::now();
+		elapsed = std::min(elapsed, duration_cast<duration<double, std::micro>>(end - begin).count());
+	}
+	return double(n * reps) / elapsed;
+}
+
+// inference-style dot products of long vectors: the native multiply-accumulate of the quire,
+// the scalar and AVX2 kernels on the encodings, and fdp() on the vectors of posits
+template<size_t nbits, size_t es>
+int ReportKernelDot(std::ostream& ostr, const std::string& tag, size_t n, int reps) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	typedef fdp_kernel<nbits, es> Kernel;
+	typedef typename Kernel::encoding_type Encoding;
+	std::mt19937_64 eng(nbits);
+	std::uniform_real_distribution<double> distr(-1.0, 1.0);
+	std::vector<posit<nbits, es> > x(n), y(n);
+	std::vector<Encoding> xe(n), ye(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = distr(eng);
+		y[i] = distr(eng);
+		xe[i] = Encoding(x[i].encoding());
+		ye[i] = Encoding(y[i].encoding());
+	}
+	posit<nbits, es> result, scalar_result, avx2_result, fdp_result;
+	double native_rate = MeasureNativeDot<nbits, es, 30>(x, y, 1, result);
+	double scalar_rate = MeasureKernel<nbits, es>([](const Encoding* a, const Encoding* b, size_t len, typename Kernel::lanes& acc) { Kernel::dot_scalar(a, b, len, acc); }, xe, ye, reps, scalar_result);
+	double avx2_rate = 0.0;
+	avx2_result = scalar_result;
+#if POSIT_FDP_KERNELS_AVX2
+	if (cpu_supports_avx2()) avx2_rate = MeasureKernel<nbits, es>([](const Encoding* a, const Encoding* b, size_t len, typename Kernel::lanes& acc) { Kernel::dot_avx2(a, b, len, acc); }, xe, ye, reps, avx2_result);
+#endif
+	double elapsed = 1.0e30;
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (int r = 0; r < reps; ++r) fdp_result = fdp(x, y);
+		steady_clock::time_point end = steady_clock::now();
+		elapsed = std::min(elapsed, duration_cast<duration<double, std::micro>>(end - begin).count());
+	}
+	double fdp_rate = double(n * reps) / elapsed;
+	bool match = (result == scalar_result) && (result == avx2_result) && (result == fdp_result);
+	ostr << std::setw(14) << tag << std::setw(10) << n
+		<< std::fixed << std::setprecision(1) << std::setw(14) << native_rate << std::setw(14) << scalar_rate << std::setw(14) << avx2_rate << std::setw(14) << fdp_rate
+		<< std::setw(20) << std::setprecision(10) << result << (match ? "" : "  FAIL: results differ") << std::endl;
+	return (match ? 0 : 1);
+}
+
+// short sums of precomputed products in a large quire: with the products populating a narrow band of scales,
+// the cost of resetting, comparing, and converting the quire is set by that band, not by the width of the quire
+template<size_t nbits, size_t es, size_t capacity = 30>
+void ReportShortSums(std::ostream& ostr, const std::string& tag, size_t n, int reps) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	std::mt19937_64 eng(nbits);
+	std::uniform_real_distribution<double> distr(-1.0, 1.0);
+	std::vector<value<2 * (nbits - 2 - es)> > products(n);
+	for (size_t i = 0; i < n; ++i) products[i] = quire_mul(posit<nbits, es>(distr(eng)), posit<nbits, es>(distr(eng)));
+	posit<nbits, es> result;
+	quire<nbits, es, capacity> q, previous;
+	size_t nrOfEqualSums = 0;
+	double elapsed = 1.0e30;
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (int r = 0; r < reps; ++r) {
+			q.reset();
+			for (size_t i = 0; i < n; ++i) q += products[(i + r) % n];
+			if (q == previous) ++nrOfEqualSums;
+			convert(q.to_value(), result);
+			previous = q;
+		}
+		steady_clock::time_point end = steady_clock::now();
+		elapsed = std::min(elapsed, duration_cast<duration<double, std::nano>>(end - begin).count() / double(reps));
+	}
+	ostr << std::setw(14) << tag << std::setw(8) << quire<nbits, es, capacity>::qbits + 1
+		<< std::fixed << std::setprecision(1) << std::setw(14) << elapsed << std::setw(20) << std::setprecision(10) << result << std::endl;
+}
+
+// many producers adding products to one sum: a quire behind a mutex, the lock-free concurrent quire,
+// and private quires merged after the join, in millions of terms per second over all threads
+template<size_t nbits, size_t es, size_t capacity = 30>
+int ReportConcurrent(std::ostream& ostr, const std::string& tag, size_t n, size_t nrThreads) {
+	using namespace std::chrono;
+	using namespace sw::unum;
+	std::mt19937_64 eng(nbits);
+	std::uniform_real_distribution<double> distr(-1.0, 1.0);
+	std::vector<posit<nbits, es> > x(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = distr(eng);
+		y[i] = distr(eng);
+	}
+	// run the producers over interleaved slices and return the rate
+	auto measure = [&](const std::function<void(size_t)>& producer) {
+		steady_clock::time_point begin = steady_clock::now();
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < nrThreads; ++t) threads.push_back(std::thread(producer, t));
+		for (auto& thread : threads) thread.join();
+		steady_clock::time_point end = steady_clock::now();
+		return double(n) / duration_cast<duration<double, std::micro>>(end - begin).count();
+	};
+	quire<nbits, es, capacity> locked, merged;
+	std::mutex guard;
+	double locked_rate = measure([&](size_t t) {
+		for (size_t i = t; i < n; i += nrThreads) {
+			std::lock_guard<std::mutex> lock(guard);
+			locked.add_product(x[i], y[i]);
+		}
+	});
+	concurrent_quire<nbits, es, capacity> shared;
+	double concurrent_rate = measure([&](size_t t) {
+		for (size_t i = t; i < n; i += nrThreads) shared.add_product(x[i], y[i]);
+	});
+	double merged_rate = measure([&](size_t t) {
+		quire<nbits, es, capacity> partial;
+		for (size_t i = t; i < n; i += nrThreads) partial.add_product(x[i], y[i]);
+		std::lock_guard<std::mutex> lock(guard);
+		merged += partial;
+	});
+	bool match = (shared == locked) && (merged == locked);
+	posit<nbits, es> result;
+	convert(locked.to_value(), result);
+	ostr << std::setw(14) << tag << std::setw(10) << nrThreads
+		<< std::fixed << std::setprecision(1) << std::setw(14) << locked_rate << std::setw(14) << concurrent_rate << std::setw(14) << merged_rate
+		<< std::setw(20) << std::setprecision(10) << result << (match ? "" : "  FAIL: results differ") << std::endl;
+	return (match ? 0 : 1);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	constexpr size_t n = 4096;
+	constexpr int reps = 16;
+
+	cout << "Fused dot product in the quire (million terms per second)" << endl;
+	cout << setw(14) << "config" << setw(8) << "bits" << setw(14) << "quire" << setw(14) << "deferred" << setw(14) << "native" << setw(20) << "dot" << endl;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportFusedDot< 8, 0>(cout, "posit< 8,0>", n, reps);
+	nrOfFailedTestCases += ReportFusedDot<16, 1>(cout, "posit<16,1>", n, reps);
+	nrOfFailedTestCases += ReportFusedDot<32, 2>(cout, "posit<32,2>", n, reps);
+	nrOfFailedTestCases += ReportFusedDot<64, 3>(cout, "posit<64,3>", n, reps);
+
+	cout << "\nAccumulation of precomputed products (million terms per second)" << endl;
+	cout << setw(14) << "config" << setw(8) << "bits" << setw(14) << "quire" << setw(14) << "deferred" << setw(20) << "sum" << endl;
+	nrOfFailedTestCases += ReportAccumulation< 8, 0>(cout, "posit< 8,0>", n, reps);
+	nrOfFailedTestCases += ReportAccumulation<16, 1>(cout, "posit<16,1>", n, reps);
+	nrOfFailedTestCases += ReportAccumulation<32, 2>(cout, "posit<32,2>", n, reps);
+	nrOfFailedTestCases += ReportAccumulation<64, 3>(cout, "posit<64,3>", n, reps);
+
+	cout << "\nDot product kernels of long vectors (million terms per second, 0 when AVX2 is not available)" << endl;
+	cout << setw(14) << "config" << setw(10) << "n" << setw(14) << "native" << setw(14) << "scalar" << setw(14) << "avx2" << setw(14) << "fdp" << setw(20) << "dot" << endl;
+	nrOfFailedTestCases += ReportKernelDot< 8, 0>(cout, "posit< 8,0>", 1 << 20, 8);
+	nrOfFailedTestCases += ReportKernelDot<16, 1>(cout, "posit<16,1>", 1 << 20, 8);
+
+	cout << "\nSums of 16 precomputed products in a large quire (ns per sum, including reset, compare, and conversion)" << endl;
+	cout << setw(14) << "config" << setw(8) << "bits" << setw(14) << "sum" << setw(20) << "result" << endl;
+	ReportShortSums< 64, 3>(cout, "posit<64,3>", 16, 1024);
+	ReportShortSums<128, 4>(cout, "posit<128,4>", 16, 1024);
+	ReportShortSums<256, 5>(cout, "posit<256,5>", 16, 1024);
+
+	size_t nrThreads = std::max(4u, std::thread::hardware_concurrency());
+	cout << "\nConcurrent accumulation into one sum (million terms per second)" << endl;
+	cout << setw(14) << "config" << setw(10) << "threads" << setw(14) << "mutex" << setw(14) << "concurrent" << setw(14) << "merged" << setw(20) << "dot" << endl;
+	nrOfFailedTestCases += ReportConcurrent<16, 1>(cout, "posit<16,1>", 1 << 20, nrThreads);
+	nrOfFailedTestCases += ReportConcurrent<32, 2>(cout, "posit<32,2>", 1 << 20, nrThreads);
+	nrOfFailedTestCases += ReportConcurrent<64, 3>(cout, "posit<64,3>", 1 << 18, nrThreads);
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,116 @@
+// reproducible_dot.cpp: performance characterization of the reproducible IEEE sum, dot, and gemv operators
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <algorithm>
+#include <thread>
+#include "../posit/exceptions.hpp"
+#include "../bitblock/bitblock.hpp"
+#include "../posit/value.hpp"
+#include "../float/quire.hpp"
+#include "../float/reproducible.hpp"
+
+// Time the reproducible dot product of double and float vectors against the naive loop of the hardware.
+// Every product is added exactly to the limbs of the quire of the IEEE type, the threads accumulate
+// private quires that are merged exactly, and the result is rounded once: it does not change with the number of threads.
+
+// sustained rate of a dot product in millions of terms per second
+template<typename Real, typename Dot>
+double MeasureDot(const Dot& dot, size_t n, int reps, Real& result) {
+	using namespace std::chrono;
+	volatile Real sink = 0;
+	double elapsed = 1.0e30;
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (int r = 0; r < reps; ++r) sink = dot();
+		steady_clock::time_point end = steady_clock::now();
+		elapsed = std::min(elapsed, duration_cast<duration<double, std::micro>>(end - begin).count());
+	}
+	result = sink;
+	return double(n * reps) / elapsed;
+}
+
+template<typename Real>
+int ReportDot(std::ostream& ostr, const std::string& tag, size_t n, int reps, size_t nrThreads) {
+	using namespace sw::ieee;
+	std::mt19937_64 eng(n);
+	std::uniform_real_distribution<Real> distr(-1.0, 1.0);
+	std::vector<Real> x(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = distr(eng);
+		y[i] = distr(eng);
+	}
+	Real naive_result, serial_result, parallel_result;
+	const Real* volatile px = x.data();   // keep the compiler from hoisting the naive loop out of the repetitions
+	double naive_rate = MeasureDot([&]() {
+		const Real* xp = px;
+		Real sum = 0;
+		for (size_t i = 0; i < n; ++i) sum += xp[i] * y[i];
+		return sum;
+	}, n, reps, naive_result);
+	double serial_rate = MeasureDot([&]() { return reproducible_dot(x, y); }, n, reps, serial_result);
+	double parallel_rate = MeasureDot([&]() { return reproducible_dot(x, y, nrThreads); }, n, reps, parallel_result);
+	bool match = (serial_result == parallel_result);
+	ostr << std::setw(10) << tag << std::setw(10) << n
+		<< std::fixed << std::setprecision(1) << std::setw(14) << naive_rate << std::setw(14) << serial_rate << std::setw(14) << parallel_rate
+		<< std::setw(26) << std::setprecision(std::numeric_limits<Real>::max_digits10) << std::scientific << serial_result << std::defaultfloat
+		<< (match ? "" : "  FAIL: results differ") << std::endl;
+	return (match ? 0 : 1);
+}
+
+// y = A * x of a square matrix, one correctly rounded dot product per row, in millions of terms per second
+int ReportGemv(std::ostream& ostr, size_t m, int reps, size_t nrThreads) {
+	using namespace sw::ieee;
+	std::mt19937_64 eng(m);
+	std::uniform_real_distribution<double> distr(-1.0, 1.0);
+	std::vector<double> A(m * m), x(m), y1(m), yp(m);
+	for (auto& a : A) a = distr(eng);
+	for (auto& v : x) v = distr(eng);
+	double dummy;
+	double serial_rate = MeasureDot([&]() { reproducible_gemv(m, m, A.data(), m, x.data(), 1, 0.0, y1.data(), 1); return y1[0]; }, m * m, reps, dummy);
+	double parallel_rate = MeasureDot([&]() { reproducible_gemv(m, m, A.data(), m, x.data(), 1, 0.0, yp.data(), 1, nrThreads); return yp[0]; }, m * m, reps, dummy);
+	bool match = (y1 == yp);
+	ostr << std::setw(10) << "gemv" << std::setw(10) << m
+		<< std::fixed << std::setprecision(1) << std::setw(14) << serial_rate << std::setw(14) << parallel_rate << std::defaultfloat
+		<< (match ? "" : "  FAIL: results differ") << std::endl;
+	return (match ? 0 : 1);
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+
+	size_t nrThreads = std::max(2u, std::thread::hardware_concurrency());
+
+	cout << "Reproducible dot products (million terms per second, " << nrThreads << " threads)" << endl;
+	cout << setw(10) << "type" << setw(10) << "n" << setw(14) << "naive" << setw(14) << "serial" << setw(14) << "parallel" << setw(26) << "dot" << endl;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportDot<float>(cout, "float", 1 << 20, 4, nrThreads);
+	nrOfFailedTestCases += ReportDot<double>(cout, "double", 1 << 20, 4, nrThreads);
+
+	cout << "\nReproducible matrix-vector product (million terms per second)" << endl;
+	cout << setw(10) << "operator" << setw(10) << "m = n" << setw(14) << "serial" << setw(14) << "parallel" << endl;
+	nrOfFailedTestCases += ReportGemv(cout, 512, 4, nrThreads);
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
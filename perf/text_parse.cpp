@@ -0,0 +1,137 @@
+// text_parse.cpp: performance characterization of the conversion of text to posits
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <regex>
+#include <sstream>
+#include <cstdlib>
+#include "../posit/posit.hpp"
+
+// Time from_chars, which scans decimal and posit format text without allocating and rounds once, against
+// the regex and istringstream parser it replaced and against strtod followed by the double to posit conversion.
+// The routes through double round twice and report how many of the decimal strings end up on a different posit.
+
+// the parser before from_chars: a regex match for the posit format, an istringstream for everything else
+template<size_t nbits, size_t es>
+bool RegexParse(const std::string& txt, sw::unum::posit<nbits, es>& p) {
+	std::regex posit_regex("[\\d]+\\.[012345][xX][\\w]+[p]*");
+	if (std::regex_match(txt, posit_regex)) {
+		std::string nbitsStr, bitStr;
+		auto it = txt.begin();
+		for (; it != txt.end() && *it != '.'; ++it) nbitsStr.append(1, *it);
+		for (++it; it != txt.end() && *it != 'x' && *it != 'X'; ++it);
+		for (++it; it != txt.end() && *it != 'p'; ++it) bitStr.append(1, *it);
+		size_t nbits_in = nbits;
+		{
+			std::istringstream ss(nbitsStr);
+			ss >> nbits_in;
+		}
+		unsigned long long raw;
+		std::istringstream ss(bitStr);
+		ss >> std::hex >> raw;
+		if (nbits < nbits_in) raw >>= (nbits_in - nbits);
+		p.set_raw_bits(raw);
+		return true;
+	}
+	std::istringstream ss(txt);
+	double d;
+	ss >> d;
+	p = d;
+	return true;
+}
+
+template<typename Parser>
+double TimeParser(const std::vector<std::string>& txt, std::vector<double>& unused, Parser parse) {
+	using namespace std::chrono;
+	double elapsed = 1.0e30;
+	for (int trial = 0; trial < 3; ++trial) {
+		steady_clock::time_point begin = steady_clock::now();
+		for (size_t i = 0; i < txt.size(); ++i) unused[i] = parse(txt[i]);
+		steady_clock::time_point end = steady_clock::now();
+		elapsed = std::min(elapsed, duration_cast<duration<double, std::nano>>(end - begin).count() / double(txt.size()));
+	}
+	return elapsed;
+}
+
+template<size_t nbits, size_t es>
+void ReportTextParse(std::ostream& ostr, const std::string& label, const std::vector<std::string>& txt) {
+	using namespace sw::unum;
+	using Posit = posit<nbits, es>;
+	std::vector<Posit> direct(txt.size()), through_double(txt.size());
+	std::vector<double> unused(txt.size());
+	size_t i = 0;
+	double direct_time = TimeParser(txt, unused, [&](const std::string& s) {
+		Posit& p = direct[i++ % txt.size()];
+		from_chars(s.data(), s.data() + s.size(), p);
+		return double(p);
+	});
+	double strtod_time = TimeParser(txt, unused, [&](const std::string& s) {
+		Posit& p = through_double[i++ % txt.size()];
+		p = std::strtod(s.c_str(), nullptr);
+		return double(p);
+	});
+	double regex_time = TimeParser(txt, unused, [&](const std::string& s) {
+		Posit p;
+		RegexParse(s, p);
+		return double(p);
+	});
+	// strtod reads the posit format only up to the x
+	std::string differences = "-";
+	if (label != "posit format") {
+		size_t count = 0;
+		for (size_t j = 0; j < txt.size(); ++j) count += (direct[j] != through_double[j]);
+		differences = std::to_string(count);
+	}
+	std::string tag = "posit<" + std::to_string(nbits) + "," + std::to_string(es) + "> " + label;
+	ostr << std::setw(30) << tag << std::fixed << std::setprecision(1)
+		<< std::setw(12) << direct_time << std::setw(12) << strtod_time << std::setw(12) << regex_time << std::setw(10) << regex_time / direct_time << 'x'
+		<< std::setw(14) << differences << std::endl;
+}
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	constexpr size_t NR_STRINGS = 4096;
+	std::mt19937_64 eng(0);
+	std::uniform_real_distribution<double> distr(-1.0e6, 1.0e6);
+	std::uniform_int_distribution<int> exponent(-30, 30);
+	vector<string> short_decimals, long_decimals, posit_formats;
+	char buffer[64];
+	for (size_t i = 0; i < NR_STRINGS; ++i) {
+		double v = distr(eng) * std::pow(10.0, exponent(eng));
+		snprintf(buffer, sizeof(buffer), "%.7g", v);
+		short_decimals.push_back(buffer);
+		snprintf(buffer, sizeof(buffer), "%.20e", v);
+		long_decimals.push_back(buffer);
+		posit_formats.push_back(posit_format(posit<32, 2>(v)));
+	}
+
+	cout << "text to posit conversion (nanoseconds per conversion)" << endl;
+	cout << setw(30) << "conversion" << setw(12) << "from_chars" << setw(12) << "strtod" << setw(12) << "regex" << setw(11) << "speedup" << setw(14) << "differences" << endl;
+	ReportTextParse<32, 2>(cout, "7 digits", short_decimals);
+	ReportTextParse<32, 2>(cout, "21 digits", long_decimals);
+	ReportTextParse<32, 2>(cout, "posit format", posit_formats);
+	ReportTextParse<64, 3>(cout, "7 digits", short_decimals);
+	ReportTextParse<64, 3>(cout, "21 digits", long_decimals);
+	ReportTextParse<16, 1>(cout, "21 digits", long_decimals);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -5,10 +5,22 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
+#include <bitset>
 #include <sstream>
 #include <iomanip>
 #include <limits>
 #include <cmath>    // for frexpf/frexp/frexpl  float/double/long double fraction/exponent extraction
+#include <cstdint>
+#include <cstring>  // memcpy for the bit patterns of IEEE values
+#include "../bitblock/limb_functions.hpp"
+
+// enable/disable the conversion of IEEE float, double, and long double to posits directly from their bit pattern
+// when set, posit assignment from a native floating point type decodes the IEEE fields with integer instructions
+// instead of constructing a value<> with frexp
+#if !defined(POSIT_FAST_IEEE_CONVERSION)
+// default is to enable it
+#define POSIT_FAST_IEEE_CONVERSION 1
+#endif
 
 // This file contains functions that DO NOT use the posit type.
 // If you have helpers that use the posit type, add them to the file posit_manipulators.hpp
@@ -110,6 +122,207 @@ namespace sw {
 			}
 		}
 
+		// ieee_decoder decodes the bit pattern of an IEEE-754 value into a sign, a scale, and a 128-bit significand hi.lo
+		// with the hidden bit at bit 63 of hi. It classifies the value with the FP_ZERO, FP_NORMAL, FP_SUBNORMAL,
+		// FP_INFINITE, and FP_NAN categories of std::fpclassify, and normalizes subnormals.
+		// The layout is selected by the number of significand digits of the type; long double formats other than
+		// the IEEE double, the x87 80-bit extended, and the IEEE binary128 formats are not decoded (enabled = false).
+		inline void ieee_normalize(uint64_t hi, uint64_t lo, int exponent, int& scale, uint64_t& shi, uint64_t& slo) {
+			// normalize the integer hi.lo * 2^exponent, which is not zero
+			if (hi == 0) {
+				hi = lo;
+				lo = 0;
+				exponent -= 64;
+			}
+			int n = nlz(hi);
+			shi = (n ? (hi << n) | (lo >> (64 - n)) : hi);
+			slo = lo << n;
+			scale = exponent + 127 - n;
+		}
+
+		template<typename Real, int digits = std::numeric_limits<Real>::digits>
+		struct ieee_decoder {
+			static constexpr bool enabled = false;
+			static int decode(Real, bool&, int&, uint64_t&, uint64_t&) { return FP_NAN; }
+		};
+		// IEEE single precision
+		template<typename Real>
+		struct ieee_decoder<Real, 24> {
+			static constexpr bool enabled = (sizeof(Real) == 4);
+			static int decode(Real x, bool& sign, int& scale, uint64_t& hi, uint64_t& lo) {
+				uint32_t bits;
+				std::memcpy(&bits, &x, sizeof(bits));
+				sign = (bits >> 31) != 0;
+				int biased = int((bits >> 23) & 0xFF);
+				uint64_t fraction = bits & 0x007FFFFF;
+				if (biased == 0xFF) return (fraction ? FP_NAN : FP_INFINITE);
+				if (biased == 0 && fraction == 0) return FP_ZERO;
+				uint64_t m = (biased ? fraction | (uint64_t(1) << 23) : fraction);
+				ieee_normalize(0, m, (biased ? biased : 1) - 150, scale, hi, lo);
+				return (biased ? FP_NORMAL : FP_SUBNORMAL);
+			}
+		};
+		// IEEE double precision
+		template<typename Real>
+		struct ieee_decoder<Real, 53> {
+			static constexpr bool enabled = (sizeof(Real) == 8);
+			static int decode(Real x, bool& sign, int& scale, uint64_t& hi, uint64_t& lo) {
+				uint64_t bits;
+				std::memcpy(&bits, &x, sizeof(bits));
+				sign = (bits >> 63) != 0;
+				int biased = int((bits >> 52) & 0x7FF);
+				uint64_t fraction = bits & 0x000FFFFFFFFFFFFFull;
+				if (biased == 0x7FF) return (fraction ? FP_NAN : FP_INFINITE);
+				if (biased == 0 && fraction == 0) return FP_ZERO;
+				uint64_t m = (biased ? fraction | (uint64_t(1) << 52) : fraction);
+				ieee_normalize(0, m, (biased ? biased : 1) - 1075, scale, hi, lo);
+				return (biased ? FP_NORMAL : FP_SUBNORMAL);
+			}
+		};
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+		// x87 80-bit extended precision: a 64-bit significand with an explicit integer bit, then sign and exponent
+		template<typename Real>
+		struct ieee_decoder<Real, 64> {
+			static constexpr bool enabled = (sizeof(Real) >= 10);
+			static int decode(Real x, bool& sign, int& scale, uint64_t& hi, uint64_t& lo) {
+				uint64_t m;
+				uint16_t se;
+				std::memcpy(&m, &x, sizeof(m));
+				std::memcpy(&se, reinterpret_cast<const char*>(&x) + 8, sizeof(se));
+				sign = (se >> 15) != 0;
+				int biased = int(se & 0x7FFF);
+				if (biased == 0x7FFF) return ((m << 1) ? FP_NAN : FP_INFINITE);
+				if (m == 0) return FP_ZERO;
+				ieee_normalize(0, m, (biased ? biased : 1) - 16446, scale, hi, lo);
+				return (m >> 63 ? FP_NORMAL : FP_SUBNORMAL);
+			}
+		};
+		// IEEE quadruple precision
+		template<typename Real>
+		struct ieee_decoder<Real, 113> {
+			static constexpr bool enabled = (sizeof(Real) == 16);
+			static int decode(Real x, bool& sign, int& scale, uint64_t& hi, uint64_t& lo) {
+				uint64_t word[2];
+				std::memcpy(word, &x, sizeof(word));
+				sign = (word[1] >> 63) != 0;
+				int biased = int((word[1] >> 48) & 0x7FFF);
+				uint64_t fhi = word[1] & 0x0000FFFFFFFFFFFFull, flo = word[0];
+				if (biased == 0x7FFF) return ((fhi | flo) ? FP_NAN : FP_INFINITE);
+				if (biased == 0 && (fhi | flo) == 0) return FP_ZERO;
+				if (biased) fhi |= uint64_t(1) << 48;
+				ieee_normalize(fhi, flo, (biased ? biased : 1) - 16495, scale, hi, lo);
+				return (biased ? FP_NORMAL : FP_SUBNORMAL);
+			}
+		};
+#endif
+
+		// ieee_encoder assembles the bit pattern of an IEEE-754 value from a sign, a scale, and a 128-bit significand hi.lo
+		// with the hidden bit at bit 63 of hi, plus a sticky bit for the nonzero bits below lo. The significand is rounded once,
+		// with round-to-nearest-even, to the precision of the type, or of its subnormals, and values beyond
+		// the largest finite value become infinities. The formats are selected as for the ieee_decoder.
+		template<int digits, int min_exponent>
+		inline uint64_t ieee_round(int scale, uint64_t significand, bool sticky) {
+			// the unsigned bit pattern of a format with a hidden bit: a carry out of the rounded significand
+			// increments the exponent field, which also rounds the largest subnormal to the smallest normal
+			// and the largest finite value to infinity
+			constexpr int max_exponent = 1 - min_exponent;
+			if (scale > max_exponent) return uint64_t(max_exponent - min_exponent + 2) << (digits - 1);
+			int shift = 64 - digits + (scale < min_exponent ? min_exponent - scale : 0);
+			if (shift > 64) return 0;   // below half the smallest subnormal
+			uint64_t m = (shift < 64 ? significand >> shift : 0);
+			uint64_t rest = significand << (64 - shift);
+			if ((rest >> 63) && (sticky || (rest << 1) || (m & 1))) ++m;
+			return (scale >= min_exponent ? uint64_t(scale - min_exponent) << (digits - 1) : 0) + m;
+		}
+
+		template<typename Real, int digits = std::numeric_limits<Real>::digits>
+		struct ieee_encoder {
+			static constexpr bool enabled = false;
+			static Real encode(bool, int, uint64_t, uint64_t, bool) { return Real(0); }
+		};
+		// IEEE single precision
+		template<typename Real>
+		struct ieee_encoder<Real, 24> {
+			static constexpr bool enabled = (sizeof(Real) == 4);
+			static Real encode(bool sign, int scale, uint64_t hi, uint64_t lo, bool sticky) {
+				uint32_t bits = uint32_t(ieee_round<24, -126>(scale, hi, lo != 0 || sticky)) | (sign ? 0x80000000u : 0u);
+				Real x;
+				std::memcpy(&x, &bits, sizeof(bits));
+				return x;
+			}
+		};
+		// IEEE double precision
+		template<typename Real>
+		struct ieee_encoder<Real, 53> {
+			static constexpr bool enabled = (sizeof(Real) == 8);
+			static Real encode(bool sign, int scale, uint64_t hi, uint64_t lo, bool sticky) {
+				uint64_t bits = ieee_round<53, -1022>(scale, hi, lo != 0 || sticky) | (sign ? uint64_t(1) << 63 : 0);
+				Real x;
+				std::memcpy(&x, &bits, sizeof(bits));
+				return x;
+			}
+		};
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+		// x87 80-bit extended precision: the explicit integer bit holds the hidden bit, so a normal value keeps all of hi
+		// and rounds on the guard bit at the top of lo, and a subnormal rounds on the bits of hi shifted out
+		template<typename Real>
+		struct ieee_encoder<Real, 64> {
+			static constexpr bool enabled = (sizeof(Real) >= 10);
+			static Real encode(bool sign, int scale, uint64_t hi, uint64_t lo, bool sticky) {
+				uint64_t m = hi;
+				int biased = scale + 16383;
+				bool guard = (lo >> 63) != 0;
+				bool rest = (lo << 1) != 0 || sticky;
+				if (biased <= 0) {
+					int shift = 1 - biased;
+					guard = (shift <= 64 && ((hi >> (shift - 1)) & 1));
+					rest = (shift > 1 && (shift > 65 || (hi << (65 - shift)) != 0)) || lo != 0 || sticky;
+					m = (shift < 64 ? hi >> shift : 0);
+					biased = 0;
+				}
+				if (guard && (rest || (m & 1))) {
+					if (++m == 0) {
+						// the significand carried out: 2^64 is the integer bit of the next binade
+						m = uint64_t(1) << 63;
+						++biased;
+					}
+					else if (biased == 0 && (m >> 63)) {
+						biased = 1;   // rounded up to the smallest normal
+					}
+				}
+				if (biased >= 0x7FFF) {
+					m = uint64_t(1) << 63;
+					biased = 0x7FFF;
+				}
+				uint16_t se = uint16_t(biased) | (sign ? 0x8000 : 0);
+				Real x = Real(0);
+				std::memcpy(&x, &m, sizeof(m));
+				std::memcpy(reinterpret_cast<char*>(&x) + 8, &se, sizeof(se));
+				return x;
+			}
+		};
+#endif
+
+		// the integer part of (-1)^sign * hi.lo * 2^(scale - 127), a 128-bit significand with the hidden bit at bit 63 of hi,
+		// truncated toward zero as the conversion of a floating-point value to an integer is. Values beyond the range
+		// of Integer saturate to its minimum or maximum, and negative values of unsigned integers to zero.
+		// Magnitude is the unsigned integer of the width of Integer.
+		template<typename Integer, typename Magnitude>
+		inline Integer truncate_to_integer(bool sign, int scale, uint64_t hi, uint64_t lo) {
+			if (scale < 0) return Integer(0);
+			if (sign && !std::numeric_limits<Integer>::is_signed) return Integer(0);
+			if (scale >= std::numeric_limits<Integer>::digits) return (sign ? std::numeric_limits<Integer>::min() : std::numeric_limits<Integer>::max());
+			constexpr bool wide = (std::numeric_limits<Magnitude>::digits > 64);
+			Magnitude magnitude;
+			if (wide) {
+				magnitude = ((Magnitude(hi) << (wide ? 64 : 0)) | lo) >> (127 - scale);
+			}
+			else {
+				magnitude = Magnitude(hi >> (63 - scale));
+			}
+			return Integer(sign ? Magnitude(0) - magnitude : magnitude);
+		}
+
 		// representation helpers
 
 		// nbits binary representation of a signed 64-bit number
@@ -0,0 +1,217 @@
+#pragma once
+// concurrent_quire.hpp: a quire that many threads can accumulate into concurrently
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <atomic>
+
+namespace sw {
+	namespace unum {
+
+/*
+ concurrent_quire: accumulation mode of the quire<nbits,es,capacity> for a single sum fed by many producer threads.
+
+ Like the deferred quire, the accumulator is a two's complement integer in 64-bit limbs with a signed counter
+ per limb for the carries and borrows that leave the limb below it, but every limb and counter is a std::atomic.
+ An addend is added to, or subtracted from, each limb it covers with a single fetch_add or fetch_sub, and a carry
+ or borrow out of that limb increments or decrements the counter of the next limb. These updates commute,
+ so concurrent addends need no lock and no compare-and-swap loop, and no bit of any addend is lost.
+ To keep producers from contending for the same cache lines, the accumulator is replicated in a number of stripes,
+ and every thread adds to the stripe it is assigned on its first addend.
+
+ The stripes and counters are resolved into a normalized quire when the concurrent quire is read, converted,
+ or compared. A read is exact once the producers that were adding to it have been joined. The resolved quire
+ is bit-identical to the quire that accumulated the same addends sequentially, in any order, as long as
+ the sum stays within the capacity of the quire.
+
+     concurrent_quire<32, 2> cq;
+     // from any number of threads
+     cq += quire_mul(x[i], y[i]);
+     cq.add_product(x[j], y[j]);
+     // after joining the threads
+     posit<32, 2> dot;
+     convert(cq.to_value(), dot);
+ */
+template<size_t nbits, size_t es, size_t capacity = 30>
+class concurrent_quire {
+public:
+	typedef quire<nbits, es, capacity> Quire;
+	static constexpr size_t half_range = Quire::half_range;
+	static constexpr size_t qbits = Quire::qbits;
+	static constexpr size_t qlimbs = Quire::qlimbs;
+	static constexpr size_t nr_stripes = 16;
+
+	concurrent_quire() { reset(); }
+	concurrent_quire(const Quire& q) { reset(); *this += q; }
+	concurrent_quire(const concurrent_quire&) = delete;
+	concurrent_quire& operator=(const concurrent_quire&) = delete;
+
+	// add a normalized value: the addend is added to or subtracted from the limbs it covers
+	template<size_t fbits>
+	concurrent_quire& operator+=(const value<fbits>& rhs) {
+		accumulate(rhs, rhs.sign());
+		return *this;
+	}
+	template<size_t fbits>
+	concurrent_quire& operator-=(const value<fbits>& rhs) {
+		accumulate(rhs, !rhs.sign());
+		return *this;
+	}
+	concurrent_quire& operator+=(const posit<nbits, es>& rhs) {
+		if (rhs.iszero()) return *this;
+		return operator+=(quire_value(rhs));
+	}
+	concurrent_quire& operator-=(const posit<nbits, es>& rhs) {
+		if (rhs.iszero()) return *this;
+		return operator-=(quire_value(rhs));
+	}
+	// add a quire, for instance the partial sum of a producer, limb by limb
+	concurrent_quire& operator+=(const Quire& q) {
+		merge(q, false);
+		return *this;
+	}
+	concurrent_quire& operator-=(const Quire& q) {
+		merge(q, true);
+		return *this;
+	}
+
+	// accumulate the exact product a*b, multiplying the significands natively when the configuration allows it
+	concurrent_quire& add_product(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		accumulate_product(a, b, false);
+		return *this;
+	}
+	concurrent_quire& subtract_product(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		accumulate_product(a, b, true);
+		return *this;
+	}
+
+	// reset the accumulator: not safe while producers are adding to it
+	void reset() {
+		for (size_t s = 0; s < nr_stripes; ++s) {
+			for (size_t i = 0; i < qlimbs; ++i) _stripe[s].limb[i].store(0, std::memory_order_relaxed);
+			for (size_t i = 0; i <= qlimbs; ++i) _stripe[s].pending[i].store(0, std::memory_order_relaxed);
+		}
+	}
+	void clear() { reset(); }
+
+	// sum the stripes, propagate the deferred carries and borrows, and return the normalized quire
+	Quire resolve() const {
+		uint64_t limb[qlimbs];
+		int64_t pending[qlimbs + 1];
+		for (size_t i = 0; i < qlimbs; ++i) limb[i] = 0;
+		for (size_t i = 0; i <= qlimbs; ++i) pending[i] = 0;
+		for (size_t s = 0; s < nr_stripes; ++s) {
+			uint64_t carry = 0;
+			for (size_t i = 0; i < qlimbs; ++i) limb[i] = addcarry(limb[i], _stripe[s].limb[i].load(std::memory_order_relaxed), carry);
+			for (size_t i = 0; i <= qlimbs; ++i) pending[i] += _stripe[s].pending[i].load(std::memory_order_relaxed);
+			pending[qlimbs] += int64_t(carry);
+		}
+		Quire q;
+		int64_t carry = 0;
+		for (size_t i = 0; i < qlimbs; ++i) {
+			// add the signed counter, sign extended to two limbs, to the limb
+			int64_t c = pending[i] + carry;
+			uint64_t sum = limb[i] + uint64_t(c);
+			carry = (c < 0 ? -1 : 0) + (sum < limb[i] ? 1 : 0);
+			q._limb[i] = sum;
+		}
+		carry += pending[qlimbs];
+		if (carry < 0) {
+			// the sum is negative: the quire holds its magnitude
+			uint64_t borrow = 0;
+			for (size_t i = 0; i < qlimbs; ++i) q._limb[i] = subborrow(0, q._limb[i], borrow);
+			q._sign = true;
+		}
+		q._limb[qlimbs - 1] &= Quire::top_mask;   // carries out of the capacity segment are lost
+		q._first = 0;
+		q._last = qlimbs - 1;
+		q.trim();
+		if (q.iszero()) q._sign = false;
+		return q;
+	}
+
+	value<qbits> to_value() const { return resolve().to_value(); }
+	bool iszero() const { return resolve().iszero(); }
+	bool sign() const { return resolve().sign(); }
+
+private:
+	// a replica of the accumulator on its own cache lines
+	struct alignas(64) stripe {
+		std::atomic<uint64_t> limb[qlimbs];         // two's complement sum of the addends, without the carries below
+		std::atomic<int64_t>  pending[qlimbs + 1];  // carries minus borrows that left limb i-1, to be added at limb i
+	};
+	stripe _stripe[nr_stripes];
+
+	// the stripe of the calling thread: threads are assigned to the stripes round-robin
+	stripe& local_stripe() {
+		static std::atomic<size_t> next_stripe(0);
+		thread_local size_t index = next_stripe.fetch_add(1, std::memory_order_relaxed) % nr_stripes;
+		return _stripe[index];
+	}
+
+	// add or subtract the significand word(pos) with its lsb at quire bit lsb and its msb in limb last
+	template<typename Significand>
+	void accumulate(bool negative, const Significand& word, long long lsb, size_t last) {
+		stripe& s = local_stripe();
+		size_t first = (lsb > 0 ? size_t(lsb) / 64 : 0);
+		for (size_t i = first; i <= last; ++i) {
+			uint64_t w = word((long long)(64 * i) - lsb);
+			if (w == 0) continue;
+			if (negative) {
+				uint64_t previous = s.limb[i].fetch_sub(w, std::memory_order_relaxed);
+				if (previous < w) s.pending[i + 1].fetch_sub(1, std::memory_order_relaxed);
+			}
+			else {
+				uint64_t previous = s.limb[i].fetch_add(w, std::memory_order_relaxed);
+				if (previous + w < previous) s.pending[i + 1].fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+	template<size_t fbits>
+	void accumulate(const value<fbits>& v, bool negative) {
+		if (v.iszero()) return;
+		if (v.isinf() || v.isnan()) throw operand_is_nar{};
+		if (v.scale() > int(half_range)) throw operand_too_large_for_quire{};
+		if (v.scale() < -int(half_range)) throw operand_too_small_for_quire{};
+		long long lsb = (long long)half_range + v.scale() - (long long)fbits;   // quire position of the lsb of the significand
+		bitblock<fbits> fraction = v.fraction();
+		accumulate(negative, [&fraction](long long pos) { return Quire::significand_word(fraction, pos); }, lsb, size_t((long long)half_range + v.scale()) / 64);
+	}
+	void accumulate_product(const posit<nbits, es>& a, const posit<nbits, es>& b, bool negate) {
+		if (a.isnar() || b.isnar()) throw operand_is_nar{};
+		if (a.iszero() || b.iszero()) return;
+#if POSIT_FAST_NATIVE_ARITHMETIC
+		if (native_arithmetic<nbits, es>::enabled) {
+			bool sign;
+			int scale;
+			uint64_t hi, lo;
+			native_arithmetic<nbits, es>::product(a.encoding(), b.encoding(), sign, scale, hi, lo);
+			if (scale > int(half_range)) throw operand_too_large_for_quire{};
+			if (scale < -int(half_range)) throw operand_too_small_for_quire{};
+			long long lsb = (long long)half_range + scale - 127;   // the product has its hidden bit at bit 127
+			accumulate(sign != negate, [hi, lo](long long pos) { return Quire::wide_word(hi, lo, pos); }, lsb, size_t((long long)half_range + scale) / 64);
+			return;
+		}
+#endif
+		if (negate) operator-=(quire_mul(a, b)); else operator+=(quire_mul(a, b));
+	}
+	void merge(const Quire& q, bool negate) {
+		if (q.iszero()) return;
+		accumulate(q._sign != negate, [&q](long long pos) { return q._limb[q._first + size_t(pos) / 64]; }, (long long)(64 * q._first), q._last);
+	}
+};
+
+template<size_t nbits, size_t es, size_t capacity>
+inline bool operator==(const concurrent_quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs.resolve() == rhs; }
+template<size_t nbits, size_t es, size_t capacity>
+inline bool operator!=(const concurrent_quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
+
+template<size_t nbits, size_t es, size_t capacity>
+inline std::ostream& operator<<(std::ostream& ostr, const concurrent_quire<nbits, es, capacity>& cq) {
+	return ostr << cq.resolve();
+}
+
+	}  // namespace unum
+
+}  // namespace sw
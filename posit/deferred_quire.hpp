@@ -0,0 +1,150 @@
+#pragma once
+// deferred_quire.hpp: a quire that defers carry propagation until it is read
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+namespace sw {
+	namespace unum {
+
+/*
+ deferred_quire: accumulation mode of the quire<nbits,es,capacity> for very long sums of products.
+
+ The quire keeps a normalized sign and magnitude, so every addend ripples its carry or borrow up the limbs
+ until it is absorbed, and an addend that flips the sign of the sum negates the whole magnitude.
+ The deferred quire holds a two's complement accumulator in the same 64-bit limbs, plus a signed counter per limb
+ for the carries and borrows that leave the limbs an addend covers. An addend only touches its two or three limbs
+ and one counter, independent of the state of the sum. The counters are resolved into a normalized quire when
+ the deferred quire is read, converted, or compared. The resolved quire is bit-identical to the quire
+ that accumulated the same addends, as long as the sum stays within the capacity of the quire.
+
+     deferred_quire<32, 2> dq;
+     for (size_t i = 0; i < n; ++i) dq += quire_mul(x[i], y[i]);
+     posit<32, 2> dot;
+     convert(dq.to_value(), dot);
+ */
+template<size_t nbits, size_t es, size_t capacity = 30>
+class deferred_quire {
+public:
+	typedef quire<nbits, es, capacity> Quire;
+	static constexpr size_t half_range = Quire::half_range;
+	static constexpr size_t qbits = Quire::qbits;
+	static constexpr size_t qlimbs = Quire::qlimbs;
+
+	deferred_quire() { reset(); }
+	deferred_quire(const Quire& q) { *this = q; }
+
+	deferred_quire& operator=(const Quire& q) {
+		reset();
+		for (size_t i = 0; i < qlimbs; ++i) _limb[i] = q._limb[i];
+		if (q._sign) negate();
+		return *this;
+	}
+
+	// add a normalized value: the addend is added to or subtracted from the limbs it covers
+	template<size_t fbits>
+	deferred_quire& operator+=(const value<fbits>& rhs) {
+		accumulate(rhs, rhs.sign());
+		return *this;
+	}
+	template<size_t fbits>
+	deferred_quire& operator-=(const value<fbits>& rhs) {
+		accumulate(rhs, !rhs.sign());
+		return *this;
+	}
+	deferred_quire& operator+=(const posit<nbits, es>& rhs) {
+		if (rhs.iszero()) return *this;
+		return operator+=(quire_value(rhs));
+	}
+	deferred_quire& operator-=(const posit<nbits, es>& rhs) {
+		if (rhs.iszero()) return *this;
+		return operator-=(quire_value(rhs));
+	}
+
+	void reset() {
+		for (size_t i = 0; i < qlimbs; ++i) _limb[i] = 0;
+		for (size_t i = 0; i <= qlimbs; ++i) _pending[i] = 0;
+	}
+	void clear() { reset(); }
+
+	// propagate the deferred carries and borrows, and return the normalized quire
+	Quire resolve() const {
+		Quire q;
+		int64_t carry = 0;
+		for (size_t i = 0; i < qlimbs; ++i) {
+			// add the signed counter, sign extended to two limbs, to the limb
+			int64_t c = _pending[i] + carry;
+			uint64_t sum = _limb[i] + uint64_t(c);
+			carry = (c < 0 ? -1 : 0) + (sum < _limb[i] ? 1 : 0);
+			q._limb[i] = sum;
+		}
+		carry += _pending[qlimbs];
+		if (carry < 0) {
+			// the sum is negative: the quire holds its magnitude
+			uint64_t borrow = 0;
+			for (size_t i = 0; i < qlimbs; ++i) q._limb[i] = subborrow(0, q._limb[i], borrow);
+			q._sign = true;
+		}
+		q._limb[qlimbs - 1] &= Quire::top_mask;   // carries out of the capacity segment are lost
+		q._first = 0;
+		q._last = qlimbs - 1;
+		q.trim();
+		if (q.iszero()) q._sign = false;
+		return q;
+	}
+
+	value<qbits> to_value() const { return resolve().to_value(); }
+	bool iszero() const { return resolve().iszero(); }
+	bool sign() const { return resolve().sign(); }
+
+private:
+	uint64_t _limb[qlimbs];         // two's complement sum of the addends, without the carries below
+	int64_t  _pending[qlimbs + 1];  // carries minus borrows that left limb i-1, to be added at limb i
+
+	template<size_t fbits>
+	void accumulate(const value<fbits>& v, bool negative) {
+		if (v.iszero()) return;
+		if (v.isinf() || v.isnan()) throw operand_is_nar{};
+		if (v.scale() > int(half_range)) throw operand_too_large_for_quire{};
+		if (v.scale() < -int(half_range)) throw operand_too_small_for_quire{};
+		long long lsb = (long long)half_range + v.scale() - (long long)fbits;   // quire position of the lsb of the significand
+		size_t first = (lsb > 0 ? size_t(lsb) / 64 : 0);
+		size_t last = size_t((long long)half_range + v.scale()) / 64;
+		bitblock<fbits> fraction = v.fraction();
+		// a negative addend is added as its one's complement plus one, which turns the borrow out into carry - 1
+		uint64_t complement = (negative ? ~uint64_t(0) : 0);
+		uint64_t carry = (negative ? 1 : 0);
+		for (size_t i = first; i <= last; ++i) _limb[i] = addcarry(_limb[i], Quire::significand_word(fraction, (long long)(64 * i) - lsb) ^ complement, carry);
+		_pending[last + 1] += int64_t(carry) - int64_t(negative);
+	}
+	// two's complement of the accumulator, including its deferred carries
+	void negate() {
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < qlimbs; ++i) _limb[i] = subborrow(0, _limb[i], borrow);
+		for (size_t i = 0; i <= qlimbs; ++i) _pending[i] = -_pending[i];
+		_pending[qlimbs] -= int64_t(borrow);
+	}
+};
+
+template<size_t nbits, size_t es, size_t capacity>
+inline bool operator==(const deferred_quire<nbits, es, capacity>& lhs, const deferred_quire<nbits, es, capacity>& rhs) { return lhs.resolve() == rhs.resolve(); }
+template<size_t nbits, size_t es, size_t capacity>
+inline bool operator!=(const deferred_quire<nbits, es, capacity>& lhs, const deferred_quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
+template<size_t nbits, size_t es, size_t capacity>
+inline bool operator==(const deferred_quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs.resolve() == rhs; }
+template<size_t nbits, size_t es, size_t capacity>
+inline bool operator!=(const deferred_quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
+template<size_t nbits, size_t es, size_t capacity>
+inline bool operator< (const deferred_quire<nbits, es, capacity>& lhs, const deferred_quire<nbits, es, capacity>& rhs) { return lhs.resolve() < rhs.resolve(); }
+template<size_t nbits, size_t es, size_t capacity>
+inline bool operator> (const deferred_quire<nbits, es, capacity>& lhs, const deferred_quire<nbits, es, capacity>& rhs) { return rhs.resolve() < lhs.resolve(); }
+
+template<size_t nbits, size_t es, size_t capacity>
+inline std::ostream& operator<<(std::ostream& ostr, const deferred_quire<nbits, es, capacity>& dq) {
+	return ostr << dq.resolve();
+}
+
+	}  // namespace unum
+
+}  // namespace sw
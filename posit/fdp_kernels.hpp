@@ -0,0 +1,306 @@
+#pragma once
+// fdp_kernels.hpp: vectorized fused dot product kernels for posit<8,0> and posit<16,1> arrays
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstring>
+
+// enable/disable the dot product kernels of posit<8,0> and posit<16,1>
+// when set, fdp() on vectors of these configurations accumulates the products in fixed-point integer lanes
+// that are reduced exactly into the quire, instead of adding every product to the limbs of the quire
+#if !defined(POSIT_FAST_FDP_KERNELS)
+// default is to enable them
+#define POSIT_FAST_FDP_KERNELS 1
+#endif
+
+// the AVX2 kernels are compiled with a target attribute and selected at runtime, so the library
+// does not need to be compiled with -mavx2 (USE_AVX2) to use them on a processor that supports them
+#if !defined(POSIT_FDP_KERNELS_AVX2)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define POSIT_FDP_KERNELS_AVX2 1
+#else
+#define POSIT_FDP_KERNELS_AVX2 0
+#endif
+#endif
+
+#if POSIT_FDP_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+namespace sw {
+	namespace unum {
+
+/*
+ fdp_kernel<nbits,es>: dot product kernels for the small posit configurations of inference workloads.
+
+ Every posit<8,0> is an integer multiple of 2^-6 with a magnitude of at most 2^6, so every product is an integer
+ multiple of 2^-12 of at most 2^24: a table maps the encoding to that integer, and the products are summed exactly
+ in 64-bit integer lanes.
+ A posit<16,1> is a 13-bit significand and a scale in [-28, 28], so a product is a 26-bit integer at a bit offset
+ in [0, 112] from 2^-80. The lane-split quire cuts the offset into a 32-bit digit and a shift, and adds the shifted
+ product as two 32-bit halves to five signed 64-bit digits of weight 2^(32k - 80).
+ Both accumulators are exact, and are reduced into the quire with add_integer() before their headroom runs out,
+ so the sums are bit-identical to the accumulation of the products with quire::add_product().
+
+ The AVX2 kernels decode eight lanes with a table gather, multiply in 32-bit lanes, and add to vectors of digits
+ with compare masks instead of scatters. The processor is checked once at runtime; the scalar kernels handle
+ the remainder of the arrays and processors without AVX2.
+ */
+
+// whether the processor executing the program supports AVX2
+inline bool cpu_supports_avx2() {
+#if POSIT_FDP_KERNELS_AVX2
+	static const bool avx2 = []() {
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+	}();
+	return avx2;
+#else
+	return false;
+#endif
+}
+
+// the configurations without a kernel accumulate products in the quire one at a time
+template<size_t nbits, size_t es>
+struct fdp_kernel {
+	static constexpr bool enabled = false;
+	template<size_t capacity>
+	static bool accumulate(quire<nbits, es, capacity>&, size_t, const posit<nbits, es>*, size_t, const posit<nbits, es>*, size_t) { return true; }
+};
+
+// drive a kernel over the strided arrays x[0], x[incx], ..., x[(n-1)*incx] and y[0], y[incy], ..., y[(n-1)*incy]
+// in blocks of encodings: returns false when an operand is NaR
+template<typename Kernel, size_t nbits, size_t es>
+struct fdp_kernel_driver {
+	template<size_t capacity>
+	static bool accumulate(quire<nbits, es, capacity>& q, size_t n, const posit<nbits, es>* x, size_t incx, const posit<nbits, es>* y, size_t incy) {
+		typedef typename Kernel::encoding_type Encoding;
+		constexpr size_t BLOCK = 4096;
+		Encoding xe[BLOCK], ye[BLOCK];
+		typename Kernel::lanes acc;
+		uint64_t terms = 0;
+		bool nar = false;
+		for (size_t i = 0; i < n; i += BLOCK) {
+			size_t len = (n - i < BLOCK ? n - i : BLOCK);
+			load(xe, x + i * incx, incx, len);
+			load(ye, y + i * incy, incy, len);
+			if (terms + len > Kernel::max_terms) {
+				Kernel::reduce(acc, q);
+				acc = typename Kernel::lanes();
+				terms = 0;
+			}
+			nar = Kernel::dot(xe, ye, len, acc) || nar;
+			terms += len;
+		}
+		if (nar) return false;
+		Kernel::reduce(acc, q);
+		return true;
+	}
+	// gather the encodings of a block: the fast specializations store nothing but the encoding,
+	// so contiguous arrays of them are copied in bulk
+	template<typename Encoding>
+	static void load(Encoding* e, const posit<nbits, es>* p, size_t inc, size_t len) {
+		if (sizeof(posit<nbits, es>) == sizeof(Encoding) && inc == 1) {
+			std::memcpy(e, static_cast<const void*>(p), len * sizeof(Encoding));
+			return;
+		}
+		for (size_t j = 0; j < len; ++j) e[j] = Encoding(p[j * inc].encoding());
+	}
+};
+
+template<>
+struct fdp_kernel<8, 0> : fdp_kernel_driver<fdp_kernel<8, 0>, 8, 0> {
+	static constexpr bool enabled = (POSIT_FAST_FDP_KERNELS != 0);
+	typedef uint8_t encoding_type;
+	static constexpr uint64_t max_terms = uint64_t(1) << 32;   // |product| <= 2^24: no overflow of a 64-bit lane
+	// the sum of the products in units of 2^-12
+	struct lanes {
+		lanes() : sum(0) {}
+		int64_t sum;
+	};
+
+	// posit<8,0> encodings as integers in units of 2^-6; zero and NaR map to 0
+	static const int32_t* table() {
+		static const struct fixed_point {
+			int32_t v[256];
+			fixed_point() {
+				for (uint64_t bits = 0; bits < 256; ++bits) {
+					v[bits] = 0;
+					if (bits == 0 || bits == 0x80) continue;
+					bool sign;
+					int scale;
+					uint64_t significand;
+					native_arithmetic<8, 0>::decode(bits, sign, scale, significand);
+					int32_t magnitude = int32_t(significand >> (57 - scale));
+					v[bits] = (sign ? -magnitude : magnitude);
+				}
+			}
+		} t;
+		return t.v;
+	}
+
+	// returns true when an operand is NaR
+	static bool dot(const uint8_t* x, const uint8_t* y, size_t n, lanes& acc) {
+#if POSIT_FDP_KERNELS_AVX2
+		if (cpu_supports_avx2()) return dot_avx2(x, y, n, acc);
+#endif
+		return dot_scalar(x, y, n, acc);
+	}
+	static bool dot_scalar(const uint8_t* x, const uint8_t* y, size_t n, lanes& acc) {
+		const int32_t* t = table();
+		bool nar = false;
+		int64_t sum = 0;
+		for (size_t i = 0; i < n; ++i) {
+			nar |= (x[i] == 0x80) | (y[i] == 0x80);
+			sum += int64_t(t[x[i]] * t[y[i]]);
+		}
+		acc.sum += sum;
+		return nar;
+	}
+#if POSIT_FDP_KERNELS_AVX2
+	__attribute__((target("avx2")))
+	static bool dot_avx2(const uint8_t* x, const uint8_t* y, size_t n, lanes& acc) {
+		const int* t = reinterpret_cast<const int*>(table());
+		const __m256i nar = _mm256_set1_epi32(0x80);
+		__m256i isnar = _mm256_setzero_si256();
+		__m256i sum = _mm256_setzero_si256();
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			__m256i a = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + i)));
+			__m256i b = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(y + i)));
+			isnar = _mm256_or_si256(isnar, _mm256_or_si256(_mm256_cmpeq_epi32(a, nar), _mm256_cmpeq_epi32(b, nar)));
+			__m256i p = _mm256_mullo_epi32(_mm256_i32gather_epi32(t, a, 4), _mm256_i32gather_epi32(t, b, 4));
+			sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(p)));
+			sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(p, 1)));
+		}
+		int64_t lane[4];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), sum);
+		acc.sum += lane[0] + lane[1] + lane[2] + lane[3];
+		bool tail = dot_scalar(x + i, y + i, n - i, acc);
+		return _mm256_movemask_epi8(isnar) != 0 || tail;
+	}
+#endif
+
+	template<size_t capacity>
+	static void reduce(const lanes& acc, quire<8, 0, capacity>& q) {
+		q.add_integer(acc.sum, -12);
+	}
+};
+
+template<>
+struct fdp_kernel<16, 1> : fdp_kernel_driver<fdp_kernel<16, 1>, 16, 1> {
+	static constexpr bool enabled = (POSIT_FAST_FDP_KERNELS != 0);
+	typedef uint16_t encoding_type;
+	static constexpr size_t DIGITS = 5;
+	static constexpr uint64_t max_terms = uint64_t(1) << 30;   // |half of a product| < 2^32: no overflow of a 64-bit digit
+	// the sum of the products as signed digits of weight 2^(32k - 80)
+	struct lanes {
+		lanes() { for (size_t k = 0; k < DIGITS; ++k) digit[k] = 0; }
+		int64_t digit[DIGITS];
+	};
+
+	// posit<16,1> encodings as (scale + 28) << 16 | significand, with the 13-bit significand 1.fraction; zero and NaR map to 0
+	static const uint32_t* table() {
+		static const struct decoded {
+			uint32_t v[65536];
+			decoded() {
+				for (uint64_t bits = 0; bits < 65536; ++bits) {
+					v[bits] = 0;
+					if (bits == 0 || bits == 0x8000) continue;
+					bool sign;
+					int scale;
+					uint64_t significand;
+					native_arithmetic<16, 1>::decode(bits, sign, scale, significand);
+					v[bits] = (uint32_t(scale + 28) << 16) | uint32_t(significand >> 51);
+				}
+			}
+		} t;
+		return t.v;
+	}
+
+	// returns true when an operand is NaR
+	static bool dot(const uint16_t* x, const uint16_t* y, size_t n, lanes& acc) {
+#if POSIT_FDP_KERNELS_AVX2
+		if (cpu_supports_avx2()) return dot_avx2(x, y, n, acc);
+#endif
+		return dot_scalar(x, y, n, acc);
+	}
+	static bool dot_scalar(const uint16_t* x, const uint16_t* y, size_t n, lanes& acc) {
+		const uint32_t* t = table();
+		bool nar = false;
+		for (size_t i = 0; i < n; ++i) {
+			uint16_t a = x[i], b = y[i];
+			nar |= (a == 0x8000) | (b == 0x8000);
+			uint32_t ta = t[a], tb = t[b];
+			uint32_t offset = (ta >> 16) + (tb >> 16);   // the product has its lsb at 2^(offset - 80)
+			uint64_t p = uint64_t((ta & 0x1FFF) * (tb & 0x1FFF)) << (offset & 31);
+			int64_t lo = int64_t(p & 0xFFFFFFFF), hi = int64_t(p >> 32);
+			if ((a ^ b) & 0x8000) {
+				lo = -lo;
+				hi = -hi;
+			}
+			acc.digit[offset >> 5] += lo;
+			acc.digit[(offset >> 5) + 1] += hi;
+		}
+		return nar;
+	}
+#if POSIT_FDP_KERNELS_AVX2
+	__attribute__((target("avx2")))
+	static bool dot_avx2(const uint16_t* x, const uint16_t* y, size_t n, lanes& acc) {
+		const int* t = reinterpret_cast<const int*>(table());
+		const __m256i nar = _mm256_set1_epi32(0x8000);
+		const __m256i significand = _mm256_set1_epi32(0x1FFF);
+		const __m256i shift = _mm256_set1_epi64x(31);
+		const __m256i low = _mm256_set1_epi64x(0xFFFFFFFF);
+		__m256i isnar = _mm256_setzero_si256();
+		__m256i digit[DIGITS];
+		for (size_t k = 0; k < DIGITS; ++k) digit[k] = _mm256_setzero_si256();
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			__m256i a = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)));
+			__m256i b = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)));
+			isnar = _mm256_or_si256(isnar, _mm256_or_si256(_mm256_cmpeq_epi32(a, nar), _mm256_cmpeq_epi32(b, nar)));
+			__m256i ta = _mm256_i32gather_epi32(t, a, 4);
+			__m256i tb = _mm256_i32gather_epi32(t, b, 4);
+			__m256i p = _mm256_mullo_epi32(_mm256_and_si256(ta, significand), _mm256_and_si256(tb, significand));
+			__m256i offset = _mm256_add_epi32(_mm256_srli_epi32(ta, 16), _mm256_srli_epi32(tb, 16));
+			__m256i negative = _mm256_srai_epi32(_mm256_slli_epi32(_mm256_xor_si256(a, b), 16), 31);
+			// widen each half of the eight lanes to 64 bits
+			for (int h = 0; h < 2; ++h) {
+				__m128i ph = (h == 0 ? _mm256_castsi256_si128(p) : _mm256_extracti128_si256(p, 1));
+				__m128i oh = (h == 0 ? _mm256_castsi256_si128(offset) : _mm256_extracti128_si256(offset, 1));
+				__m128i nh = (h == 0 ? _mm256_castsi256_si128(negative) : _mm256_extracti128_si256(negative, 1));
+				__m256i o = _mm256_cvtepu32_epi64(oh);
+				__m256i m = _mm256_cvtepi32_epi64(nh);
+				__m256i w = _mm256_sllv_epi64(_mm256_cvtepu32_epi64(ph), _mm256_and_si256(o, shift));
+				__m256i block = _mm256_srli_epi64(o, 5);
+				// conditional negation: (w ^ m) - m
+				__m256i lo = _mm256_sub_epi64(_mm256_xor_si256(_mm256_and_si256(w, low), m), m);
+				__m256i hi = _mm256_sub_epi64(_mm256_xor_si256(_mm256_srli_epi64(w, 32), m), m);
+				for (size_t k = 0; k < DIGITS; ++k) {
+					digit[k] = _mm256_add_epi64(digit[k], _mm256_and_si256(lo, _mm256_cmpeq_epi64(block, _mm256_set1_epi64x(int64_t(k)))));
+					if (k > 0) digit[k] = _mm256_add_epi64(digit[k], _mm256_and_si256(hi, _mm256_cmpeq_epi64(block, _mm256_set1_epi64x(int64_t(k) - 1))));
+				}
+			}
+		}
+		for (size_t k = 0; k < DIGITS; ++k) {
+			int64_t lane[4];
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), digit[k]);
+			acc.digit[k] += lane[0] + lane[1] + lane[2] + lane[3];
+		}
+		bool tail = dot_scalar(x + i, y + i, n - i, acc);
+		return _mm256_movemask_epi8(isnar) != 0 || tail;
+	}
+#endif
+
+	template<size_t capacity>
+	static void reduce(const lanes& acc, quire<16, 1, capacity>& q) {
+		for (size_t k = 0; k < DIGITS; ++k) q.add_integer(acc.digit[k], int(32 * k) - 80);
+	}
+};
+
+	}  // namespace unum
+
+}  // namespace sw
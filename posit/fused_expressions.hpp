@@ -0,0 +1,345 @@
+#pragma once
+// fused_expressions.hpp: expression templates that evaluate posit sums of products in the quire
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <future>
+#include <vector>
+#include "fdp_kernels.hpp"
+
+namespace sw {
+	namespace unum {
+
+/*
+ Sum-of-products expressions over posit<nbits,es> are captured lazily when one operand of each product
+ is marked with fused(), and reductions over ranges are captured with fused_dot() and fused_sum():
+
+     posit<32,2> det = fused(a)*d - fused(b)*c;
+     posit<32,2> r   = fused_dot(x.begin(), x.end(), y.begin()) - fused(e)*f + g;
+     q += fused(a)*b + fused(c)*d;      // continue an existing quire
+     posit<32,2> s   = fused_dot(x.begin(), x.end(), y.begin(), 8);   // dot product over 8 threads
+     posit<32,2> d   = fdp(x, y);       // the fused dot product of two vectors
+     posit<32,2> c   = fdp(n, &A[j], lda, x.data(), 1);   // the fused dot product of a column of A and x
+
+ Nothing is computed until the expression is converted to a posit, evaluated with an explicit quire capacity,
+ or added to a quire. All products and posit terms are then accumulated exactly in a single quire,
+ and the result is rounded once. The nodes hold copies of their posit operands and the iterators of their ranges,
+ so an expression does not refer to temporaries that have gone out of scope, but ranges must outlive it.
+ */
+
+// fused_expression is the CRTP base of all expression nodes
+template<typename Expression, size_t nbits, size_t es>
+struct fused_expression {
+	const Expression& self() const { return static_cast<const Expression&>(*this); }
+
+	// accumulate the expression exactly in a quire of the given capacity and round once
+	template<size_t capacity>
+	posit<nbits, es> evaluate() const {
+		posit<nbits, es> p;
+		if (self().isnar()) {
+			p.setnar();
+			return p;
+		}
+		quire<nbits, es, capacity> q;
+		self().accumulate(q, false);
+		return convert(q.to_value(), p);
+	}
+	operator posit<nbits, es>() const { return evaluate<30>(); }
+};
+
+// a posit term: added to the quire without rounding
+template<size_t nbits, size_t es>
+class fused_posit : public fused_expression<fused_posit<nbits, es>, nbits, es> {
+public:
+	explicit fused_posit(const posit<nbits, es>& p) : _p(p) {}
+	const posit<nbits, es>& get() const { return _p; }
+	bool isnar() const { return _p.isnar(); }
+	template<size_t capacity>
+	void accumulate(quire<nbits, es, capacity>& q, bool negate) const {
+		if (_p.iszero()) return;
+		if (negate) q -= _p; else q += _p;
+	}
+private:
+	posit<nbits, es> _p;
+};
+
+// an exact product of two posits
+template<size_t nbits, size_t es>
+class fused_product : public fused_expression<fused_product<nbits, es>, nbits, es> {
+public:
+	fused_product(const posit<nbits, es>& a, const posit<nbits, es>& b) : _a(a), _b(b) {}
+	bool isnar() const { return _a.isnar() || _b.isnar(); }
+	template<size_t capacity>
+	void accumulate(quire<nbits, es, capacity>& q, bool negate) const {
+		if (negate) q.subtract_product(_a, _b); else q.add_product(_a, _b);
+	}
+private:
+	posit<nbits, es> _a, _b;
+};
+
+// the sum or difference of two expressions
+template<typename Lhs, typename Rhs, size_t nbits, size_t es>
+class fused_addition : public fused_expression<fused_addition<Lhs, Rhs, nbits, es>, nbits, es> {
+public:
+	fused_addition(const Lhs& lhs, const Rhs& rhs, bool subtract) : _lhs(lhs), _rhs(rhs), _subtract(subtract) {}
+	bool isnar() const { return _lhs.isnar() || _rhs.isnar(); }
+	template<size_t capacity>
+	void accumulate(quire<nbits, es, capacity>& q, bool negate) const {
+		_lhs.accumulate(q, negate);
+		_rhs.accumulate(q, negate != _subtract);
+	}
+private:
+	Lhs  _lhs;
+	Rhs  _rhs;
+	bool _subtract;
+};
+
+// the negation of an expression
+template<typename Operand, size_t nbits, size_t es>
+class fused_negate : public fused_expression<fused_negate<Operand, nbits, es>, nbits, es> {
+public:
+	explicit fused_negate(const Operand& operand) : _operand(operand) {}
+	bool isnar() const { return _operand.isnar(); }
+	template<size_t capacity>
+	void accumulate(quire<nbits, es, capacity>& q, bool negate) const {
+		_operand.accumulate(q, !negate);
+	}
+private:
+	Operand _operand;
+};
+
+// the dot product of two ranges of posits
+template<typename Iterator1, typename Iterator2, size_t nbits, size_t es>
+class fused_dot_range : public fused_expression<fused_dot_range<Iterator1, Iterator2, nbits, es>, nbits, es> {
+public:
+	fused_dot_range(Iterator1 first1, Iterator1 last1, Iterator2 first2) : _first1(first1), _last1(last1), _first2(first2) {}
+	bool isnar() const {
+		Iterator2 y = _first2;
+		for (Iterator1 x = _first1; x != _last1; ++x, ++y) {
+			if (x->isnar() || y->isnar()) return true;
+		}
+		return false;
+	}
+	template<size_t capacity>
+	void accumulate(quire<nbits, es, capacity>& q, bool negate) const {
+		Iterator2 y = _first2;
+		for (Iterator1 x = _first1; x != _last1; ++x, ++y) {
+			if (negate) q.subtract_product(*x, *y); else q.add_product(*x, *y);
+		}
+	}
+private:
+	Iterator1 _first1, _last1;
+	Iterator2 _first2;
+};
+
+// the dot product of two random access ranges of posits, partitioned over a number of threads.
+// Every thread accumulates its slice in a private quire, and the partial quires are merged limb by limb
+// in slice order. No partial sum is rounded, so the result is bit-identical for any number of threads.
+template<typename Iterator1, typename Iterator2, size_t nbits, size_t es>
+class fused_parallel_dot_range : public fused_expression<fused_parallel_dot_range<Iterator1, Iterator2, nbits, es>, nbits, es> {
+public:
+	fused_parallel_dot_range(Iterator1 first1, Iterator1 last1, Iterator2 first2, size_t nrThreads) : _first1(first1), _last1(last1), _first2(first2), _nrThreads(nrThreads) {}
+	bool isnar() const {
+		return fused_dot_range<Iterator1, Iterator2, nbits, es>(_first1, _last1, _first2).isnar();
+	}
+	template<size_t capacity>
+	void accumulate(quire<nbits, es, capacity>& q, bool negate) const {
+		typedef fused_dot_range<Iterator1, Iterator2, nbits, es> Slice;
+		size_t n = size_t(_last1 - _first1);
+		size_t nrSlices = (_nrThreads < 1 ? 1 : (_nrThreads > n ? n : _nrThreads));
+		if (nrSlices <= 1) {
+			Slice(_first1, _last1, _first2).accumulate(q, negate);
+			return;
+		}
+		// the calling thread reduces the first slice while the others run asynchronously
+		std::vector< std::future< quire<nbits, es, capacity> > > partials;
+		partials.reserve(nrSlices - 1);
+		for (size_t t = 1; t < nrSlices; ++t) {
+			size_t begin = n * t / nrSlices, end = n * (t + 1) / nrSlices;
+			Slice slice(_first1 + begin, _first1 + end, _first2 + begin);
+			partials.push_back(std::async(std::launch::async, [slice]() {
+				quire<nbits, es, capacity> partial;
+				slice.accumulate(partial, false);
+				return partial;
+			}));
+		}
+		quire<nbits, es, capacity> sum;
+		Slice(_first1, _first1 + n / nrSlices, _first2).accumulate(sum, false);
+		for (auto& partial : partials) sum += partial.get();
+		if (negate) q -= sum; else q += sum;
+	}
+private:
+	Iterator1 _first1, _last1;
+	Iterator2 _first2;
+	size_t    _nrThreads;
+};
+
+// the sum of a range of posits
+template<typename Iterator, size_t nbits, size_t es>
+class fused_sum_range : public fused_expression<fused_sum_range<Iterator, nbits, es>, nbits, es> {
+public:
+	fused_sum_range(Iterator first, Iterator last) : _first(first), _last(last) {}
+	bool isnar() const {
+		for (Iterator x = _first; x != _last; ++x) if (x->isnar()) return true;
+		return false;
+	}
+	template<size_t capacity>
+	void accumulate(quire<nbits, es, capacity>& q, bool negate) const {
+		for (Iterator x = _first; x != _last; ++x) {
+			if (x->iszero()) continue;
+			if (negate) q -= *x; else q += *x;
+		}
+	}
+private:
+	Iterator _first, _last;
+};
+
+// mark a posit as the start of a fused expression
+template<size_t nbits, size_t es>
+inline fused_posit<nbits, es> fused(const posit<nbits, es>& p) {
+	return fused_posit<nbits, es>(p);
+}
+
+// capture the dot product of [first1, last1) and the range starting at first2
+template<typename Iterator1, typename Iterator2>
+inline auto fused_dot(Iterator1 first1, Iterator1 last1, Iterator2 first2)
+	-> fused_dot_range<Iterator1, Iterator2, std::decay<decltype(*first1)>::type::nbits, std::decay<decltype(*first1)>::type::es> {
+	typedef typename std::decay<decltype(*first1)>::type Posit;
+	return fused_dot_range<Iterator1, Iterator2, Posit::nbits, Posit::es>(first1, last1, first2);
+}
+
+// capture the dot product of the random access ranges [first1, last1) and first2, to be reduced by nrThreads threads
+template<typename Iterator1, typename Iterator2>
+inline auto fused_dot(Iterator1 first1, Iterator1 last1, Iterator2 first2, size_t nrThreads)
+	-> fused_parallel_dot_range<Iterator1, Iterator2, std::decay<decltype(*first1)>::type::nbits, std::decay<decltype(*first1)>::type::es> {
+	typedef typename std::decay<decltype(*first1)>::type Posit;
+	return fused_parallel_dot_range<Iterator1, Iterator2, Posit::nbits, Posit::es>(first1, last1, first2, nrThreads);
+}
+
+// capture the sum of [first, last)
+template<typename Iterator>
+inline auto fused_sum(Iterator first, Iterator last)
+	-> fused_sum_range<Iterator, std::decay<decltype(*first)>::type::nbits, std::decay<decltype(*first)>::type::es> {
+	typedef typename std::decay<decltype(*first)>::type Posit;
+	return fused_sum_range<Iterator, Posit::nbits, Posit::es>(first, last);
+}
+
+// accumulate the products of the strided arrays x[0], x[incx], ..., x[(n-1)*incx] and y[0], y[incy], ..., y[(n-1)*incy]
+// in a quire, returns false, leaving the quire unchanged, when an operand is NaR.
+// posit<8,0> and posit<16,1> arrays are reduced by the integer kernels of fdp_kernels.hpp, the other configurations
+// multiply-accumulate every product in the quire without a value<> temporary
+template<size_t nbits, size_t es, size_t capacity>
+inline bool fdp_products(quire<nbits, es, capacity>& q, size_t n, const posit<nbits, es>* x, size_t incx, const posit<nbits, es>* y, size_t incy) {
+	if (fdp_kernel<nbits, es>::enabled) {
+		quire<nbits, es, capacity> sum;
+		if (!fdp_kernel<nbits, es>::accumulate(sum, n, x, incx, y, incy)) return false;
+		q += sum;
+		return true;
+	}
+	for (size_t i = 0; i < n; ++i) {
+		if (x[i * incx].isnar() || y[i * incy].isnar()) return false;
+	}
+	for (size_t i = 0; i < n; ++i) q.add_product(x[i * incx], y[i * incy]);
+	return true;
+}
+
+// fused dot product of n elements of two strided arrays, rounded once
+template<size_t nbits, size_t es>
+inline posit<nbits, es> fdp(size_t n, const posit<nbits, es>* x, size_t incx, const posit<nbits, es>* y, size_t incy) {
+	posit<nbits, es> p;
+	quire<nbits, es> q;
+	if (!fdp_products(q, n, x, incx, y, incy)) {
+		p.setnar();
+		return p;
+	}
+	return convert(q.to_value(), p);
+}
+// fused dot product of n elements of two strided arrays continued in a quire: the quire cannot represent NaR,
+// so NaR operands are rejected and the quire is left unchanged
+template<size_t nbits, size_t es, size_t capacity>
+inline quire<nbits, es, capacity>& fdp_accumulate(quire<nbits, es, capacity>& q, size_t n, const posit<nbits, es>* x, size_t incx, const posit<nbits, es>* y, size_t incy) {
+	if (!fdp_products(q, n, x, incx, y, incy)) throw operand_is_nar{};
+	return q;
+}
+
+// fused dot product of two vectors of equal length, rounded once
+template<size_t nbits, size_t es>
+inline posit<nbits, es> fdp(const std::vector< posit<nbits, es> >& x, const std::vector< posit<nbits, es> >& y) {
+	return fdp(x.size(), x.data(), 1, y.data(), 1);
+}
+// fused dot product continued in a quire
+template<size_t nbits, size_t es, size_t capacity>
+inline quire<nbits, es, capacity>& fdp(quire<nbits, es, capacity>& q, const std::vector< posit<nbits, es> >& x, const std::vector< posit<nbits, es> >& y) {
+	return fdp_accumulate(q, x.size(), x.data(), 1, y.data(), 1);
+}
+
+// products
+template<size_t nbits, size_t es>
+inline fused_product<nbits, es> operator*(const fused_posit<nbits, es>& lhs, const posit<nbits, es>& rhs) {
+	return fused_product<nbits, es>(lhs.get(), rhs);
+}
+template<size_t nbits, size_t es>
+inline fused_product<nbits, es> operator*(const posit<nbits, es>& lhs, const fused_posit<nbits, es>& rhs) {
+	return fused_product<nbits, es>(lhs, rhs.get());
+}
+template<size_t nbits, size_t es>
+inline fused_product<nbits, es> operator*(const fused_posit<nbits, es>& lhs, const fused_posit<nbits, es>& rhs) {
+	return fused_product<nbits, es>(lhs.get(), rhs.get());
+}
+
+// sums and differences of expressions
+template<typename Lhs, typename Rhs, size_t nbits, size_t es>
+inline fused_addition<Lhs, Rhs, nbits, es> operator+(const fused_expression<Lhs, nbits, es>& lhs, const fused_expression<Rhs, nbits, es>& rhs) {
+	return fused_addition<Lhs, Rhs, nbits, es>(lhs.self(), rhs.self(), false);
+}
+template<typename Lhs, typename Rhs, size_t nbits, size_t es>
+inline fused_addition<Lhs, Rhs, nbits, es> operator-(const fused_expression<Lhs, nbits, es>& lhs, const fused_expression<Rhs, nbits, es>& rhs) {
+	return fused_addition<Lhs, Rhs, nbits, es>(lhs.self(), rhs.self(), true);
+}
+template<typename Operand, size_t nbits, size_t es>
+inline fused_negate<Operand, nbits, es> operator-(const fused_expression<Operand, nbits, es>& operand) {
+	return fused_negate<Operand, nbits, es>(operand.self());
+}
+
+// posit terms in an expression are added exactly
+template<typename Lhs, size_t nbits, size_t es>
+inline fused_addition<Lhs, fused_posit<nbits, es>, nbits, es> operator+(const fused_expression<Lhs, nbits, es>& lhs, const posit<nbits, es>& rhs) {
+	return fused_addition<Lhs, fused_posit<nbits, es>, nbits, es>(lhs.self(), fused_posit<nbits, es>(rhs), false);
+}
+template<typename Lhs, size_t nbits, size_t es>
+inline fused_addition<Lhs, fused_posit<nbits, es>, nbits, es> operator-(const fused_expression<Lhs, nbits, es>& lhs, const posit<nbits, es>& rhs) {
+	return fused_addition<Lhs, fused_posit<nbits, es>, nbits, es>(lhs.self(), fused_posit<nbits, es>(rhs), true);
+}
+template<typename Rhs, size_t nbits, size_t es>
+inline fused_addition<fused_posit<nbits, es>, Rhs, nbits, es> operator+(const posit<nbits, es>& lhs, const fused_expression<Rhs, nbits, es>& rhs) {
+	return fused_addition<fused_posit<nbits, es>, Rhs, nbits, es>(fused_posit<nbits, es>(lhs), rhs.self(), false);
+}
+template<typename Rhs, size_t nbits, size_t es>
+inline fused_addition<fused_posit<nbits, es>, Rhs, nbits, es> operator-(const posit<nbits, es>& lhs, const fused_expression<Rhs, nbits, es>& rhs) {
+	return fused_addition<fused_posit<nbits, es>, Rhs, nbits, es>(fused_posit<nbits, es>(lhs), rhs.self(), true);
+}
+
+// continue an accumulation: the quire cannot represent NaR, so NaR terms are rejected
+template<size_t nbits, size_t es, size_t capacity, typename Expression>
+inline quire<nbits, es, capacity>& operator+=(quire<nbits, es, capacity>& q, const fused_expression<Expression, nbits, es>& e) {
+	if (e.self().isnar()) throw operand_is_nar{};
+	e.self().accumulate(q, false);
+	return q;
+}
+template<size_t nbits, size_t es, size_t capacity, typename Expression>
+inline quire<nbits, es, capacity>& operator-=(quire<nbits, es, capacity>& q, const fused_expression<Expression, nbits, es>& e) {
+	if (e.self().isnar()) throw operand_is_nar{};
+	e.self().accumulate(q, true);
+	return q;
+}
+
+// evaluate an expression in a quire of a specific capacity
+template<size_t capacity, typename Expression, size_t nbits, size_t es>
+inline posit<nbits, es> evaluate(const fused_expression<Expression, nbits, es>& e) {
+	return e.template evaluate<capacity>();
+}
+
+	}  // namespace unum
+
+}  // namespace sw
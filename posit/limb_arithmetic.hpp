@@ -0,0 +1,440 @@
+#pragma once
+// limb_arithmetic.hpp: posit arithmetic on the encoding of posits that span several 64-bit limbs
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <array>
+#include <limits>
+#include "../bitblock/bitblock.hpp"
+#include "../bitblock/limb_functions.hpp"
+#include "bit_functions.hpp"
+
+// the switch POSIT_FAST_NATIVE_ARITHMETIC also controls the multi-limb engine:
+// posit<nbits,es> with 64 < nbits and es <= 5 then computes on 64-bit limbs instead of the value<> pipeline
+
+namespace sw {
+	namespace unum {
+
+		// limb_arithmetic is the fixed-width multi-limb counterpart of native_arithmetic.
+		// Encodings are held right-aligned in little-endian arrays of 64-bit limbs. Operands decode into
+		// (sign, scale, significand) with the regime length found by counting leading zeros limb by limb,
+		// the significand carries the hidden bit at the top of the most significant limb, and the exact
+		// result (or its truncation plus a sticky bit) is rounded once with round-to-nearest-even.
+		template<size_t nbits, size_t es, bool fits = (nbits > 64 && es <= 5)>
+		struct limb_arithmetic {
+			static constexpr bool enabled = true;
+			static constexpr size_t nrLimbs = (nbits + 63) / 64;
+			static constexpr unsigned pad = unsigned(64 * nrLimbs - nbits);   // unused bits above the encoding in the top limb
+			static constexpr uint64_t topMask = ~uint64_t(0) >> pad;
+			static constexpr uint64_t signBit = uint64_t(1) << ((nbits - 1) % 64);
+			static constexpr int max_scale = (int(nbits) - 2) * (1 << es);
+			typedef std::array<uint64_t, nrLimbs> limbs;
+
+			static limbs zero() { limbs r; r.fill(0); return r; }
+			static limbs nar() { limbs r = zero(); r[nrLimbs - 1] = signBit; return r; }
+			static limbs maxpos() { limbs r; r.fill(~uint64_t(0)); r[nrLimbs - 1] = topMask >> 1; return r; }
+			static limbs minpos() { limbs r = zero(); r[0] = 1; return r; }
+
+			static bool iszero(const limbs& a) { return limb_is_zero<nrLimbs>(a.data()); }
+			static bool isnar(const limbs& a) {
+				if (a[nrLimbs - 1] != signBit) return false;
+				for (size_t i = 0; i + 1 < nrLimbs; ++i) if (a[i]) return false;
+				return true;
+			}
+			static bool isneg(const limbs& a) { return (a[nrLimbs - 1] & signBit) != 0; }
+
+			// two's complement of the encoding
+			static limbs negate(const limbs& a) {
+				limbs r;
+				uint64_t carry = 1;
+				for (size_t i = 0; i < nrLimbs; ++i) r[i] = addcarry(~a[i], 0, carry);
+				r[nrLimbs - 1] &= topMask;
+				return r;
+			}
+			// next and previous encoding on the projective circle
+			static void increment(limbs& a) {
+				uint64_t carry = 1;
+				for (size_t i = 0; i < nrLimbs; ++i) a[i] = addcarry(a[i], 0, carry);
+				a[nrLimbs - 1] &= topMask;
+			}
+			static void decrement(limbs& a) {
+				uint64_t borrow = 1;
+				for (size_t i = 0; i < nrLimbs; ++i) a[i] = subborrow(a[i], 0, borrow);
+				a[nrLimbs - 1] &= topMask;
+			}
+			// posit order is the order of the encodings as two's complement integers
+			static bool less(const limbs& a, const limbs& b) {
+				int64_t ta = int64_t(a[nrLimbs - 1] << pad), tb = int64_t(b[nrLimbs - 1] << pad);
+				if (ta != tb) return ta < tb;
+				for (size_t i = nrLimbs - 1; i-- > 0; ) {
+					if (a[i] != b[i]) return a[i] < b[i];
+				}
+				return false;
+			}
+
+			// transfer the encoding between a bitblock and limbs
+			static limbs load(const bitblock<nbits>& bb) {
+				limbs r;
+#if BITBLOCK_LIMB_ENGINE
+				for (size_t i = 0; i < nrLimbs; ++i) r[i] = bb.block(i);
+#else
+				r.fill(0);
+				for (size_t i = 0; i < nbits; ++i) if (bb[i]) r[i / 64] |= uint64_t(1) << (i % 64);
+#endif
+				return r;
+			}
+			static void store(const limbs& a, bitblock<nbits>& bb) {
+#if BITBLOCK_LIMB_ENGINE
+				for (size_t i = 0; i < nrLimbs; ++i) bb.setblock(i, a[i]);
+#else
+				for (size_t i = 0; i < nbits; ++i) bb[i] = ((a[i / 64] >> (i % 64)) & 1) != 0;
+#endif
+			}
+
+			// decode a posit encoding into sign, scale, and a significand with the hidden bit at the top of the top limb
+			static void decode(const limbs& bits, bool& sign, int& scale, limbs& significand) {
+				sign = isneg(bits);
+				limbs x = (sign ? negate(bits) : bits);
+				limb_shift_left<nrLimbs>(x.data(), pad + 1);   // drop the sign bit: regime starts at the top bit
+				int run, k;
+				if (x[nrLimbs - 1] >> 63) {
+					run = limb_leading_ones<nrLimbs>(x.data());
+					k = run - 1;
+				}
+				else {
+					run = limb_leading_zeros<nrLimbs>(x.data());
+					k = -run;
+				}
+				limb_shift_left<nrLimbs>(x.data(), unsigned(run + 1));   // drop the regime and its terminating bit
+				int e = 0;
+				if (es > 0) {
+					e = int(x[nrLimbs - 1] >> ((64 - es) % 64));
+					limb_shift_left<nrLimbs>(x.data(), es);
+				}
+				scale = k * (1 << es) + e;
+				limb_shift_right<nrLimbs>(x.data(), 1);
+				x[nrLimbs - 1] |= uint64_t(1) << 63;
+				significand = x;
+			}
+
+			// round (-1)^sign * 1.fraction * 2^scale to the nearest posit; significand holds the hidden bit at the top,
+			// and sticky flags any nonzero bits of the exact result below the significand
+			static limbs encode(bool sign, int scale, const limbs& significand, bool sticky) {
+				limbs bits;
+				if (scale > max_scale) {
+					bits = maxpos();
+				}
+				else if (scale < -max_scale) {
+					bits = minpos();
+				}
+				else {
+					int k = (scale >= 0 ? scale >> es : -((-scale + (1 << es) - 1) >> es));
+					uint64_t e = uint64_t(scale - k * (1 << es));
+					// regime, exponent, and fraction bits left-aligned
+					limbs word;
+					int run;
+					if (k >= 0) {
+						run = k + 1;
+						word.fill(~uint64_t(0));
+						limb_shift_left<nrLimbs>(word.data(), unsigned(64 * nrLimbs - run));
+					}
+					else {
+						run = -k;
+						word = zero();
+						word[nrLimbs - 1 - size_t(run / 64)] = uint64_t(1) << (63 - run % 64);
+					}
+					limbs tail = significand;
+					limb_shift_left<nrLimbs>(tail.data(), 1);   // drop the hidden bit
+					if (es > 0) {
+						sticky |= limb_shift_right<nrLimbs>(tail.data(), es);
+						tail[nrLimbs - 1] |= e << ((64 - es) % 64);
+					}
+					sticky |= limb_shift_right<nrLimbs>(tail.data(), unsigned(run + 1));
+					for (size_t i = 0; i < nrLimbs; ++i) word[i] |= tail[i];
+					bool guard = ((word[0] >> pad) & 1) != 0;
+					sticky |= (word[0] & ((uint64_t(1) << pad) - 1)) != 0;
+					limb_shift_right<nrLimbs>(word.data(), pad + 1);
+					bits = word;
+					if (guard && (sticky || (bits[0] & 1))) increment(bits);
+				}
+				return (sign ? negate(bits) : bits);
+			}
+
+			static limbs add(const limbs& a, const limbs& b) {
+				if (isnar(a) || isnar(b)) return nar();
+				if (iszero(a)) return b;
+				if (iszero(b)) return a;
+				bool sa, sb;
+				int ea, eb;
+				limbs ma, mb;
+				decode(a, sa, ea, ma);
+				decode(b, sb, eb, mb);
+				if (eb > ea || (eb == ea && limb_compare<nrLimbs>(mb.data(), ma.data()) > 0)) {
+					std::swap(sa, sb);
+					std::swap(ea, eb);
+					std::swap(ma, mb);
+				}
+				// a frame of twice the width with a carry bit above the hidden bit
+				std::array<uint64_t, 2 * nrLimbs> fa, fb;
+				for (size_t i = 0; i < nrLimbs; ++i) {
+					fa[i] = 0;
+					fb[i] = 0;
+					fa[i + nrLimbs] = ma[i];
+					fb[i + nrLimbs] = mb[i];
+				}
+				limb_shift_right<2 * nrLimbs>(fa.data(), 1);
+				limb_shift_right<2 * nrLimbs>(fb.data(), 1);
+				// bits of b below the frame only matter as a sticky bit far below the rounding position
+				if (limb_shift_right<2 * nrLimbs>(fb.data(), unsigned(ea - eb))) fb[0] |= 1;
+				uint64_t c = 0;
+				if (sa == sb) {
+					for (size_t i = 0; i < 2 * nrLimbs; ++i) fa[i] = addcarry(fa[i], fb[i], c);
+				}
+				else {
+					for (size_t i = 0; i < 2 * nrLimbs; ++i) fa[i] = subborrow(fa[i], fb[i], c);
+					if (limb_is_zero<2 * nrLimbs>(fa.data())) return zero();
+				}
+				int lz = limb_leading_zeros<2 * nrLimbs>(fa.data());
+				limb_shift_left<2 * nrLimbs>(fa.data(), unsigned(lz));
+				return encode(sa, ea + 1 - lz, upper_half(fa), lower_half_nonzero(fa));
+			}
+
+			static limbs sub(const limbs& a, const limbs& b) {
+				return add(a, negate(b));
+			}
+
+			static limbs mul(const limbs& a, const limbs& b) {
+				if (isnar(a) || isnar(b)) return nar();
+				if (iszero(a) || iszero(b)) return zero();
+				bool sa, sb;
+				int ea, eb;
+				limbs ma, mb;
+				decode(a, sa, ea, ma);
+				decode(b, sb, eb, mb);
+				std::array<uint64_t, 2 * nrLimbs> p;
+				limb_multiply<nrLimbs>(ma.data(), mb.data(), p.data());
+				int scale = ea + eb;
+				if (p[2 * nrLimbs - 1] >> 63) {
+					++scale;
+				}
+				else {
+					limb_shift_left<2 * nrLimbs>(p.data(), 1);
+				}
+				return encode(sa != sb, scale, upper_half(p), lower_half_nonzero(p));
+			}
+
+			static limbs div(const limbs& a, const limbs& b) {
+				if (isnar(a) || isnar(b) || iszero(b)) return nar();
+				if (iszero(a)) return zero();
+				bool sa, sb;
+				int ea, eb;
+				limbs ma, mb;
+				decode(a, sa, ea, ma);
+				decode(b, sb, eb, mb);
+				// (ma * 2^(64*nrLimbs - 1)) / mb lies in (2^(64*nrLimbs - 2), 2^(64*nrLimbs))
+				std::array<uint64_t, 2 * nrLimbs> u;
+				for (size_t i = 0; i < nrLimbs; ++i) {
+					u[i] = 0;
+					u[i + nrLimbs] = ma[i];
+				}
+				limb_shift_right<2 * nrLimbs>(u.data(), 1);
+				std::array<uint64_t, nrLimbs + 1> q;
+				bool inexact = long_division(u, mb, q);
+				limbs quotient;
+				for (size_t i = 0; i < nrLimbs; ++i) quotient[i] = q[i];
+				int scale = ea - eb;
+				if ((quotient[nrLimbs - 1] >> 63) == 0) {
+					limb_shift_left<nrLimbs>(quotient.data(), 1);
+					--scale;
+				}
+				return encode(sa != sb, scale, quotient, inexact);
+			}
+
+			static limbs sqrt(const limbs& a) {
+				if (iszero(a)) return zero();
+				if (isneg(a)) return nar();   // NaR and negative arguments
+				bool s;
+				int e;
+				limbs m;
+				decode(a, s, e, m);
+				// radicand in [2^(128*nrLimbs - 2), 2^(128*nrLimbs)): an odd scale moves one factor of 2 into the significand
+				bool odd = (e & 1) != 0;
+				std::array<uint64_t, 2 * nrLimbs> radicand;
+				for (size_t i = 0; i < nrLimbs; ++i) {
+					radicand[i] = 0;
+					radicand[i + nrLimbs] = m[i];
+				}
+				if (!odd) limb_shift_right<2 * nrLimbs>(radicand.data(), 1);
+				bool inexact;
+				limbs root = isqrt(radicand, inexact);
+				return encode(false, (e - int(odd)) / 2, root, inexact);
+			}
+
+			// the value of the encoding in a native floating-point type, rounded once to its precision
+			template<typename Real>
+			static Real to_native(const limbs& bits) {
+				if (iszero(bits)) return Real(0);
+				if (isnar(bits)) return std::numeric_limits<Real>::quiet_NaN();
+				bool sign;
+				int scale;
+				limbs m;
+				decode(bits, sign, scale, m);
+				bool sticky = false;
+				for (size_t i = 0; i + 2 < nrLimbs; ++i) sticky |= (m[i] != 0);
+				uint64_t hi = m[nrLimbs - 1], lo = m[nrLimbs - 2];
+				if (ieee_encoder<Real>::enabled) return ieee_encoder<Real>::encode(sign, scale, hi, lo, sticky);
+				Real v;
+				if (std::numeric_limits<Real>::digits < 64) {
+					// rounding to odd on 64 bits preserves the round-to-nearest-even of the conversion
+					v = std::ldexp(Real(hi | uint64_t(lo != 0 || sticky)), scale - 63);
+				}
+				else {
+					v = std::ldexp(Real(hi), scale - 63) + std::ldexp(Real(lo | uint64_t(sticky)), scale - 127);
+				}
+				return (sign ? -v : v);
+			}
+
+			// the operators on the encoding held in a bitblock, as used by the generic posit
+			// decode into the top 128 bits of the significand, with the hidden bit at bit 63 of hi, and a sticky bit for the bits below
+			static void decode(const bitblock<nbits>& a, bool& sign, int& scale, uint64_t& hi, uint64_t& lo, bool& sticky) {
+				limbs m;
+				decode(load(a), sign, scale, m);
+				hi = m[nrLimbs - 1];
+				lo = m[nrLimbs - 2];
+				sticky = false;
+				for (size_t i = 0; i + 2 < nrLimbs; ++i) sticky |= (m[i] != 0);
+			}
+			template<typename Real>
+			static Real to_native(const bitblock<nbits>& a) { return to_native<Real>(load(a)); }
+			static void add(const bitblock<nbits>& a, const bitblock<nbits>& b, bitblock<nbits>& r) { store(add(load(a), load(b)), r); }
+			static void sub(const bitblock<nbits>& a, const bitblock<nbits>& b, bitblock<nbits>& r) { store(sub(load(a), load(b)), r); }
+			static void mul(const bitblock<nbits>& a, const bitblock<nbits>& b, bitblock<nbits>& r) { store(mul(load(a), load(b)), r); }
+			static void div(const bitblock<nbits>& a, const bitblock<nbits>& b, bitblock<nbits>& r) { store(div(load(a), load(b)), r); }
+			static void sqrt(const bitblock<nbits>& a, bitblock<nbits>& r) { store(sqrt(load(a)), r); }
+			// round (-1)^sign * hi.lo * 2^(scale - 127), a 128-bit significand with the hidden bit at bit 63 of hi, onto the posit;
+			// sticky flags any nonzero bits below the significand
+			static void encode(bool sign, int scale, uint64_t hi, uint64_t lo, bool sticky, bitblock<nbits>& r) {
+				limbs significand = zero();
+				significand[nrLimbs - 1] = hi;
+				significand[nrLimbs - 2] = lo;
+				store(encode(sign, scale, significand, sticky), r);
+			}
+
+		private:
+			static limbs upper_half(const std::array<uint64_t, 2 * nrLimbs>& x) {
+				limbs r;
+				for (size_t i = 0; i < nrLimbs; ++i) r[i] = x[i + nrLimbs];
+				return r;
+			}
+			static bool lower_half_nonzero(const std::array<uint64_t, 2 * nrLimbs>& x) {
+				for (size_t i = 0; i < nrLimbs; ++i) if (x[i]) return true;
+				return false;
+			}
+
+			// Knuth's Algorithm D with 64-bit digits: q = u / v, returning true when the remainder is nonzero
+			// v must be normalized, that is, carry its top bit, and u is consumed as the running remainder
+			static bool long_division(std::array<uint64_t, 2 * nrLimbs>& u, const limbs& v, std::array<uint64_t, nrLimbs + 1>& q) {
+				constexpr size_t n = nrLimbs;
+				std::array<uint64_t, 2 * n + 1> r;
+				for (size_t i = 0; i < 2 * n; ++i) r[i] = u[i];
+				r[2 * n] = 0;
+				for (size_t j = n + 1; j-- > 0; ) {
+					// estimate the quotient digit from the top two digits of the remainder and the top digit of v
+					uint64_t qhat, rhat, c = 0;
+					bool rhatOverflow = false;
+					if (r[j + n] >= v[n - 1]) {
+						qhat = ~uint64_t(0);
+						rhat = addcarry(r[j + n - 1], v[n - 1], c);
+						rhatOverflow = (c != 0);
+					}
+					else {
+						qhat = div128(r[j + n], r[j + n - 1], v[n - 1], rhat);
+					}
+					while (!rhatOverflow) {
+						uint64_t phi;
+						uint64_t plo = mul128(qhat, v[n - 2], phi);
+						if (phi < rhat || (phi == rhat && plo <= r[j + n - 2])) break;
+						--qhat;
+						c = 0;
+						rhat = addcarry(rhat, v[n - 1], c);
+						rhatOverflow = (c != 0);
+					}
+					// multiply and subtract, adding back once when the estimate was still one too large
+					uint64_t carry = 0, borrow = 0;
+					for (size_t i = 0; i < n; ++i) {
+						uint64_t phi;
+						c = 0;
+						uint64_t plo = addcarry(mul128(qhat, v[i], phi), carry, c);
+						carry = phi + c;
+						r[i + j] = subborrow(r[i + j], plo, borrow);
+					}
+					r[j + n] = subborrow(r[j + n], carry, borrow);
+					if (borrow) {
+						--qhat;
+						c = 0;
+						for (size_t i = 0; i < n; ++i) r[i + j] = addcarry(r[i + j], v[i], c);
+						r[j + n] += c;
+					}
+					q[j] = qhat;
+				}
+				for (size_t i = 0; i < 2 * n; ++i) u[i] = r[i];
+				return !limb_is_zero<2 * n + 1>(r.data());
+			}
+
+			// floor(sqrt(radicand)) for radicands in [2^(128*nrLimbs - 2), 2^(128*nrLimbs)),
+			// with inexact set when the remainder is nonzero
+			static limbs isqrt(const std::array<uint64_t, 2 * nrLimbs>& radicand, bool& inexact) {
+				constexpr size_t n = nrLimbs;
+				// the root of the top 128 bits, rounded up, bounds the root from above
+				uint64_t top = sqrt128(radicand[2 * n - 1], radicand[2 * n - 2], inexact);
+				limbs r = zero();
+				if (top == ~uint64_t(0)) {
+					r.fill(~uint64_t(0));
+				}
+				else {
+					r[n - 1] = top + 1;
+				}
+				// Newton's iteration descends monotonically onto the floor of the root
+				for (;;) {
+					std::array<uint64_t, 2 * n> u = radicand;
+					std::array<uint64_t, n + 1> q;
+					long_division(u, r, q);
+					std::array<uint64_t, n + 1> next;
+					uint64_t c = 0;
+					for (size_t i = 0; i < n; ++i) next[i] = addcarry(r[i], q[i], c);
+					next[n] = q[n] + c;
+					limb_shift_right<n + 1>(next.data(), 1);
+					if (next[n] != 0) break;
+					limbs candidate;
+					for (size_t i = 0; i < n; ++i) candidate[i] = next[i];
+					if (limb_compare<n>(candidate.data(), r.data()) >= 0) break;
+					r = candidate;
+				}
+				std::array<uint64_t, 2 * n> square;
+				limb_multiply<n>(r.data(), r.data(), square.data());
+				inexact = (square != radicand);
+				return r;
+			}
+		};
+
+		// configurations that fit in a machine word use native_arithmetic, others keep using the value<> pipeline
+		template<size_t nbits, size_t es>
+		struct limb_arithmetic<nbits, es, false> {
+			static constexpr bool enabled = false;
+			static void add(const bitblock<nbits>&, const bitblock<nbits>&, bitblock<nbits>&) {}
+			static void sub(const bitblock<nbits>&, const bitblock<nbits>&, bitblock<nbits>&) {}
+			static void mul(const bitblock<nbits>&, const bitblock<nbits>&, bitblock<nbits>&) {}
+			static void div(const bitblock<nbits>&, const bitblock<nbits>&, bitblock<nbits>&) {}
+			static void sqrt(const bitblock<nbits>&, bitblock<nbits>&) {}
+			static void encode(bool, int, uint64_t, uint64_t, bool, bitblock<nbits>&) {}
+			static void decode(const bitblock<nbits>&, bool&, int&, uint64_t&, uint64_t&, bool&) {}
+			template<typename Real>
+			static Real to_native(const bitblock<nbits>&) { return Real(0); }
+		};
+
+	} // namespace unum
+
+} // namespace sw
@@ -178,11 +178,32 @@ namespace sw {
 			return vsqrt;
 		}
 
+		// the correctly rounded sqrt of the native and limb engines, shared by both sqrt implementations below:
+		// returns false when no engine handles the configuration, or when sqrt is traced
+		template<size_t nbits, size_t es>
+		inline bool engine_sqrt(const posit<nbits, es>& a, posit<nbits, es>& p) {
+#if POSIT_FAST_NATIVE_ARITHMETIC
+			if (_trace_sqrt) return false;
+			if (native_arithmetic<nbits, es>::enabled) {
+				p.set_raw_bits(native_arithmetic<nbits, es>::sqrt(a.encoding()));
+				return true;
+			}
+			if (limb_arithmetic<nbits, es>::enabled) {
+				bitblock<nbits> raw;
+				limb_arithmetic<nbits, es>::sqrt(a.get(), raw);
+				p.set(raw);
+				return true;
+			}
+#endif
+			return false;
+		}
+
 #if POSIT_NATIVE_SQRT
 		// sqrt for arbitrary posit
 		template<size_t nbits, size_t es>
 		inline posit<nbits, es> sqrt(const posit<nbits, es>& a) {
 			posit<nbits, es> p;
+			if (engine_sqrt(a, p)) return p;
 			if (a.isneg() || a.isnar()) {
 				p.setnar();
 				return p;
@@ -201,6 +222,8 @@ namespace sw {
 #else
 		template<size_t nbits, size_t es>
 		inline posit<nbits, es> sqrt(const posit<nbits, es>& a) {
+			posit<nbits, es> p;
+			if (engine_sqrt(a, p)) return p;
 			return posit<nbits, es>(std::sqrt((long double)a));
 		}
 #endif
@@ -0,0 +1,398 @@
+#pragma once
+// native_arithmetic.hpp: posit arithmetic on the integer encoding of posits that fit in a machine word
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <utility>
+#include "../bitblock/limb_functions.hpp"
+
+// enable/disable the native integer arithmetic of posit<nbits,es> with nbits <= 64 and es <= 4
+// when set, the generic posit operators +,-,*,/, sqrt, and the fused operators fma, fam, and fmma bypass the value<> pipeline
+// and operate directly on the encoding with integer instructions
+#if !defined(POSIT_FAST_NATIVE_ARITHMETIC)
+// default is to enable it
+#define POSIT_FAST_NATIVE_ARITHMETIC 1
+#endif
+
+namespace sw {
+	namespace unum {
+
+		// native_arithmetic implements the posit operators on the encoding held in a 64-bit word.
+		// Operands are decoded into (sign, scale, significand) with clz-based regime extraction,
+		// the exact result is carried in two limbs plus a sticky bit, and rounded once with
+		// round-to-nearest-even onto the posit. Results are bit-identical to the value<> pipeline,
+		// including the projection of out-of-range results onto minpos/maxpos.
+		template<size_t nbits, size_t es, bool fits = (nbits > 2 && nbits <= 64 && es <= 4)>
+		struct native_arithmetic {
+			static constexpr bool enabled = true;
+			static constexpr uint64_t mask = (nbits == 64 ? ~uint64_t(0) : (uint64_t(1) << (nbits % 64)) - 1);
+			static constexpr uint64_t nar = uint64_t(1) << (nbits - 1);
+			static constexpr uint64_t maxpos = nar - 1;
+			static constexpr uint64_t minpos = 1;
+			static constexpr int max_scale = (int(nbits) - 2) * (1 << es);
+
+			// decode a posit encoding into sign, scale, and a significand with the hidden bit at bit 63
+			static void decode(uint64_t bits, bool& sign, int& scale, uint64_t& significand) {
+				sign = (bits & nar) != 0;
+				if (sign) bits = (~bits + 1) & mask;
+				uint64_t x = bits << (65 - nbits);   // drop the sign bit: regime starts at bit 63
+				int run, k;
+				if (x >> 63) {
+					run = nlz(~x);
+					k = run - 1;
+				}
+				else {
+					run = nlz(x);
+					k = -run;
+				}
+				x = (run < 63 ? x << (run + 1) : 0);   // drop the regime and its terminating bit
+				int e = 0;
+				if (es > 0) {
+					e = int(x >> ((64 - es) % 64));
+					x <<= es;
+				}
+				scale = k * (1 << es) + e;
+				significand = (uint64_t(1) << 63) | (x >> 1);
+			}
+
+			// round (-1)^sign * 1.fraction * 2^scale to the nearest posit; significand holds the hidden bit at bit 63,
+			// and sticky flags any nonzero bits of the exact result below the significand
+			static uint64_t encode(bool sign, int scale, uint64_t significand, bool sticky) {
+				uint64_t bits;
+				if (scale > max_scale) {
+					bits = maxpos;
+				}
+				else if (scale < -max_scale) {
+					bits = minpos;
+				}
+				else {
+					int k = (scale >= 0 ? scale >> es : -((-scale + (1 << es) - 1) >> es));
+					uint64_t e = uint64_t(scale - k * (1 << es));
+					int run;
+					uint64_t word;   // regime, exponent, and fraction bits left-aligned
+					if (k >= 0) {
+						run = k + 1;
+						word = ~uint64_t(0) << (64 - run);
+					}
+					else {
+						run = -k;
+						word = uint64_t(1) << (63 - run);
+					}
+					int rlen = run + 1;
+					uint64_t fraction = significand << 1;
+					uint64_t tail = fraction;
+					if (es > 0) {
+						sticky |= (fraction & ((uint64_t(1) << es) - 1)) != 0;
+						tail = (e << ((64 - es) % 64)) | (fraction >> es);
+					}
+					if (rlen < 64) {
+						word |= tail >> rlen;
+						sticky |= (tail << (64 - rlen)) != 0;
+					}
+					else {
+						sticky |= tail != 0;
+					}
+					bits = word >> (65 - nbits);
+					bool guard = ((word >> (64 - nbits)) & 1) != 0;
+					sticky |= (word & ((uint64_t(1) << (64 - nbits)) - 1)) != 0;
+					if (guard && (sticky || (bits & 1))) ++bits;
+				}
+				return (sign ? (~bits + 1) & mask : bits);
+			}
+
+			// round (-1)^sign * 1.fraction * 2^scale onto the posit grid and keep the result decoded.
+			// Where the encoding still holds all exponent bits the fraction is rounded in place,
+			// the regime dominated extremes round through the encoding.
+			static void round(int& scale, uint64_t& significand, bool sticky) {
+				if (scale > max_scale) {
+					scale = max_scale;
+					significand = uint64_t(1) << 63;
+					return;
+				}
+				if (scale < -max_scale) {
+					scale = -max_scale;
+					significand = uint64_t(1) << 63;
+					return;
+				}
+				int k = (scale >= 0 ? scale >> es : -((-scale + (1 << es) - 1) >> es));
+				int run = (k >= 0 ? k + 1 : -k);
+				int nf = int(nbits) - 2 - run - int(es);   // fraction bits left after the sign, regime, and exponent
+				if (nf >= 0) {
+					unsigned lsb = unsigned(63 - nf);          // nf <= nbits - 3, so the guard bit is always inside the word
+					uint64_t guard = uint64_t(1) << (lsb - 1);
+					uint64_t rest = significand & ((guard << 1) - 1);
+					significand -= rest;
+					// ties round to an even encoding: without fraction bits the last bit is an exponent or regime bit
+					bool odd;
+					if (nf > 0) {
+						odd = ((significand >> lsb) & 1) != 0;
+					}
+					else {
+						odd = (es > 0 ? ((scale - k * (1 << es)) & 1) != 0 : k < 0);
+					}
+					if ((rest & guard) && (sticky || (rest & (guard - 1)) || odd)) {
+						significand += uint64_t(1) << lsb;
+						if (significand == 0) {
+							significand = uint64_t(1) << 63;
+							++scale;
+						}
+					}
+					return;
+				}
+				bool s;
+				decode(encode(false, scale, significand, sticky), s, scale, significand);
+			}
+
+			// exact operations on decoded operands: the result is (-1)^sign * significand * 2^(scale - 63)
+			// with the hidden bit at bit 63, and sticky flags any nonzero bits of the exact result below the significand
+
+			// returns false when the sum is exactly zero
+			static bool add_exact(bool sa, int ea, uint64_t ma, bool sb, int eb, uint64_t mb, bool& sign, int& scale, uint64_t& significand, bool& sticky) {
+				return add_wide(sa, ea, ma, 0, sb, eb, mb, 0, sign, scale, significand, sticky);
+			}
+
+			// add two 128-bit significands with the hidden bit at bit 127 and at least one trailing zero bit,
+			// such as the exact products of mul_wide; returns false when the sum is exactly zero
+			static bool add_wide(bool sa, int ea, uint64_t ahi, uint64_t alo, bool sb, int eb, uint64_t bhi, uint64_t blo, bool& sign, int& scale, uint64_t& significand, bool& sticky) {
+				if (eb > ea || (eb == ea && (bhi > ahi || (bhi == ahi && blo > alo)))) {
+					std::swap(sa, sb);
+					std::swap(ea, eb);
+					std::swap(ahi, bhi);
+					std::swap(alo, blo);
+				}
+				// a 128-bit frame with a carry bit above the hidden bit
+				alo = (alo >> 1) | (ahi << 63);
+				ahi >>= 1;
+				blo = (blo >> 1) | (bhi << 63);
+				bhi >>= 1;
+				unsigned shift = unsigned(ea - eb);
+				if (shift >= 128) {
+					bhi = 0;
+					blo = 1;   // sticky: b lies entirely below the rounding position
+				}
+				else if (shift >= 64) {
+					unsigned s = shift - 64;
+					blo = (s ? (bhi >> s) | uint64_t(((bhi << (64 - s)) | blo) != 0) : bhi | uint64_t(blo != 0));
+					bhi = 0;
+				}
+				else if (shift > 0) {
+					blo = (blo >> shift) | (bhi << (64 - shift)) | uint64_t((blo << (64 - shift)) != 0);
+					bhi >>= shift;
+				}
+				uint64_t hi, lo, c = 0;
+				if (sa == sb) {
+					lo = addcarry(alo, blo, c);
+					hi = addcarry(ahi, bhi, c);
+				}
+				else {
+					lo = subborrow(alo, blo, c);
+					hi = subborrow(ahi, bhi, c);
+					if (hi == 0 && lo == 0) return false;
+				}
+				int lz = (hi ? nlz(hi) : 64 + nlz(lo));
+				uint64_t rest;
+				if (lz == 0) {
+					significand = hi;
+					rest = lo;
+				}
+				else if (lz < 64) {
+					significand = (hi << lz) | (lo >> (64 - lz));
+					rest = lo << lz;
+				}
+				else {
+					significand = lo << (lz - 64);
+					rest = 0;
+				}
+				sign = sa;
+				scale = ea + 1 - lz;
+				sticky = (rest != 0);
+				return true;
+			}
+
+			// the exact product as a 128-bit significand with the hidden bit at bit 127
+			static void mul_wide(bool sa, int ea, uint64_t ma, bool sb, int eb, uint64_t mb, bool& sign, int& scale, uint64_t& hi, uint64_t& lo) {
+				lo = mul128(ma, mb, hi);
+				sign = (sa != sb);
+				scale = ea + eb;
+				if (hi >> 63) {
+					++scale;
+				}
+				else {
+					hi = (hi << 1) | (lo >> 63);
+					lo <<= 1;
+				}
+			}
+
+			// the exact product of two nonzero real encodings, as produced by mul_wide, for accumulation in a quire
+			static void product(uint64_t a, uint64_t b, bool& sign, int& scale, uint64_t& hi, uint64_t& lo) {
+				bool sa, sb;
+				int ea, eb;
+				uint64_t ma, mb;
+				decode(a, sa, ea, ma);
+				decode(b, sb, eb, mb);
+				mul_wide(sa, ea, ma, sb, eb, mb, sign, scale, hi, lo);
+			}
+
+			static void mul_exact(bool sa, int ea, uint64_t ma, bool sb, int eb, uint64_t mb, bool& sign, int& scale, uint64_t& significand, bool& sticky) {
+				uint64_t hi;
+				uint64_t lo = mul128(ma, mb, hi);
+				sign = (sa != sb);
+				scale = ea + eb;
+				if (hi >> 63) {
+					++scale;
+					significand = hi;
+					sticky = (lo != 0);
+				}
+				else {
+					significand = (hi << 1) | (lo >> 63);
+					sticky = ((lo << 1) != 0);
+				}
+			}
+
+			static void div_exact(bool sa, int ea, uint64_t ma, bool sb, int eb, uint64_t mb, bool& sign, int& scale, uint64_t& significand, bool& sticky) {
+				// (ma * 2^63) / mb lies in (2^62, 2^64)
+				uint64_t rem;
+				uint64_t q = div128(ma >> 1, ma << 63, mb, rem);
+				sign = (sa != sb);
+				scale = ea - eb;
+				if ((q >> 63) == 0) {
+					q <<= 1;
+					--scale;
+				}
+				significand = q;
+				sticky = (rem != 0);
+			}
+
+			static void sqrt_exact(int e, uint64_t m, int& scale, uint64_t& significand, bool& sticky) {
+				// radicand in [2^126, 2^128): an odd scale moves one factor of 2 into the significand
+				bool odd = (e & 1) != 0;
+				uint64_t hi = (odd ? m : m >> 1);
+				uint64_t lo = (odd ? 0 : m << 63);
+				significand = sqrt128(hi, lo, sticky);
+				scale = (e - int(odd)) / 2;
+			}
+
+			static uint64_t negate(uint64_t a) {
+				return (~a + 1) & mask;
+			}
+
+			static uint64_t add(uint64_t a, uint64_t b) {
+				if (a == nar || b == nar) return nar;
+				if (a == 0) return b;
+				if (b == 0) return a;
+				bool sa, sb, s, sticky;
+				int ea, eb, e;
+				uint64_t ma, mb, m;
+				decode(a, sa, ea, ma);
+				decode(b, sb, eb, mb);
+				if (!add_exact(sa, ea, ma, sb, eb, mb, s, e, m, sticky)) return 0;
+				return encode(s, e, m, sticky);
+			}
+
+			static uint64_t sub(uint64_t a, uint64_t b) {
+				return add(a, negate(b));
+			}
+
+			static uint64_t mul(uint64_t a, uint64_t b) {
+				if (a == nar || b == nar) return nar;
+				if (a == 0 || b == 0) return 0;
+				bool sa, sb, s, sticky;
+				int ea, eb, e;
+				uint64_t ma, mb, m;
+				decode(a, sa, ea, ma);
+				decode(b, sb, eb, mb);
+				mul_exact(sa, ea, ma, sb, eb, mb, s, e, m, sticky);
+				return encode(s, e, m, sticky);
+			}
+
+			static uint64_t div(uint64_t a, uint64_t b) {
+				if (a == nar || b == nar || b == 0) return nar;
+				if (a == 0) return 0;
+				bool sa, sb, s, sticky;
+				int ea, eb, e;
+				uint64_t ma, mb, m;
+				decode(a, sa, ea, ma);
+				decode(b, sb, eb, mb);
+				div_exact(sa, ea, ma, sb, eb, mb, s, e, m, sticky);
+				return encode(s, e, m, sticky);
+			}
+
+			static uint64_t sqrt(uint64_t a) {
+				if (a == 0) return 0;
+				if (a & nar) return nar;   // NaR and negative arguments
+				bool s, sticky;
+				int e;
+				uint64_t m;
+				decode(a, s, e, m);
+				sqrt_exact(e, m, e, m, sticky);
+				return encode(false, e, m, sticky);
+			}
+
+			// fused operators: the products and the sum are exact, and the result is rounded once
+
+			// a*b + c
+			static uint64_t fma(uint64_t a, uint64_t b, uint64_t c) {
+				if (a == nar || b == nar || c == nar) return nar;
+				if (a == 0 || b == 0) return c;
+				bool sa, sb, sc, s, sticky;
+				int ea, eb, ec, e;
+				uint64_t ma, mb, mc, hi, lo, m;
+				decode(a, sa, ea, ma);
+				decode(b, sb, eb, mb);
+				mul_wide(sa, ea, ma, sb, eb, mb, s, e, hi, lo);
+				if (c == 0) return encode(s, e, hi, lo != 0);
+				decode(c, sc, ec, mc);
+				if (!add_wide(s, e, hi, lo, sc, ec, mc, 0, s, e, m, sticky)) return 0;
+				return encode(s, e, m, sticky);
+			}
+
+			// a*b + c*d, or a*b - c*d when subtract is set
+			static uint64_t fmma(uint64_t a, uint64_t b, uint64_t c, uint64_t d, bool subtract) {
+				if (a == nar || b == nar || c == nar || d == nar) return nar;
+				bool zab = (a == 0 || b == 0), zcd = (c == 0 || d == 0);
+				if (zab && zcd) return 0;
+				if (zab) return (subtract ? negate(mul(c, d)) : mul(c, d));
+				if (zcd) return mul(a, b);
+				bool sa, sb, sc, sd, s1, s2, s, sticky;
+				int ea, eb, ec, ed, e1, e2, e;
+				uint64_t ma, mb, mc, md, hi1, lo1, hi2, lo2, m;
+				decode(a, sa, ea, ma);
+				decode(b, sb, eb, mb);
+				decode(c, sc, ec, mc);
+				decode(d, sd, ed, md);
+				mul_wide(sa, ea, ma, sb, eb, mb, s1, e1, hi1, lo1);
+				mul_wide(sc, ec, mc, sd, ed, md, s2, e2, hi2, lo2);
+				if (!add_wide(s1, e1, hi1, lo1, s2 != subtract, e2, hi2, lo2, s, e, m, sticky)) return 0;
+				return encode(s, e, m, sticky);
+			}
+
+			// (a + b)*c, evaluated exactly as a*c + b*c
+			static uint64_t fam(uint64_t a, uint64_t b, uint64_t c) {
+				return fmma(a, c, b, c, false);
+			}
+
+		};
+
+		// configurations that do not fit in a machine word keep using the value<> pipeline
+		template<size_t nbits, size_t es>
+		struct native_arithmetic<nbits, es, false> {
+			static constexpr bool enabled = false;
+			static uint64_t add(uint64_t, uint64_t) { return 0; }
+			static uint64_t sub(uint64_t, uint64_t) { return 0; }
+			static uint64_t mul(uint64_t, uint64_t) { return 0; }
+			static uint64_t div(uint64_t, uint64_t) { return 0; }
+			static uint64_t sqrt(uint64_t) { return 0; }
+			static uint64_t fma(uint64_t, uint64_t, uint64_t) { return 0; }
+			static uint64_t fmma(uint64_t, uint64_t, uint64_t, uint64_t, bool) { return 0; }
+			static uint64_t fam(uint64_t, uint64_t, uint64_t) { return 0; }
+			static void decode(uint64_t, bool&, int&, uint64_t&) {}
+			static uint64_t encode(bool, int, uint64_t, bool) { return 0; }
+			static void product(uint64_t, uint64_t, bool&, int&, uint64_t&, uint64_t&) {}
+		};
+
+	} // namespace unum
+
+} // namespace sw
@@ -9,7 +9,8 @@
 #include <cassert>
 #include <iostream>
 #include <limits>
-#include <regex>
+#include <algorithm>
+#include <string>
 
 // to yield a fast regression environment for productive development
 // we want to leverage the IEEE floating point hardware available on x86 and ARM.
@@ -68,6 +69,9 @@ typedef __128bitdd double_double;
 #include "exponent.hpp"
 #include "regime.hpp"
 #include "posit_functions.hpp"
+#include "native_arithmetic.hpp"
+#include "limb_arithmetic.hpp"
+#include "posit_parse.hpp"
 
 namespace sw {
 namespace unum {
@@ -144,77 +148,56 @@ bool check_inward_projection_range(int scale) {
 // how many shifts represent the regime?
 // regime = useed ^ k = (2 ^ (2 ^ es)) ^ k = 2 ^ (k*(2 ^ es))
 // scale  = useed ^ k * 2^e = k*(2 ^ es) + e 
+// The run is measured with a leading-zero count: complementing a run of 1's turns every regime into a run of 0's,
+// and the most significant set bit below the sign is the run's termination bit.
 template<size_t nbits>
 int decode_regime(const bitblock<nbits>& raw_bits) {
-	// let m be the number of identical bits in the regime
-	int m = 0;   // regime runlength counter
-	int k = 0;   // converted regime scale
-	if (raw_bits[nbits - 2] == 1) {   // run length of 1's
-		m = 1;   // if a run of 1's k = m - 1
-		int start = (nbits == 2 ? nbits - 2 : nbits - 3);
-		for (int i = start; i >= 0; --i) {
-			if (raw_bits[i] == 1) {
-				m++;
-			}
-			else {
-				break;
-			}
-		}
-		k = m - 1;
-	}
-	else {
-		m = 1;  // if a run of 0's k = -m
-		int start = (nbits == 2 ? nbits - 2 : nbits - 3);
-		for (int i = start; i >= 0; --i) {
-			if (raw_bits[i] == 0) {
-				m++;
-			}
-			else {
-				break;
-			}
-		}
-		k = -m;
-	}
-	return k;
+	bool r = raw_bits[nbits - 2];
+	bitblock<nbits> run = (r ? ones_complement(raw_bits) : raw_bits);
+	run.reset(nbits - 1);
+	int m = int(nbits) - 2 - findMostSignificantBit(run);   // regime runlength
+	return (r ? m - 1 : -m);
+}
+
+// decode_fields takes a raw posit encoding and extracts the sign, the regime k value, and the exponent and fraction bits
+// together with the number of bits each field occupies in the encoding. The exponent is left-aligned in its es bits,
+// and the fraction is left-aligned in fbits and right extended with 0's.
+// The regime run is found with decode_regime, and the exponent and fraction are moved into place with word-wide copies,
+// so the cost does not depend on the length of the regime.
+template<size_t nbits, size_t es, size_t fbits>
+inline void decode_fields(const bitblock<nbits>& raw_bits, bool& _sign, int& _k, size_t& nrRegimeBits, bitblock<es>& _exp, size_t& nrExponentBits, bitblock<fbits>& _frac, size_t& nrFractionBits) {
+	_sign = raw_bits[nbits - 1];
+	bitblock<nbits> tmp(raw_bits);
+	if (_sign) tmp = twos_complement(tmp);
+	_k = decode_regime(tmp);
+	int m = (_k < 0 ? -_k : _k + 1);
+	nrRegimeBits = (m < int(nbits) - 1 ? m + 1 : nbits - 1);   // the run and its termination bit, if there is room for it
+
+	// the exponent starts below the sign and regime bits
+	int msb = int(nbits) - 2 - int(nrRegimeBits);
+	nrExponentBits = (msb < 0 ? 0 : (msb >= int(es) - 1 ? es : msb + 1));
+	copy_window(tmp, (long long)msb + 1 - (long long)es, _exp);
+
+	// the fraction follows the exponent
+	msb -= int(nrExponentBits);
+	nrFractionBits = (msb < 0 ? 0 : msb + 1);
+	copy_window(tmp, (long long)msb + 1 - (long long)fbits, _frac);
 }
 
 // extract_fields takes a raw posit encoding and extracts the sign, regime, exponent, and fraction components
+// The max fraction is <nbits - 3 - es>, but we are setting it to <nbits - 3> and right-extent
+// The msb bit of the fraction represents 2^-1, the next 2^-2, etc.
+// If the fraction is empty, we have a fraction of nbits-3 0 bits
+// If the fraction is one bit, we have still have fraction of nbits-3, with the msb representing 2^-1, and the rest are right extended 0's
 template<size_t nbits, size_t es, size_t fbits>
 void extract_fields(const bitblock<nbits>& raw_bits, bool& _sign, regime<nbits, es>& _regime, exponent<nbits, es>& _exponent, fraction<fbits>& _fraction) {
-	bitblock<nbits> tmp(raw_bits);
-	_sign = raw_bits[nbits - 1];
-	if (_sign) tmp = twos_complement(tmp);
-	size_t nrRegimeBits = _regime.assign_regime_pattern(decode_regime(tmp));
-
-	// get the exponent bits
-	// start of exponent is nbits - (sign_bit + regime_bits)
-	int msb = int(static_cast<int>(nbits) - 1 - (1 + nrRegimeBits));
-	size_t nrExponentBits = 0;
-	if (es > 0) {
-		bitblock<es> _exp;
-		if (msb >= 0 && es > 0) {
-			nrExponentBits = (msb >= static_cast<int>(es) - 1 ? es : msb + 1);
-			for (size_t i = 0; i < nrExponentBits; i++) {
-				_exp[es - 1 - i] = tmp[msb - i];
-			}
-		}
-		_exponent.set(_exp, nrExponentBits);
-	}
-
-	// finally, set the fraction bits
-	// we do this so that the fraction is right extended with 0;
-	// The max fraction is <nbits - 3 - es>, but we are setting it to <nbits - 3> and right-extent
-	// The msb bit of the fraction represents 2^-1, the next 2^-2, etc.
-	// If the fraction is empty, we have a fraction of nbits-3 0 bits
-	// If the fraction is one bit, we have still have fraction of nbits-3, with the msb representing 2^-1, and the rest are right extended 0's
+	int k;
+	size_t nrRegimeBits, nrExponentBits, nrFractionBits;
+	bitblock<es> _exp;
 	bitblock<fbits> _frac;
-	msb = msb - int(nrExponentBits);
-	size_t nrFractionBits = (msb < 0 ? 0 : msb + 1);
-	if (msb >= 0) {
-		for (int i = msb; i >= 0; --i) {
-			_frac[fbits - 1 - (msb - i)] = tmp[i];
-		}
-	}
+	decode_fields(raw_bits, _sign, k, nrRegimeBits, _exp, nrExponentBits, _frac, nrFractionBits);
+	_regime.assign_regime_pattern(k);
+	if (es > 0) _exponent.set(_exp, nrExponentBits);
 	_fraction.set(_frac, nrFractionBits);
 }
 
@@ -258,7 +241,28 @@ void decode(const bitblock<nbits>& raw_bits, bool& _sign, regime<nbits, es>& _re
 	// so no need to transform back via 2's complement of regime/exponent/fraction
 }
 
+// decode takes the raw bits representing a posit and produces the sign, scale, and fraction of its value
+// without materializing the regime, exponent, and fraction components.
+// Zero and NaR decode to the scale of their all-zero regime, as the regime/exponent/fraction decode does.
+template<size_t nbits, size_t es, size_t fbits>
+inline void decode(const bitblock<nbits>& raw_bits, bool& _sign, int& _scale, bitblock<fbits>& _fraction) {
+	if (!anyAfter(raw_bits, int(nbits) - 2)) {
+		// special cases: zero and NaR
+		_sign = raw_bits[nbits - 1];
+		_scale = (_sign ? 1 : -1) * int(nbits - 1) * (1 << es);
+		_fraction.reset();
+		return;
+	}
+	int k;
+	size_t nrRegimeBits, nrExponentBits, nrFractionBits;
+	bitblock<es> _exp;
+	decode_fields(raw_bits, _sign, k, nrRegimeBits, _exp, nrExponentBits, _fraction, nrFractionBits);
+	_scale = k * (1 << es) + int(_exp.to_ulong());
+}
+
 // needed to avoid double rounding situations during arithmetic: TODO: does that mean the condensed version below should be removed?
+// The untruncated posit is assembled in a single bitblock: the fraction and the regime run are placed with word-wide
+// copies and shifts, so the cost does not depend on the length of the regime or the fraction.
 template<size_t nbits, size_t es, size_t fbits>
 inline bitblock<nbits>& convert_to_bb(bool _sign, int _scale, const bitblock<fbits>& fraction_in, bitblock<nbits>& ptt) {
 	if (_trace_conversion) std::cout << "------------------- CONVERT ------------------" << std::endl;
@@ -278,41 +282,36 @@ inline bitblock<nbits>& convert_to_bb(bool _sign, int _scale, const bitblock<fbi
 	else {
 		const size_t pt_len = nbits + 3 + es;
 		bitblock<pt_len> pt_bits;
-		bitblock<pt_len> regime;
-		bitblock<pt_len> exponent;
-		bitblock<pt_len> fraction;
-		bitblock<pt_len> sticky_bit;
 
 		bool s = _sign;
 		int e = _scale;
 		bool r = (e >= 0);
 
 		unsigned run = (r ? 1 + (e >> es) : -(e >> es));
-		regime.set(0, 1 ^ r);
-		for (unsigned i = 1; i <= run; i++) regime.set(i, r);
-
 		unsigned esval = e % (uint32_t(1) << es);
-		exponent = convert_to_bitblock<pt_len>(esval);
 		unsigned nf = (unsigned)std::max<int>(0, (nbits + 1) - (2 + run + es));
 		// TODO: what needs to be done if nf > fbits?
 		//assert(nf <= input_fbits);
-		// copy the most significant nf fraction bits into fraction
-		unsigned lsb = nf <= fbits ? 0 : nf - fbits;
-		for (unsigned i = lsb; i < nf; i++) fraction[i] = fraction_in[fbits - nf + i];
-
-		bool sb = anyAfter(fraction_in, fbits - 1 - nf);
 
 		// construct the untruncated posit
 		// pt    = BitOr[BitShiftLeft[reg, es + nf + 1], BitShiftLeft[esval, nf + 1], BitShiftLeft[fv, 1], sb];
-		regime <<= es + nf + 1;
-		exponent <<= nf + 1;
-		fraction <<= 1;
-		sticky_bit.set(0, sb);
-
-		pt_bits |= regime;
-		pt_bits |= exponent;
-		pt_bits |= fraction;
-		pt_bits |= sticky_bit;
+		// the most significant nf fraction bits land above the sticky bit
+		copy_window(fraction_in, (long long)fbits - (long long)nf - 1, pt_bits);
+		bool sb = anyAfter(fraction_in, fbits - 1 - nf);
+		pt_bits.set(0, sb);
+		for (unsigned i = 0; i < es; i++) if ((esval >> i) & 1) pt_bits.set(nf + 1 + i);
+		if (r) {
+			// a run of 1's followed by the 0 termination bit
+			bitblock<pt_len> regime;
+			regime.set();
+			regime >>= pt_len - run;
+			regime <<= es + nf + 2;
+			pt_bits |= regime;
+		}
+		else {
+			// a run of 0's followed by the 1 termination bit
+			pt_bits.set(es + nf + 1);
+		}
 
 		unsigned len = 1 + std::max<unsigned>((nbits + 1), (2 + run + es));
 		bool blast = pt_bits.test(len - nbits);
@@ -321,7 +320,6 @@ inline bitblock<nbits>& convert_to_bb(bool _sign, int _scale, const bitblock<fbi
 
 		bool rb = (blast & bafter) | (bafter & bsticky);
 
-
 		pt_bits <<= pt_len - len;
 		truncate(pt_bits, ptt);
 		if (rb) increment_bitset(ptt);
@@ -333,73 +331,8 @@ inline bitblock<nbits>& convert_to_bb(bool _sign, int _scale, const bitblock<fbi
 // needed to avoid double rounding situations during arithmetic: TODO: does that mean the condensed version below should be removed?
 template<size_t nbits, size_t es, size_t fbits>
 inline posit<nbits, es>& convert_(bool _sign, int _scale, const bitblock<fbits>& fraction_in, posit<nbits, es>& p) {
-	if (_trace_conversion) std::cout << "------------------- CONVERT ------------------" << std::endl;
-	if (_trace_conversion) std::cout << "sign " << (_sign ? "-1 " : " 1 ") << "scale " << std::setw(3) << _scale << " fraction " << fraction_in << std::endl;
-
-	p.clear();
-	// construct the posit
-	// interpolation rule checks
-	if (check_inward_projection_range<nbits, es>(_scale)) {    // regime dominated
-		if (_trace_conversion) std::cout << "inward projection" << std::endl;
-		// we are projecting to minpos/maxpos
-		int k = calculate_unconstrained_k<nbits, es>(_scale);
-		k < 0 ? p.set(minpos_pattern<nbits, es>(_sign)) : p.set(maxpos_pattern<nbits, es>(_sign));
-		// we are done
-		if (_trace_rounding) std::cout << "projection  rounding ";
-	}
-	else {
-		const size_t pt_len = nbits + 3 + es;
-		bitblock<pt_len> pt_bits;
-		bitblock<pt_len> regime;
-		bitblock<pt_len> exponent;
-		bitblock<pt_len> fraction;
-		bitblock<pt_len> sticky_bit;
-
-		bool s = _sign;
-		int e  = _scale;
-		bool r = (e >= 0);
-
-		unsigned run = (r ? 1 + (e >> es) : -(e >> es));
-		regime.set(0, 1 ^ r);
-		for (unsigned i = 1; i <= run; i++) regime.set(i, r);
-
-		unsigned esval = e % (uint32_t(1) << es);
-		exponent = convert_to_bitblock<pt_len>(esval);
-		unsigned nf = (unsigned)std::max<int>(0, (nbits + 1) - (2 + run + es));
-		// TODO: what needs to be done if nf > fbits?
-		//assert(nf <= input_fbits);
-		// copy the most significant nf fraction bits into fraction
-		unsigned lsb = nf <= fbits ? 0 : nf - fbits;
-		for (unsigned i = lsb; i < nf; i++) fraction[i] = fraction_in[fbits - nf + i];
-
-		bool sb = anyAfter(fraction_in, fbits - 1 - nf);
-
-		// construct the untruncated posit
-		// pt    = BitOr[BitShiftLeft[reg, es + nf + 1], BitShiftLeft[esval, nf + 1], BitShiftLeft[fv, 1], sb];
-		regime <<= es + nf + 1;
-		exponent <<= nf + 1;
-		fraction <<= 1;
-		sticky_bit.set(0, sb);
-
-		pt_bits |= regime;
-		pt_bits |= exponent;
-		pt_bits |= fraction;
-		pt_bits |= sticky_bit;
-
-		unsigned len = 1 + std::max<unsigned>((nbits + 1), (2 + run + es));
-		bool blast = pt_bits.test(len - nbits);
-		bool bafter = pt_bits.test(len - nbits - 1);
-		bool bsticky = anyAfter(pt_bits, len - nbits - 1 - 1);
-
-		bool rb = (blast & bafter) | (bafter & bsticky);
-
-		bitblock<nbits> ptt;
-		pt_bits <<= pt_len - len;
-		truncate(pt_bits, ptt);
-		if (rb) increment_bitset(ptt);
-		if (s) ptt = twos_complement(ptt);
-		p.set(ptt);
-	}
+	bitblock<nbits> ptt;
+	p.set(convert_to_bb<nbits, es, fbits>(_sign, _scale, fraction_in, ptt));
 	return p;
 }
 
@@ -484,53 +417,81 @@ posit<nbits, es>& construct(bool s, const regime<nbits, es>& r, const exponent<n
 }
 
 
-// read a posit ASCII format and make a memory posit out of it
-template<size_t nbits, size_t es>
-bool parse(std::string& txt, posit<nbits, es>& p) {
-	bool bSuccess = false;
-	// check if the txt is of the native posit form: nbits.esXhexvalue
-	std::regex posit_regex("[\\d]+\\.[012345][xX][\\w]+[p]*");
-	if (std::regex_match(txt, posit_regex)) {
-		// found a posit representation
-		std::string nbitsStr, esStr, bitStr;
-		auto it = txt.begin();
-		for (; it != txt.end(); it++) {
-			if (*it == '.') break;
-			nbitsStr.append(1, *it);
-		}
-		for (it++; it != txt.end(); it++) {
-			if (*it == 'x' || *it == 'X') break;
-			esStr.append(1, *it);
-		}
-		for (it++; it != txt.end(); it++) {
-			if (*it == 'p') break;
-			bitStr.append(1, *it);
-		}
-		size_t nbits_in = nbits;
-		{
-			std::istringstream ss(nbitsStr);
-			ss >> nbits_in;
+// round a scanned number onto the posit: the significand is exact up to its sticky bit, so the posit is rounded once
+template<size_t nbits, size_t es, size_t nrLimbs>
+inline posit<nbits, es>& round_scanned(scanned_number<nrLimbs>& number, posit<nbits, es>& p) {
+	// scales beyond the dynamic range project onto maxpos or minpos
+	constexpr long long max_scale = (long long)(nbits - 2) << es;
+	int scale = int(std::max(-max_scale - 1, std::min(max_scale + 1, number.scale)));
+	const big_unsigned<nrLimbs>& significand = number.significand;
+	int msb = significand.bits() - 1;
+#if POSIT_FAST_NATIVE_ARITHMETIC
+	if (native_arithmetic<nbits, es>::enabled && !_trace_conversion) {
+		bool sticky = number.sticky || significand.any_below(msb + 1 - 64);
+		p.set_raw_bits(native_arithmetic<nbits, es>::encode(number.sign, scale, significand.window(msb + 1), sticky));
+		return p;
+	}
+	// the 128-bit significand of the limb engine holds the rounding bit of the posit when it has at most 126 fraction bits
+	constexpr bool significand_fits = (es + 2 >= nbits || nbits - 3 - es <= 126);
+	if (limb_arithmetic<nbits, es>::enabled && significand_fits && !_trace_conversion) {
+		bool sticky = number.sticky || significand.any_below(msb + 1 - 128);
+		bitblock<nbits> raw_bits;
+		limb_arithmetic<nbits, es>::encode(number.sign, scale, significand.window(msb + 1), significand.window(msb + 1 - 64), sticky, raw_bits);
+		p.set(raw_bits);
+		return p;
+	}
+#endif
+	// the fraction bits below the hidden bit, of which the last collects the sticky bit
+	constexpr size_t fbits = (es + 2 >= nbits ? 0 : nbits - 3 - es) + 3;
+	bitblock<fbits> fraction;
+	for (int i = int(fbits) - 1, bit = msb - 1; i >= 0; --i, --bit) fraction[i] = significand.test(bit);
+	if (number.sticky || significand.any_below(msb - int(fbits))) fraction[0] = true;
+	return convert_<nbits, es, fbits>(number.sign, scale, fraction, p);
+}
+
+// read a posit from the characters [first, last): the posit format nbits.esxNN...NNp, a decimal number in fixed or
+// scientific notation, or nar. The posit format of another configuration and decimal numbers of any length are rounded
+// once onto the posit. As std::from_chars, it neither allocates nor skips whitespace: ptr points past the number,
+// or to first with ec set to std::errc::invalid_argument when there is no number, and p is only assigned on success.
+template<size_t nbits, size_t es>
+inline from_chars_result from_chars(const char* first, const char* last, posit<nbits, es>& p) {
+	scanned_number<scanner_limbs<nbits, es>()> number;
+	from_chars_result result = scan_number(first, last, nbits, es, number);
+	if (result.ec != std::errc()) return result;
+	switch (number.kind) {
+	case scanned_number<scanner_limbs<nbits, es>()>::zero:
+		p.setzero();
+		break;
+	case scanned_number<scanner_limbs<nbits, es>()>::nar:
+		p.setnar();
+		break;
+	case scanned_number<scanner_limbs<nbits, es>()>::encoding:
+		if (nbits <= 64) {
+			p.set_raw_bits(number.significand.limb(0));
 		}
-		unsigned long long raw;
-		std::istringstream ss(bitStr);
-		ss >> std::hex >> raw;
-		//std::cout << "[" << nbitsStr << "] [" << esStr << "] [" << bitStr << "] = " << raw << std::endl;
-		// if not aligned, set_raw_bits takes the least significant nbits, so we need to shift to pick up the most significant nbits
-		if (nbits < nbits_in) {
-			raw >>= (nbits_in - nbits);
+		else {
+			bitblock<nbits> raw_bits;
+			for (size_t i = 0; i < nbits; ++i) raw_bits[i] = number.significand.test(int(i));
+			p.set(raw_bits);
 		}
-		p.set_raw_bits(raw);  
-		bSuccess = true;
-	}
-	else {
-		// assume it is a float/double/long double representation
-		std::istringstream ss(txt);
-		double d;
-		ss >> d;
-		p = d;
-		bSuccess = true;
+		break;
+	case scanned_number<scanner_limbs<nbits, es>()>::finite:
+		round_scanned(number, p);
+		break;
 	}
-	return bSuccess;
+	return result;
+}
+
+// read a posit ASCII format and make a memory posit out of it: the text must hold a single number, see from_chars,
+// and p is left unchanged when it does not
+template<size_t nbits, size_t es>
+bool parse(const std::string& txt, posit<nbits, es>& p) {
+	const char* last = txt.data() + txt.size();
+	posit<nbits, es> v;
+	from_chars_result result = from_chars(txt.data(), last, v);
+	if (result.ec != std::errc() || result.ptr != last) return false;
+	p = v;
+	return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -576,121 +537,32 @@ public:
 	posit(const unsigned int initial_value)       { *this = initial_value; }
 	posit(const unsigned long initial_value)      { *this = initial_value; }
 	posit(const unsigned long long initial_value) { *this = initial_value; }
+#if defined(__SIZEOF_INT128__)
+	posit(const int128_native initial_value)      { *this = initial_value; }
+	posit(const uint128_native initial_value)     { *this = initial_value; }
+#endif
 	posit(const float initial_value)              { *this = initial_value; }
 	posit(const double initial_value)             { *this = initial_value; }
 	posit(const long double initial_value)        { *this = initial_value; }
 
 	// assignment operators for native types
-	posit& operator=(const signed char rhs) {
-		value<8*sizeof(signed char)-1> v(rhs);
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		else {
-			convert(v, *this);
-		}
-		return *this;
-	}
-	posit& operator=(const short rhs) {
-		value<8*sizeof(short)-1> v(rhs);
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		else {
-			convert(v, *this);
-		}
-		return *this;
-	}
-	posit& operator=(const int rhs) {
-		value<8*sizeof(int)-1> v(rhs);
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		else {
-			convert(v, *this);
-		}
-		return *this;
-	}
-	posit& operator=(const long rhs) {
-		value<8*sizeof(long)> v(rhs);
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		else {
-			convert(v, *this);
-		}
-		return *this;
-	}
-	posit& operator=(const long long rhs) {
-		value<8*sizeof(long long)-1> v(rhs);
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		else {
-			convert(v, *this);
-		}
-		return *this;
-	}
-	posit& operator=(const char rhs) {
-		value<8*sizeof(char)> v(rhs);
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		else {
-			convert(v, *this);
-		}
-		return *this;
-	}
-	posit& operator=(const unsigned short rhs) {
-		value<8*sizeof(unsigned short)> v(rhs);
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		else {
-			convert(v, *this);
-		}
-		return *this;
-	}
-	posit& operator=(const unsigned int rhs) {
-		value<8*sizeof(unsigned int)> v(rhs);
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		else {
-			convert(v, *this);
-		}
-		return *this;
-	}
-	posit& operator=(const unsigned long rhs) {
-		value<8*sizeof(unsigned long)> v(rhs);
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		else {
-			convert(v, *this);
-		}
-		return *this;
-	}
-	posit& operator=(const unsigned long long rhs) {
-		value<8*sizeof(unsigned long long)> v(rhs);
-		if (v.iszero()) {
-			setzero();
-			return *this;
-		}
-		else {
-			convert(v, *this);
-		}
-		return *this;
-	}
+	posit& operator=(const signed char rhs)        { return signed_assign(rhs); }
+	posit& operator=(const short rhs)              { return signed_assign(rhs); }
+	posit& operator=(const int rhs)                { return signed_assign(rhs); }
+	posit& operator=(const long rhs)               { return signed_assign(rhs); }
+	posit& operator=(const long long rhs)          { return signed_assign(rhs); }
+	posit& operator=(const char rhs)               { return signed_assign(rhs); }
+	posit& operator=(const unsigned short rhs)     { return integer_assign(false, 0, rhs); }
+	posit& operator=(const unsigned int rhs)       { return integer_assign(false, 0, rhs); }
+	posit& operator=(const unsigned long rhs)      { return integer_assign(false, 0, rhs); }
+	posit& operator=(const unsigned long long rhs) { return integer_assign(false, 0, rhs); }
+#if defined(__SIZEOF_INT128__)
+	posit& operator=(const int128_native rhs) {
+		uint128_native magnitude = (rhs < 0 ? uint128_native(0) - uint128_native(rhs) : uint128_native(rhs));
+		return integer_assign(rhs < 0, uint64_t(magnitude >> 64), uint64_t(magnitude));
+	}
+	posit& operator=(const uint128_native rhs)     { return integer_assign(false, uint64_t(rhs >> 64), uint64_t(rhs)); }
+#endif
 	posit& operator=(const float rhs) {
 		return float_assign(rhs);
 	}
@@ -748,6 +620,16 @@ public:
 		}
 		if (rhs.iszero()) return *this;
 
+#if POSIT_FAST_NATIVE_ARITHMETIC
+		if (native_arithmetic<nbits, es>::enabled && !_trace_add) {
+			_raw_bits = native_arithmetic<nbits, es>::add(encoding(), rhs.encoding());
+			return *this;
+		}
+		if (limb_arithmetic<nbits, es>::enabled && !_trace_add) {
+			limb_arithmetic<nbits, es>::add(_raw_bits, rhs._raw_bits, _raw_bits);
+			return *this;
+		}
+#endif
 		// arithmetic operation
 		value<abits + 1> sum;
 		value<fbits> a, b;
@@ -790,6 +672,16 @@ public:
 		}
 		if (rhs.iszero()) return *this;
 
+#if POSIT_FAST_NATIVE_ARITHMETIC
+		if (native_arithmetic<nbits, es>::enabled && !_trace_sub) {
+			_raw_bits = native_arithmetic<nbits, es>::sub(encoding(), rhs.encoding());
+			return *this;
+		}
+		if (limb_arithmetic<nbits, es>::enabled && !_trace_sub) {
+			limb_arithmetic<nbits, es>::sub(_raw_bits, rhs._raw_bits, _raw_bits);
+			return *this;
+		}
+#endif
 		// arithmetic operation
 		value<abits + 1> difference;
 		value<fbits> a, b;
@@ -832,6 +724,16 @@ public:
 			return *this;
 		}
 
+#if POSIT_FAST_NATIVE_ARITHMETIC
+		if (native_arithmetic<nbits, es>::enabled && !_trace_mul) {
+			_raw_bits = native_arithmetic<nbits, es>::mul(encoding(), rhs.encoding());
+			return *this;
+		}
+		if (limb_arithmetic<nbits, es>::enabled && !_trace_mul) {
+			limb_arithmetic<nbits, es>::mul(_raw_bits, rhs._raw_bits, _raw_bits);
+			return *this;
+		}
+#endif
 		// arithmetic operation
 		value<mbits> product;
 		value<fbits> a, b;
@@ -885,6 +787,16 @@ public:
 		if (iszero() || isnar()) {
 			return *this;
 		}
+#endif
+#if POSIT_FAST_NATIVE_ARITHMETIC
+		if (native_arithmetic<nbits, es>::enabled && !_trace_div) {
+			_raw_bits = native_arithmetic<nbits, es>::div(encoding(), rhs.encoding());
+			return *this;
+		}
+		if (limb_arithmetic<nbits, es>::enabled && !_trace_div) {
+			limb_arithmetic<nbits, es>::div(_raw_bits, rhs._raw_bits, _raw_bits);
+			return *this;
+		}
 #endif
 		value<divbits> ratio;
 		value<fbits> a, b;
@@ -1072,14 +984,7 @@ public:
 	}
 	// Set the raw bits of the posit given an unsigned value starting from the lsb. Handy for enumerating a posit state space
 	posit<nbits,es>& set_raw_bits(uint64_t value) {
-		clear();
-		bitblock<nbits> raw_bits;
-		uint64_t mask = 1;
-		for ( size_t i = 0; i < nbits; i++ ) {
-			raw_bits.set(i,(value & mask));
-			mask <<= 1;
-		}
-		_raw_bits = raw_bits;
+		_raw_bits = (unsigned long long)value;
 		return *this;
 	}
 	
@@ -1090,39 +995,39 @@ public:
 	explicit operator long long() const { return to_long_long(); }
 	explicit operator long() const { return to_long(); }
 	explicit operator int() const { return to_int(); }
-	explicit operator unsigned long long() const { return to_long_long(); }
-	explicit operator unsigned long() const { return to_long(); }
-	explicit operator unsigned int() const { return to_int(); }
+	explicit operator unsigned long long() const { return to_integer<unsigned long long, unsigned long long>(); }
+	explicit operator unsigned long() const { return to_integer<unsigned long, unsigned long>(); }
+	explicit operator unsigned int() const { return to_integer<unsigned int, unsigned int>(); }
+#if defined(__SIZEOF_INT128__)
+	explicit operator int128_native() const { return to_integer<int128_native, uint128_native>(); }
+	explicit operator uint128_native() const { return to_integer<uint128_native, uint128_native>(); }
+#endif
 
 	// currently, size is tied to fbits size of posit config. Is there a need for a case that captures a user-defined sized fraction?
 	value<fbits> to_value() const {
 		bool		     	 _sign;
-		regime<nbits, es>    _regime;
-		exponent<nbits, es>  _exponent;
-		fraction<fbits>      _fraction;
-		decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-		return value<fbits>(_sign, _regime.scale() + _exponent.scale(), _fraction.get(), iszero(), isnar());
+		int                  _scale;
+		bitblock<fbits>      _fraction;
+		decode<nbits, es, fbits>(_raw_bits, _sign, _scale, _fraction);
+		return value<fbits>(_sign, _scale, _fraction, iszero(), isnar());
 	}
 	void normalize(value<fbits>& v) const {
 		bool		     	 _sign;
-		regime<nbits, es>    _regime;
-		exponent<nbits, es>  _exponent;
-		fraction<fbits>      _fraction;
-		decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-		v.set(_sign, _regime.scale() + _exponent.scale(), _fraction.get(), iszero(), isnar());
+		int                  _scale;
+		bitblock<fbits>      _fraction;
+		decode<nbits, es, fbits>(_raw_bits, _sign, _scale, _fraction);
+		v.set(_sign, _scale, _fraction, iszero(), isnar());
 	}
 	template<size_t tgt_fbits>
 	void normalize_to(value<tgt_fbits>& v) const {
 		bool		     	 _sign;
-		regime<nbits, es>    _regime;
-		exponent<nbits, es>  _exponent;
-		fraction<fbits>      _fraction;
-		decode(_raw_bits, _sign, _regime, _exponent, _fraction);
+		int                  _scale;
+		bitblock<fbits>      _fraction;
+		decode<nbits, es, fbits>(_raw_bits, _sign, _scale, _fraction);
+		// align the most significant fraction bits, truncating or right extending with 0's
 		bitblock<tgt_fbits> _fr;
-		bitblock<fbits> _src = _fraction.get();
-		int tgt, src;
-		for (tgt = int(tgt_fbits) - 1, src = int(fbits) - 1; tgt >= 0 && src >= 0; tgt--, src--) _fr[tgt] = _src[src];
-		v.set(_sign, _regime.scale() + _exponent.scale(), _fr, iszero(), isnar());
+		copy_window(_fraction, (long long)fbits - (long long)tgt_fbits, _fr);
+		v.set(_sign, _scale, _fr, iszero(), isnar());
 	}
 	
 	// step up to the next posit in a lexicographical order
@@ -1148,43 +1053,19 @@ private:
 	// HELPER methods
 
 	// Conversion functions
-#if POSIT_THROW_ARITHMETIC_EXCEPTION
-	int         to_int() const {
-		if (iszero()) return 0;
-		if (isnar()) throw not_a_real{};
-		return int(to_float());
-	}
-	long        to_long() const {
-		if (iszero()) return 0;
-		if (isnar()) throw not_a_real{};
-		return long(to_double());
-	}
-	long long   to_long_long() const {
-		if (iszero()) return 0;
-		if (isnar()) throw not_a_real{};
-		return long(to_long_double());
-	}
-#else
-	int         to_int() const {
-		if (iszero()) return 0;
-		if (isnar()) return int(INFINITY);
-		return int(to_float());
-	}
-	long        to_long() const {
-		if (iszero()) return 0;
-		if (isnar()) return long(INFINITY);
-		return long(to_double());
-	}
-	long long   to_long_long() const {
-		if (iszero()) return 0;
-		if (isnar()) return (long long)(INFINITY);
-		return long(to_long_double());
-	}
-#endif
+	int         to_int() const       { return to_integer<int, unsigned int>(); }
+	long        to_long() const      { return to_integer<long, unsigned long>(); }
+	long long   to_long_long() const { return to_integer<long long, unsigned long long>(); }
 	float       to_float() const {
+#if POSIT_FAST_IEEE_CONVERSION
+		if (ieee_encoder<float>::enabled) return to_ieee<float>();
+#endif
 		return (float)to_double();
 	}
 	double      to_double() const {
+#if POSIT_FAST_IEEE_CONVERSION
+		if (ieee_encoder<double>::enabled) return to_ieee<double>();
+#endif
 		if (iszero())	return 0.0;
 		if (isnar())	return NAN;
 		bool		     	 _sign;
@@ -1199,6 +1080,9 @@ private:
 		return s * r * e * f;
 	}
 	long double to_long_double() const {
+#if POSIT_FAST_IEEE_CONVERSION
+		if (ieee_encoder<long double>::enabled) return to_ieee<long double>();
+#endif
 		if (iszero())  return 0.0;
 		if (isnar())   return NAN;
 		bool		     	 _sign;
@@ -1212,8 +1096,124 @@ private:
 		long double f = (1.0 + _fraction.value());
 		return s * r * e * f;
 	}
+	// decode the sign, the scale, and the top 128 bits of the significand, with the hidden bit at bit 63 of hi,
+	// and a sticky bit for the fraction bits below them
+	void decode_significand(bool& sign, int& scale, uint64_t& hi, uint64_t& lo, bool& sticky) const {
+#if POSIT_FAST_NATIVE_ARITHMETIC
+		if (native_arithmetic<nbits, es>::enabled) {
+			native_arithmetic<nbits, es>::decode(encoding(), sign, scale, hi);
+			lo = 0;
+			sticky = false;
+			return;
+		}
+		if (limb_arithmetic<nbits, es>::enabled) {
+			limb_arithmetic<nbits, es>::decode(_raw_bits, sign, scale, hi, lo, sticky);
+			return;
+		}
+#endif
+		bitblock<fbits> fraction;
+		decode<nbits, es>(_raw_bits, sign, scale, fraction);
+		hi = uint64_t(1) << 63;
+		lo = 0;
+		sticky = false;
+		for (int i = int(fbits) - 1, bit = 126; i >= 0; --i, --bit) {
+			if (!fraction[i]) continue;
+			if (bit >= 64) hi |= uint64_t(1) << (bit - 64);
+			else if (bit >= 0) lo |= uint64_t(1) << bit;
+			else sticky = true;
+		}
+	}
+	// assemble the IEEE bit pattern from the sign, scale, and fraction of the posit, rounding once to the precision of Real
+	template<typename Real>
+	Real to_ieee() const {
+		if (iszero()) return Real(0);
+		if (isnar()) return std::numeric_limits<Real>::quiet_NaN();
+		bool sign, sticky;
+		int scale;
+		uint64_t hi, lo;
+		decode_significand(sign, scale, hi, lo, sticky);
+		return ieee_encoder<Real>::encode(sign, scale, hi, lo, sticky);
+	}
+	// the integer part of the posit, truncated toward zero as the conversion of an IEEE value to an integer is.
+	// Values beyond the range of the integer saturate to its minimum or maximum, negative values to zero for
+	// unsigned integers, and NaR converts to the minimum of the integer, or throws when arithmetic exceptions are enabled.
+	// Magnitude is the unsigned integer of the same width.
+	template<typename Integer, typename Magnitude>
+	Integer to_integer() const {
+		if (iszero()) return Integer(0);
+		if (isnar()) {
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+			throw not_a_real{};
+#else
+			return std::numeric_limits<Integer>::min();
+#endif
+		}
+		bool sign, sticky;
+		int scale;
+		uint64_t hi, lo;
+		decode_significand(sign, scale, hi, lo, sticky);
+		return truncate_to_integer<Integer, Magnitude>(sign, scale, hi, lo);
+	}
+	// round (-1)^sign * hi.lo * 2^(scale - 127), a 128-bit significand with the hidden bit at bit 63 of hi, onto the posit
+	posit<nbits, es>& significand_assign(bool sign, int scale, uint64_t hi, uint64_t lo) {
+#if POSIT_FAST_NATIVE_ARITHMETIC
+		if (native_arithmetic<nbits, es>::enabled && !_trace_conversion) {
+			_raw_bits = native_arithmetic<nbits, es>::encode(sign, scale, hi, lo != 0);
+			return *this;
+		}
+		if (limb_arithmetic<nbits, es>::enabled && !_trace_conversion) {
+			limb_arithmetic<nbits, es>::encode(sign, scale, hi, lo, false, _raw_bits);
+			return *this;
+		}
+#endif
+		// the 127 bits below the hidden bit are the fraction of the generic rounding
+		bitblock<127> fraction;
+#if BITBLOCK_LIMB_ENGINE
+		fraction.setblock(0, lo);
+		fraction.setblock(1, hi);
+#else
+		for (size_t i = 0; i < 64; ++i) fraction[i] = ((lo >> i) & 1) != 0;
+		for (size_t i = 0; i < 63; ++i) fraction[64 + i] = ((hi >> i) & 1) != 0;
+#endif
+		return convert_<nbits, es, 127>(sign, scale, fraction, *this);
+	}
+	// integers are normalized into the significand and rounded once onto the posit
+	posit<nbits, es>& integer_assign(bool sign, uint64_t hi, uint64_t lo) {
+		if ((hi | lo) == 0) {
+			setzero();
+			return *this;
+		}
+		int scale;
+		uint64_t shi, slo;
+		ieee_normalize(hi, lo, 0, scale, shi, slo);
+		return significand_assign(sign, scale, shi, slo);
+	}
+	template<typename Integer>
+	posit<nbits, es>& signed_assign(Integer rhs) {
+		return integer_assign(rhs < 0, 0, (rhs < 0 ? uint64_t(0) - uint64_t(rhs) : uint64_t(rhs)));
+	}
 	template <typename T>
 	posit<nbits, es>& float_assign(const T& rhs) {
+#if POSIT_FAST_IEEE_CONVERSION
+		if (ieee_decoder<T>::enabled) {
+			// decode the IEEE fields from the bit pattern and round the significand onto the posit directly
+			bool sign;
+			int scale;
+			uint64_t hi, lo;
+			switch (ieee_decoder<T>::decode(rhs, sign, scale, hi, lo)) {
+			case FP_ZERO:
+				setzero();
+				return *this;
+			case FP_INFINITE:
+			case FP_NAN:
+				setnar();
+				return *this;
+			default:
+				break;
+			}
+			return significand_assign(sign, scale, hi, lo);
+		}
+#endif
 		constexpr int dfbits = std::numeric_limits<T>::digits - 1;
 		value<dfbits> v((T)rhs);
 
@@ -2572,9 +2572,12 @@ posit<nbits, es> maxpos() {
 
 // Atomic fused operators
 
+// The *_value variants return the unrounded result of the value<> pipeline;
+// fma, fam, and fmma round it once onto the posit.
+
 // FMA: fused multiply-add:  a*b + c
 template<size_t nbits, size_t es>
-value<1 + 2 * (nbits - es)> fma(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
+value<1 + 2 * (nbits - es)> fma_value(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
 	constexpr size_t fbits = nbits - 3 - es;
 	constexpr size_t fhbits = fbits + 1;      // size of fraction + hidden bit
 	constexpr size_t mbits = 2 * fhbits;      // size of the multiplier output
@@ -2623,41 +2626,132 @@ value<1 + 2 * (nbits - es)> fma(const posit<nbits, es>& a, const posit<nbits, es
 
 // FAM: fused add-multiply: (a + b) * c
 template<size_t nbits, size_t es>
-value<2 * (nbits - 2 - es)> fam(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
+value<2 * (nbits + 3 - es)> fam_value(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
 	constexpr size_t fbits = nbits - 3 - es;
 	constexpr size_t abits = fbits + 4;       // size of the addend
-	constexpr size_t fhbits = fbits + 1;      // size of fraction + hidden bit
-	constexpr size_t mbits = 2 * fhbits;      // size of the multiplier output
+	constexpr size_t mbits = 2 * (abits + 2); // size of the multiplier output: the sum carries abits + 1 fraction bits
 
 	value<fbits> va, vb;
-	value<abits+1> sum, vc;
+	value<abits + 1> sum, vc;
 	value<mbits> product;
 
-	// special case
+	// special case handling of input arguments
+	if (a.isnar() || b.isnar() || c.isnar()) {
+		product.setnan();
+		return product;
+	}
 	if (c.iszero()) return product;
 
 	// first the add
-	if (!a.iszero() || !b.iszero()) {
-		// transform the inputs into (sign,scale,fraction) triples
-		va.set(sign(a), scale(a), extract_fraction<nbits, es, fbits>(a), a.iszero(), a.isnar());;
-		vb.set(sign(b), scale(b), extract_fraction<nbits, es, fbits>(b), b.iszero(), b.isnar());;
-
-		module_add(va, vb, sum);    // multiply the two inputs
+	if (a.iszero() && b.iszero()) return product;
+	va.set(sign(a), scale(a), extract_fraction<nbits, es, fbits>(a), a.iszero(), a.isnar());
+	vb.set(sign(b), scale(b), extract_fraction<nbits, es, fbits>(b), b.iszero(), b.isnar());
+	if (a.iszero()) {
+		sum.template right_extend<fbits, abits + 1>(vb);
+	}
+	else if (b.iszero()) {
+		sum.template right_extend<fbits, abits + 1>(va);
+	}
+	else {
+		module_add<fbits, abits>(va, vb, sum);    // add the two inputs
 		if (sum.iszero()) return product;  // product is still zero
 	}
-	// second, the multiply		
-	vc.set(c.get_size(), scale(c), extract_fraction<nbits, es, fbits>(c), c.iszero(), c.isnar());
+	// second, the multiply
+	value<fbits> ctmp(sign(c), scale(c), extract_fraction<nbits, es, fbits>(c), c.iszero());
+	vc.template right_extend<fbits, abits + 1>(ctmp);
 	module_multiply(sum, vc, product);
 	return product;
 }
 
 // FMMA: fused multiply-multiply-add: (a * b) +/- (c * d)
 template<size_t nbits, size_t es>
-value<nbits> fmma(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c, const posit<nbits, es>& d, bool opIsAdd = true)
-{
-	// todo: implement
-	value<nbits> result;
-	return result;
+value<2 * (nbits - 2 - es) + 5> fmma_value(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c, const posit<nbits, es>& d, bool opIsAdd = true) {
+	constexpr size_t fbits = nbits - 3 - es;
+	constexpr size_t fhbits = fbits + 1;      // size of fraction + hidden bit
+	constexpr size_t mbits = 2 * fhbits;      // size of the multiplier output
+	constexpr size_t abits = mbits + 4;       // size of the addend
+
+	value<mbits> ab, cd;
+	value<abits + 1> sum;
+
+	// special case handling of input arguments
+	if (a.isnar() || b.isnar() || c.isnar() || d.isnar()) {
+		sum.setnan();
+		return sum;
+	}
+
+	bool ab_is_zero = a.iszero() || b.iszero();
+	bool cd_is_zero = c.iszero() || d.iszero();
+	if (!ab_is_zero) {
+		value<fbits> va(sign(a), scale(a), extract_fraction<nbits, es, fbits>(a), false);
+		value<fbits> vb(sign(b), scale(b), extract_fraction<nbits, es, fbits>(b), false);
+		module_multiply(va, vb, ab);
+	}
+	if (!cd_is_zero) {
+		value<fbits> vc(sign(c), scale(c), extract_fraction<nbits, es, fbits>(c), false);
+		value<fbits> vd(sign(d), scale(d), extract_fraction<nbits, es, fbits>(d), false);
+		module_multiply(vc, vd, cd);
+		if (!opIsAdd) cd = -cd;
+	}
+
+	if (ab_is_zero && cd_is_zero) {
+		sum.setzero();
+	}
+	else if (cd_is_zero) {
+		sum.template right_extend<mbits, abits + 1>(ab);
+	}
+	else if (ab_is_zero) {
+		sum.template right_extend<mbits, abits + 1>(cd);
+	}
+	else {
+		module_add<mbits, abits>(ab, cd, sum);
+	}
+	return sum;
+}
+
+// fused operators rounded once onto the posit. Configurations with a native integer engine,
+// including the fast specializations of posit<8,0>, posit<16,1>, and posit<32,2>, compute
+// the exact result on the encodings; the others round the result of the value<> pipeline.
+
+// a*b + c
+template<size_t nbits, size_t es>
+posit<nbits, es> fma(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
+	posit<nbits, es> p;
+#if POSIT_FAST_NATIVE_ARITHMETIC
+	if (native_arithmetic<nbits, es>::enabled) {
+		p.set_raw_bits(native_arithmetic<nbits, es>::fma(a.encoding(), b.encoding(), c.encoding()));
+		return p;
+	}
+#endif
+	return convert(fma_value(a, b, c), p);
+}
+
+// (a + b) * c
+template<size_t nbits, size_t es>
+posit<nbits, es> fam(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c) {
+	posit<nbits, es> p;
+#if POSIT_FAST_NATIVE_ARITHMETIC
+	if (native_arithmetic<nbits, es>::enabled) {
+		p.set_raw_bits(native_arithmetic<nbits, es>::fam(a.encoding(), b.encoding(), c.encoding()));
+		return p;
+	}
+#endif
+	// the sum a + b does not fit the adder when the scales are far apart: expand to a*c + b*c instead
+	return convert(fmma_value(a, c, b, c), p);
+}
+
+// (a * b) + (c * d), or (a * b) - (c * d) when opIsAdd is false:
+// a complex multiply or a 2x2 determinant with a single rounding
+template<size_t nbits, size_t es>
+posit<nbits, es> fmma(const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c, const posit<nbits, es>& d, bool opIsAdd = true) {
+	posit<nbits, es> p;
+#if POSIT_FAST_NATIVE_ARITHMETIC
+	if (native_arithmetic<nbits, es>::enabled) {
+		p.set_raw_bits(native_arithmetic<nbits, es>::fmma(a.encoding(), b.encoding(), c.encoding(), d.encoding(), !opIsAdd));
+		return p;
+	}
+#endif
+	return convert(fmma_value(a, b, c, d, opIsAdd), p);
 }
 
 }  // namespace unum
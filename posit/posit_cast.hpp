@@ -0,0 +1,90 @@
+#pragma once
+// posit_cast.hpp: conversion between posit configurations with a single rounding
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <vector>
+
+namespace sw {
+	namespace unum {
+
+/*
+ posit_cast re-encodes the sign, scale, and fraction of a posit in another configuration,
+ rounding once with round-to-nearest-even, without a detour through double or value<>:
+
+     posit<32,2> x;
+     posit<16,1> y = posit_cast<16,1>(x);                     // narrow
+     posit<64,3> z = posit_cast<64,3>(x);                     // widen, always exact
+     posit_cast(n, &A[j], lda, y.data(), 1);                  // convert a column of A into y
+     std::vector< posit<8,0> > v = posit_cast<8,0>(w);        // convert a vector
+
+ Zero and NaR map onto zero and NaR, and values beyond the dynamic range of the target
+ saturate to minpos or maxpos, as every posit rounding does.
+*/
+
+// convert a posit to another configuration: configurations with a native or limb engine exchange
+// a 128-bit significand and a sticky bit, others round the full fraction with convert_()
+template<size_t tnbits, size_t tes, size_t nbits, size_t es>
+inline posit<tnbits, tes> posit_cast(const posit<nbits, es>& p) {
+	posit<tnbits, tes> t;
+	if (p.iszero()) {
+		t.setzero();
+		return t;
+	}
+	if (p.isnar()) {
+		t.setnar();
+		return t;
+	}
+	constexpr size_t fbits = (es + 2 >= nbits ? 0 : nbits - 3 - es);
+#if POSIT_FAST_NATIVE_ARITHMETIC
+	constexpr size_t tfbits = (tes + 2 >= tnbits ? 0 : tnbits - 3 - tes);
+	constexpr bool source_engine = (native_arithmetic<nbits, es>::enabled || limb_arithmetic<nbits, es>::enabled);
+	constexpr bool target_engine = (native_arithmetic<tnbits, tes>::enabled || limb_arithmetic<tnbits, tes>::enabled);
+	// the 128-bit significand holds every source fraction bit, or the sticky bit lies below the rounding bit of the target
+	constexpr bool significand_fits = (fbits <= 127 || tfbits <= 126);
+	if (source_engine && target_engine && significand_fits && !_trace_conversion) {
+		bool sign, sticky = false;
+		int scale;
+		uint64_t hi, lo = 0;
+		if (native_arithmetic<nbits, es>::enabled) {
+			native_arithmetic<nbits, es>::decode(p.encoding(), sign, scale, hi);
+		}
+		else {
+			limb_arithmetic<nbits, es>::decode(p.get(), sign, scale, hi, lo, sticky);
+		}
+		if (native_arithmetic<tnbits, tes>::enabled) {
+			t.set_raw_bits(native_arithmetic<tnbits, tes>::encode(sign, scale, hi, lo != 0 || sticky));
+		}
+		else {
+			bitblock<tnbits> raw_bits;
+			limb_arithmetic<tnbits, tes>::encode(sign, scale, hi, lo, sticky, raw_bits);
+			t.set(raw_bits);
+		}
+		return t;
+	}
+#endif
+	bool sign;
+	int scale;
+	bitblock<fbits> fraction;
+	decode<nbits, es>(p.get(), sign, scale, fraction);
+	return convert_<tnbits, tes, fbits>(sign, scale, fraction, t);
+}
+
+// convert n elements of the strided array x to another configuration into the strided array y
+template<size_t tnbits, size_t tes, size_t nbits, size_t es>
+inline void posit_cast(size_t n, const posit<nbits, es>* x, size_t incx, posit<tnbits, tes>* y, size_t incy) {
+	for (size_t i = 0; i < n; ++i) y[i * incy] = posit_cast<tnbits, tes>(x[i * incx]);
+}
+
+// convert a vector of posits to another configuration
+template<size_t tnbits, size_t tes, size_t nbits, size_t es>
+inline std::vector< posit<tnbits, tes> > posit_cast(const std::vector< posit<nbits, es> >& x) {
+	std::vector< posit<tnbits, tes> > y(x.size());
+	posit_cast(x.size(), x.data(), 1, y.data(), 1);
+	return y;
+}
+
+	} // namespace unum
+
+} // namespace sw
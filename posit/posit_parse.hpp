@@ -0,0 +1,399 @@
+#pragma once
+// posit_parse.hpp: scanning of decimal and posit format text into an exact binary significand and scale
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <array>
+#include <string>
+#include <system_error>
+#include "../bitblock/limb_functions.hpp"
+
+namespace sw {
+	namespace unum {
+
+		// the result of from_chars, as std::from_chars_result of C++17: ptr points past the last character consumed
+		struct from_chars_result {
+			const char* ptr;
+			std::errc ec;
+		};
+
+		// unsigned integer of fixed capacity for the scanner: little-endian 64-bit limbs, of which the first size() are in use
+		template<size_t nrLimbs>
+		class big_unsigned {
+		public:
+			big_unsigned() : _size(0) {}
+
+			void clear() { _size = 0; }
+			void set(uint64_t hi, uint64_t lo) {
+				_limb[0] = lo;
+				_limb[1] = hi;
+				_size = 2;
+				trim();
+			}
+			bool iszero() const { return _size == 0; }
+			size_t size() const { return _size; }
+			uint64_t limb(size_t i) const { return (i < _size ? _limb[i] : 0); }
+			// number of significant bits
+			int bits() const { return (_size == 0 ? 0 : int(64 * _size) - nlz(_limb[_size - 1])); }
+			bool test(int i) const {
+				size_t w = size_t(i) / 64;
+				return (i >= 0 && w < _size && ((_limb[w] >> (i % 64)) & 1) != 0);
+			}
+			// true when any bit below position i is set
+			bool any_below(int i) const {
+				if (i <= 0) return false;
+				size_t w = size_t(i) / 64;
+				for (size_t j = 0; j < w && j < _size; ++j) if (_limb[j]) return true;
+				return (w < _size && (i % 64) != 0 && (_limb[w] << (64 - i % 64)) != 0);
+			}
+			// the 64 bits below position i, left aligned: bits [i - 64, i), with zeros below bit 0
+			uint64_t window(int i) const {
+				int lsb = i - 64;
+				if (lsb <= -64) return 0;
+				if (lsb < 0) return limb(0) << -lsb;
+				size_t w = size_t(lsb) / 64;
+				int shift = lsb % 64;
+				return (shift ? (limb(w) >> shift) | (limb(w + 1) << (64 - shift)) : limb(w));
+			}
+			bool set_bit(int i) {
+				size_t w = size_t(i) / 64;
+				if (w >= nrLimbs) return false;
+				while (_size <= w) _limb[_size++] = 0;
+				_limb[w] |= uint64_t(1) << (i % 64);
+				return true;
+			}
+			// keep the bits below position n
+			void mask(int n) {
+				size_t w = size_t(n) / 64;
+				if (w >= _size) return;
+				_size = w + 1;
+				_limb[w] &= (n % 64 ? (uint64_t(1) << (n % 64)) - 1 : 0);
+				trim();
+			}
+			// the two's complement of the n-bit integer
+			bool negate(int n) {
+				size_t w = size_t(n + 63) / 64;
+				if (w > nrLimbs) return false;
+				while (_size < w) _limb[_size++] = 0;
+				uint64_t carry = 1;
+				for (size_t i = 0; i < w; ++i) _limb[i] = addcarry(~_limb[i], 0, carry);
+				mask(n);
+				return true;
+			}
+			// *this = *this * m + a; returns false when the result exceeds the capacity
+			bool multiply_add(uint64_t m, uint64_t a) {
+				uint64_t carry = a;
+				for (size_t i = 0; i < _size; ++i) {
+					uint64_t hi, c = 0;
+					uint64_t lo = mul128(_limb[i], m, hi);
+					_limb[i] = addcarry(lo, carry, c);
+					carry = hi + c;
+				}
+				if (carry) {
+					if (_size == nrLimbs) return false;
+					_limb[_size++] = carry;
+				}
+				return true;
+			}
+			bool shift_left(int n) {
+				if (_size == 0 || n == 0) return true;
+				if (bits() + n > int(64 * nrLimbs)) return false;
+				size_t words = size_t(n) / 64;
+				int shift = n % 64;
+				size_t size = _size + words + 1;
+				if (size > nrLimbs) size = nrLimbs;
+				for (size_t i = size; i-- > words; ) {
+					uint64_t hi = (i - words < _size ? _limb[i - words] : 0);
+					uint64_t lo = (i - words >= 1 && i - words - 1 < _size ? _limb[i - words - 1] : 0);
+					_limb[i] = (shift ? (hi << shift) | (lo >> (64 - shift)) : hi);
+				}
+				for (size_t i = 0; i < words; ++i) _limb[i] = 0;
+				_size = size;
+				trim();
+				return true;
+			}
+			// shift right by n bits, dropping the bits that fall off the end
+			void shift_right(int n) {
+				size_t words = size_t(n) / 64;
+				int shift = n % 64;
+				if (words >= _size) {
+					_size = 0;
+					return;
+				}
+				for (size_t i = 0; i + words < _size; ++i) {
+					uint64_t lo = _limb[i + words];
+					uint64_t hi = (i + words + 1 < _size ? _limb[i + words + 1] : 0);
+					_limb[i] = (shift ? (lo >> shift) | (hi << (64 - shift)) : lo);
+				}
+				_size -= words;
+				trim();
+			}
+			// *this = *this / d, returns the remainder
+			uint64_t divide(uint64_t d) {
+				uint64_t r = 0;
+				for (size_t i = _size; i-- > 0; ) _limb[i] = div128(r, _limb[i], d, r);
+				trim();
+				return r;
+			}
+
+		private:
+			void trim() { while (_size > 0 && _limb[_size - 1] == 0) --_size; }
+
+			std::array<uint64_t, nrLimbs> _limb;
+			size_t _size;
+		};
+
+		// a number scanned from text before it is rounded onto a posit. A finite number has the value
+		// (-1)^sign * significand * 2^(scale - msb), with msb the most significant bit of the significand,
+		// and sticky flags the nonzero digits and bits below the significand.
+		// An encoding holds the bits of a posit of the requested configuration in the significand.
+		template<size_t nrLimbs>
+		struct scanned_number {
+			enum kind_t { zero, nar, finite, encoding };
+			kind_t kind;
+			bool sign;
+			long long scale;
+			bool sticky;
+			big_unsigned<nrLimbs> significand;
+		};
+
+		// number of 64-bit limbs the scanner needs to convert decimal numbers exactly over the dynamic range of posit<nbits, es>:
+		// the significant digits that can decide a rounding, and the power of five that divides them
+		template<size_t nbits, size_t es>
+		constexpr size_t scanner_limbs() {
+			return ((10 * nbits) / 3 + (233 * ((nbits - 2) << es)) / 100 + (10 << es) / 3 + 192) / 64 + 1;
+		}
+
+		inline bool is_digit(char c) { return (c >= '0' && c <= '9'); }
+		inline int hex_digit(char c) {
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return -1;
+		}
+		// case insensitive match of a lower case name at the start of [first, last)
+		inline bool match_name(const char* first, const char* last, const char* name) {
+			for (; *name; ++name, ++first) {
+				if (first == last || (*first | 0x20) != *name) return false;
+			}
+			return true;
+		}
+
+		// powers of ten that fit in a limb
+		inline uint64_t power_of_ten(int n) {
+			uint64_t p = 1;
+			while (n-- > 0) p *= 10;
+			return p;
+		}
+
+		// the posit format nbits.esxNN...NNp: the hex digits are the encoding of a posit<nbits, es>.
+		// The encoding of the requested configuration is returned as is, others are decoded into their exact value.
+		template<size_t nrLimbs>
+		from_chars_result scan_posit_format(const char* first, const char* last, size_t nbits, size_t es, scanned_number<nrLimbs>& number) {
+			const char* p = first;
+			unsigned long long nbits_in = 0, es_in = 0;
+			for (; p != last && is_digit(*p); ++p) nbits_in = (nbits_in < 100000000 ? 10 * nbits_in + unsigned(*p - '0') : nbits_in);
+			++p;   // the '.' the caller found
+			for (; p != last && is_digit(*p); ++p) es_in = (es_in < 100000000 ? 10 * es_in + unsigned(*p - '0') : es_in);
+			++p;   // the 'x' the caller found
+			big_unsigned<nrLimbs>& bits = number.significand;
+			bits.clear();
+			int d;
+			for (; p != last && (d = hex_digit(*p)) >= 0; ++p) {
+				if (!bits.shift_left(4) || !bits.multiply_add(1, uint64_t(d))) return { first, std::errc::result_out_of_range };
+			}
+			if (p != last && *p == 'p') ++p;
+			if (nbits_in < 2 || es_in > 30 || bits.bits() > int(nbits_in)) return { first, std::errc::invalid_argument };
+			if (nbits_in > 64 * nrLimbs) return { first, std::errc::result_out_of_range };
+			int n = int(nbits_in);
+			number.sign = false;
+			number.sticky = false;
+			if (nbits_in == nbits && es_in == es) {
+				number.kind = scanned_number<nrLimbs>::encoding;
+				return { p, std::errc() };
+			}
+			if (bits.iszero()) {
+				number.kind = scanned_number<nrLimbs>::zero;
+				return { p, std::errc() };
+			}
+			number.sign = bits.test(n - 1);
+			if (number.sign) {
+				bits.negate(n);
+				if (bits.iszero() || bits.test(n - 1)) {
+					// only the sign bit is set
+					number.kind = scanned_number<nrLimbs>::nar;
+					return { p, std::errc() };
+				}
+			}
+			// the regime is the run of identical bits after the sign bit, ended by the opposite bit
+			int i = n - 2;
+			bool r = bits.test(i);
+			int run = 0;
+			while (i >= 0 && bits.test(i) == r) {
+				++run;
+				--i;
+			}
+			--i;
+			long long e = 0;
+			for (unsigned long long j = 0; j < es_in; ++j, --i) e = 2 * e + (i >= 0 && bits.test(i) ? 1 : 0);
+			// the fraction bits below the exponent get their hidden bit
+			int fbits = (i >= 0 ? i + 1 : 0);
+			bits.mask(fbits);
+			bits.set_bit(fbits);
+			number.kind = scanned_number<nrLimbs>::finite;
+			number.scale = (r ? run - 1 : -run) * (1ll << es_in) + e;
+			return { p, std::errc() };
+		}
+
+		// a decimal number in fixed or scientific notation: [+-]digits[.digits][(e|E)[+-]digits].
+		// Significant digits beyond the ones that can decide a rounding onto posit<nbits, es> are folded into
+		// the sticky bit, and values far outside the dynamic range are projected onto a scale beyond it.
+		template<size_t nrLimbs>
+		from_chars_result scan_decimal(const char* first, const char* last, size_t nbits, size_t es, scanned_number<nrLimbs>& number) {
+			const long long max_scale = (long long)(nbits - 2) << es;
+			// the exact decimal expansion of a rounding boundary of the posit has no more significant digits
+			const long long max_digits = (long long)nbits + (7 * max_scale) / 10 + (1ll << es) + 8;
+			const char* p = first;
+			number.sign = false;
+			if (p != last && (*p == '+' || *p == '-')) {
+				number.sign = (*p == '-');
+				++p;
+			}
+			big_unsigned<nrLimbs>& D = number.significand;
+			D.clear();
+			uint64_t chunk = 0;       // digits not yet multiplied into D
+			int chunk_digits = 0;
+			long long kept = 0;       // significant digits in D and the chunk
+			long long pending = 0;    // zeros after the last kept digit
+			long long position = 0;   // digits read
+			long long point = -1;     // digits read before the decimal point
+			long long last_kept = 0;  // position of the last kept digit
+			bool sticky = false;
+			bool any_digit = false;
+			for (; p != last; ++p) {
+				if (*p == '.' && point < 0) {
+					point = position;
+					continue;
+				}
+				if (!is_digit(*p)) break;
+				any_digit = true;
+				++position;
+				int digit = *p - '0';
+				if (digit == 0) {
+					if (kept > 0) ++pending;
+					continue;
+				}
+				if (kept + pending + 1 > max_digits) {
+					sticky = true;
+					continue;
+				}
+				// append the pending zeros and the digit
+				for (long long z = 0; z <= pending; ++z) {
+					chunk = 10 * chunk + (z == pending ? uint64_t(digit) : 0);
+					if (++chunk_digits == 19) {
+						if (!D.multiply_add(power_of_ten(19), chunk)) return { first, std::errc::result_out_of_range };
+						chunk = 0;
+						chunk_digits = 0;
+					}
+				}
+				kept += pending + 1;
+				pending = 0;
+				last_kept = position;
+			}
+			if (!any_digit) return { first, std::errc::invalid_argument };
+			if (point < 0) point = position;
+			// the exponent is consumed only when it has digits
+			long long exponent = 0;
+			if (p != last && (*p == 'e' || *p == 'E')) {
+				const char* q = p + 1;
+				bool negative = false;
+				if (q != last && (*q == '+' || *q == '-')) {
+					negative = (*q == '-');
+					++q;
+				}
+				if (q != last && is_digit(*q)) {
+					for (; q != last && is_digit(*q); ++q) exponent = (exponent < 1000000000ll ? 10 * exponent + (*q - '0') : exponent);
+					if (negative) exponent = -exponent;
+					p = q;
+				}
+			}
+			if (kept == 0) {
+				number.kind = scanned_number<nrLimbs>::zero;
+				return { p, std::errc() };
+			}
+			if (chunk_digits > 0 && !D.multiply_add(power_of_ten(chunk_digits), chunk)) return { first, std::errc::result_out_of_range };
+			number.kind = scanned_number<nrLimbs>::finite;
+			number.sticky = sticky;
+			// the value is D * 10^E with D of kept digits, and lies in [10^d, 10^(d+1)) with d the decimal exponent of the leading digit
+			long long E = point - last_kept + exponent;
+			long long d = kept - 1 + E;
+			if (d * 100000 > 30103 * max_scale + 200000 || (d + 1) * 100000 < -(30103 * max_scale + 200000)) {
+				// beyond maxpos or below minpos by more than a factor 100
+				D.set(0, 1);
+				number.scale = (d > 0 ? max_scale + 2 : -(max_scale + 2));
+				return { p, std::errc() };
+			}
+			if (E >= 0) {
+				// exact: D * 5^E * 2^E
+				for (long long n = E; n > 0; n -= 27) {
+					uint64_t five = 1;
+					for (long long j = 0; j < (n < 27 ? n : 27); ++j) five *= 5;
+					if (!D.multiply_add(five, 0)) return { first, std::errc::result_out_of_range };
+				}
+				number.scale = D.bits() - 1 + E;
+				return { p, std::errc() };
+			}
+			// D / 5^m: align D so that the quotient has at least precision + 2 bits, folding any bits shifted out into
+			// the sticky bit, and divide by 5^27 at a time: the floor of successive floors is the floor of the quotient
+			long long m = -E;
+			int precision = int(nbits) + 1;
+			long long divisor_bits = (m * 2321929) / 1000000 + 2;   // 5^m has fewer than m log2(5) + 2 bits
+			long long s = precision + 2 + divisor_bits - D.bits();
+			if (s > 0) {
+				if (!D.shift_left(int(s))) return { first, std::errc::result_out_of_range };
+			}
+			else if (s < 0) {
+				number.sticky |= D.any_below(int(-s));
+				D.shift_right(int(-s));
+			}
+			for (long long n = m; n > 0; n -= 27) {
+				uint64_t five = 1;
+				for (long long j = 0; j < (n < 27 ? n : 27); ++j) five *= 5;
+				number.sticky |= (D.divide(five) != 0);
+			}
+			number.scale = D.bits() - 1 - s - m;
+			return { p, std::errc() };
+		}
+
+		// scan a posit format, a decimal number, or the names nar, nan, inf, and infinity, which are NaR
+		template<size_t nrLimbs>
+		from_chars_result scan_number(const char* first, const char* last, size_t nbits, size_t es, scanned_number<nrLimbs>& number) {
+			// the posit format starts with digits, a '.', digits, and an 'x' followed by a hex digit
+			const char* p = first;
+			while (p != last && is_digit(*p)) ++p;
+			if (p != first && p != last && *p == '.') {
+				const char* q = p + 1;
+				while (q != last && is_digit(*q)) ++q;
+				if (q != p + 1 && q != last && (*q == 'x' || *q == 'X') && q + 1 != last && hex_digit(q[1]) >= 0) {
+					from_chars_result result = scan_posit_format(first, last, nbits, es, number);
+					// text such as 1.5x3 is not a posit format: it holds the decimal number 1.5, which ends at the x
+					if (result.ec != std::errc::invalid_argument) return result;
+				}
+			}
+			p = first;
+			if (p != last && (*p == '+' || *p == '-')) ++p;
+			const char* names[] = { "infinity", "inf", "nar", "nan" };
+			for (const char* name : names) {
+				if (match_name(p, last, name)) {
+					number.kind = scanned_number<nrLimbs>::nar;
+					return { p + std::char_traits<char>::length(name), std::errc() };
+				}
+			}
+			return scan_decimal(first, last, nbits, es, number);
+		}
+
+	} // namespace unum
+
+} // namespace sw
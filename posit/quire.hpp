@@ -4,12 +4,16 @@
 // Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <vector>
 
 namespace sw {
 	namespace unum {
 
 // Forward definitions
 template<size_t nbits, size_t es, size_t capacity> class quire;
+template<size_t nbits, size_t es, size_t capacity> class deferred_quire;
+template<size_t nbits, size_t es, size_t capacity> class concurrent_quire;
 template<size_t nbits, size_t es, size_t capacity> quire<nbits, es, capacity> abs(const quire<nbits, es, capacity>& q);
 //template<size_t nbits, size_t es, size_t capacity> value<(size_t(1) << es)*(4*nbits-8)+capacity> abs(const quire<nbits, es, capacity>& q);
 
@@ -94,6 +98,12 @@ inline int min_scale() {
  All values in and out of the quire are normalized (sign, scale, fraction) triplets.
  Even though a quire is very strongly coupled to a posit configuration via the dynamic range
  a particular posit configuration exhibits, the class is designed to NOT depend on the posit<nbits,es> class definition.
+
+ The accumulator is a sign and a magnitude. The magnitude holds the lower, upper, and capacity segments,
+ least significant bit first, in a contiguous array of 64-bit limbs: bit i of the quire is bit i%64 of limb i/64.
+ An addend is shifted into the two or three limbs it covers, and the carry or borrow ripples up only until it is absorbed.
+ The quire tracks the window of limbs that have been populated, so resets, conversions, comparisons, and merges
+ only visit the scales a computation has actually reached, instead of the full width of a large quire.
  */
 template<size_t nbits, size_t es, size_t capacity = 30>
 class quire {
@@ -105,36 +115,40 @@ public:
 	// the upper is 1 bit bigger than the lower because maxpos^2 has that scale
 	static constexpr size_t upper_range = half_range + 1;     // size of the upper accumulator
 	static constexpr size_t qbits = range + capacity;		  // size of the quire minus the sign bit: we are managing the sign explicitly
-	
+	static constexpr size_t qlimbs = (qbits + 1 + 63) / 64;   // limbs holding the lower, upper, and capacity segments
+	static constexpr uint64_t top_mask = ((qbits + 1) % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << ((qbits + 1) % 64)) - 1);
+
 	// Constructors
-	quire() : _sign(false) { _capacity.reset(); _upper.reset(); _lower.reset(); }
+	quire() : _sign(false), _first(qlimbs), _last(0) {
+		for (size_t i = 0; i < qlimbs; ++i) _limb[i] = 0;
+	}
 
-	quire(int8_t initial_value) {
+	quire(int8_t initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(int16_t initial_value) {
+	quire(int16_t initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(int32_t initial_value) {
+	quire(int32_t initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(int64_t initial_value) {
+	quire(int64_t initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(uint64_t initial_value) {
+	quire(uint64_t initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(float initial_value) {
+	quire(float initial_value) : quire() {
 		*this = initial_value;
 	}
-	quire(double initial_value) {
+	quire(double initial_value) : quire() {
 		*this = initial_value;
 	}
 	template<size_t fbits>
-	quire(const value<fbits>& rhs) {
+	quire(const value<fbits>& rhs) : quire() {
 		*this = rhs;
 	}
-	quire(const posit<nbits, es>& rhs) {
+	quire(const posit<nbits, es>& rhs) : quire() {
 		*this = rhs;
 	}
 
@@ -157,36 +171,11 @@ public:
 		if (scale >  int(half_range)) 	throw operand_too_large_for_quire{};
 		if (scale < -int(half_range)) 	throw operand_too_small_for_quire{};
 
-		int i, f; // running bit pointers, i for the quire, f for the incoming fraction
-		sw::unum::bitblock<fbits+1> fraction = rhs.get_fixed_point();
-		// divide bits between upper and lower accumulator
-		if (scale - int(fbits) >= 0) {
-			// all upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-		}
-		else if (scale < 0) {
-			// all lower accumulator
-			for (i = half_range + scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
-		else {
-			// part upper, and part lower accumulator
-			// first assign the bits in the upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-			// next assign the bits in the lower accumulator
-			for (i = half_range - 1; i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
+		add_magnitude(rhs);
 		return *this;
 	}
 	quire& operator=(const posit<nbits, es>& rhs) {
-		*this = rhs.to_value();
+		*this = quire_value(rhs);
 		return *this;
 	}
 	quire& operator=(int8_t rhs) {
@@ -204,28 +193,13 @@ public:
 	quire& operator=(int64_t rhs) {
 		clear();
 		// transform to sign-magnitude
-		_sign = rhs & 0x8000000000000000;
-		unsigned long long magnitude;
-		magnitude = _sign ? -rhs : rhs;
+		_sign = rhs < 0;
+		unsigned long long magnitude = _sign ? 0ull - (unsigned long long)(rhs) : (unsigned long long)(rhs);
 		unsigned msb = findMostSignificantBit(magnitude);
 		if (msb > half_range + capacity) {
 			throw operand_too_large_for_quire{};
 		}
-		else {
-			// copy the value into the quire
-			unsigned i, c;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = magnitude & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = magnitude & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		add_word(magnitude, half_range);
 		return *this;
 	}
 	quire& operator=(unsigned long long rhs) {
@@ -234,21 +208,7 @@ public:
 		if (msb > half_range + capacity) {
 			throw operand_too_large_for_quire{};
 		}
-		else {
-			// copy the value into the quire
-			unsigned i, c;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = rhs & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = rhs & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		add_word(rhs, half_range);
 		return *this;
 	}
 	quire& operator=(float rhs) {
@@ -287,29 +247,9 @@ public:
 		// (+a) + (-b)                       -(b - a)    +(a - b)   +(a - b)
 		// (-a) + (+b)                       +(b - a)    +(a - b)   -(a - b)
 		// (-a) + (-b)      -(a + b)
-		if (_sign == rhs.sign()) {
-			add_value(rhs);
-			// _sign stays the same, so nothing new to assign
-		}
-		else {
-			// subtract magnitudes
-			int cmp = CompareMagnitude(rhs);
-			if (cmp < 0) {
-				// TODO: is there a way to NOT have to swap the whole quire?
-				value<qbits> subtractend = this->to_value();
-				*this = rhs;
-				subtract_value(subtractend);
-				_sign = rhs.sign();
-			}
-			else if (cmp > 0) {
-				subtract_value(rhs);
-				// _sign stays the same
-			}
-			else {
-				subtract_value(rhs);
-				_sign = false;
-			}
-		}
+		long long lsb = (long long)half_range + rhs.scale() - (long long)fbits;   // quire position of the lsb of the significand
+		bitblock<fbits> fraction = rhs.fraction();
+		accumulate(rhs.sign(), [&fraction](long long pos) { return significand_word(fraction, pos); }, lsb, size_t((long long)half_range + rhs.scale()) / 64);
 		return *this;
 	}
 	// Subtract a normalized value from the quire value
@@ -320,39 +260,74 @@ public:
 	
 	// add a posit directly (syntactic sugar)
 	quire& operator+=(const posit<nbits, es>& rhs) {
-		return operator+=(rhs.to_value());
+#if POSIT_FAST_NATIVE_ARITHMETIC
+		if (native_arithmetic<nbits, es>::enabled && !rhs.isnar()) {
+			if (rhs.iszero()) return *this;
+			bool sign;
+			int scale;
+			uint64_t significand;
+			native_arithmetic<nbits, es>::decode(rhs.encoding(), sign, scale, significand);
+			accumulate_significand(sign, scale, significand, 0);
+			return *this;
+		}
+#endif
+		return operator+=(quire_value(rhs));
 	}
 	// subtract a posit directly (syntactic sugar)
 	quire& operator-=(const posit<nbits, es>& rhs) {
-		return operator-=(rhs.to_value());
+		return operator+=(-rhs);
+	}
+
+	// accumulate the exact product a*b. Posits with a native integer engine, which includes the fast specializations
+	// of posit<8,0>, posit<16,1>, and posit<32,2>, multiply their significands into a 128-bit integer that is added
+	// to the limbs directly; the other configurations add the value<> product of quire_mul.
+	quire& add_product(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		return accumulate_product(a, b, false);
+	}
+	quire& subtract_product(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		return accumulate_product(a, b, true);
+	}
+
+	// add the integer v * 2^scale: used by the dot product kernels that accumulate products in fixed-point integers
+	quire& add_integer(int64_t v, int scale) {
+		if (v == 0) return *this;
+		bool sign = v < 0;
+		uint64_t magnitude = sign ? 0ull - uint64_t(v) : uint64_t(v);
+		long long lsb = (long long)half_range + scale;   // quire position of bit 0 of the integer
+		long long msb = lsb + 63 - nlz(magnitude);
+		if (msb > (long long)qbits) throw operand_too_large_for_quire{};
+		if (lsb + (long long)ntz(magnitude) < 0) throw operand_too_small_for_quire{};
+		accumulate(sign, [magnitude](long long pos) {
+			if (pos <= -64 || pos >= 64) return uint64_t(0);
+			return (pos < 0 ? magnitude << size_t(-pos) : magnitude >> size_t(pos));
+		}, lsb, size_t(msb) / 64);
+		return *this;
 	}
 
-	// add two quires
+	// add two quires: the magnitudes are merged limb by limb, so no bits of either quire are lost
 	quire& operator+=(const quire& q) {
-		return operator+=(q.to_value());
+		return merge(q, false);
 	}
 	// subtract two quires
 	quire& operator-=(const quire& q) {
-		return operator-=(q.to_value());
+		return merge(q, true);
 	}
 	
 	// bit addressing operator
 	bool operator[](int index) const {
-		if (index < int(radix_point)) return _lower[index];
-		if (index < int(radix_point) + int(upper_range)) return _upper[index - int(radix_point)];
-		if (index < int(radix_point) + int(upper_range) + int(capacity)) return _capacity[index - int(radix_point) - int(upper_range)];
-		throw "index out of range";
+		if (index < 0 || index >= int(qbits + 1)) throw "index out of range";
+		return bit(size_t(index));
 	}
 
 // Modifiers
 
 	// state management operators
-	// reset the state of a quire to zero
+	// reset the state of a quire to zero: only the populated limbs need to be cleared
 	void reset() {
 		_sign = false;
-		_lower.reset();
-		_upper.reset();
-		_capacity.reset();
+		for (size_t i = _first; i <= _last; ++i) _limb[i] = 0;
+		_first = qlimbs;
+		_last = 0;
 	}
 	// semantic sugar: clear the state of a quire to zero
 	void clear() { reset(); }
@@ -377,6 +352,8 @@ public:
 		else {
 			return false; // fail, wrong format
 		}
+		_first = 0;
+		_last = qlimbs - 1;
 		int segment = 0; // capacity segment = 0, upper segment = 1, lower segment = 2
 		int msb_c = capacity - 1;
 		int msb_u = upper_range - 1;
@@ -390,42 +367,99 @@ public:
 				if (msb_u != -1) return false; // fail, incorrect format
 				segment = 2;
 			}
-			else if (*it == '1') {
-				switch (segment) {
-				case 0:
-					_capacity.set(msb_c--);
-					break;
-				case 1:
-					_upper.set(msb_u--);
-					break;
-				case 2:
-					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.set(msb_l--);
-					break;
-				default:
-					return false; // fail, incorrect state
-				}
-			}
 			else {
+				bool b = (*it == '1');
 				switch (segment) {
 				case 0:
-					_capacity.reset(msb_c--);
+					if (msb_c < 0) return false; // fail, incorrect format
+					set_bit(half_range + upper_range + msb_c--, b);
 					break;
 				case 1:
-					_upper.reset(msb_u--);
+					if (msb_u < 0) return false; // fail, incorrect format
+					set_bit(half_range + msb_u--, b);
 					break;
 				case 2:
 					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.reset(msb_l--);
+					set_bit(msb_l--, b);
 					break;
 				default:
 					return false; // fail, incorrect state
 				}
 			}
 		}
+		trim();
 		return true;
 	}
 
+	// Binary encoding of the quire state, for checkpoints and for shipping partial sums between processes.
+	// The encoding is independent of the byte order of the host: a header of encoding_header bytes
+	//     'Q' 'R' version nbits[2] es capacity[2] sign first[4] count[4]
+	// followed by the count limbs of the populated window starting at limb first, 8 bytes each,
+	// all integers least significant byte first. A zero quire encodes as a header with count 0.
+	static constexpr size_t encoding_header = 17;
+	static constexpr uint8_t encoding_version = 1;
+	// number of bytes encode() writes for the current state
+	size_t encoded_size() const {
+		return encoding_header + (iszero() ? 0 : 8 * (_last - _first + 1));
+	}
+	// encode the quire into buffer[0, size), returns the number of bytes written
+	size_t encode(uint8_t* buffer, size_t size) const {
+		size_t bytes = encoded_size();
+		if (size < bytes) throw quire_encoding_error("buffer too small for the quire encoding");
+		size_t count = (bytes - encoding_header) / 8;
+		size_t first = (count ? _first : 0);
+		uint8_t* p = buffer;
+		*p++ = 'Q';
+		*p++ = 'R';
+		*p++ = encoding_version;
+		p = store_le(p, nbits, 2);
+		*p++ = uint8_t(es);
+		p = store_le(p, capacity, 2);
+		*p++ = (_sign ? 1 : 0);
+		p = store_le(p, first, 4);
+		p = store_le(p, count, 4);
+		for (size_t i = 0; i < count; ++i) p = store_le(p, _limb[first + i], 8);
+		return bytes;
+	}
+	std::vector<uint8_t> encode() const {
+		std::vector<uint8_t> buffer(encoded_size());
+		encode(buffer.data(), buffer.size());
+		return buffer;
+	}
+	// decode a quire from buffer[0, size), returns the number of bytes consumed.
+	// The encoding must come from a quire of the same configuration; the quire is unchanged when decoding fails
+	size_t decode(const uint8_t* buffer, size_t size) {
+		size_t count = decode_header(buffer, size);
+		size_t first = size_t(load_le(buffer + 9, 4));
+		if (size < encoding_header + 8 * count) throw quire_encoding_error("truncated quire encoding");
+		const uint8_t* p = buffer + encoding_header;
+		uint64_t limbs[qlimbs] = {};
+		for (size_t i = 0; i < count; ++i, p += 8) limbs[first + i] = load_le(p, 8);
+		if (limbs[qlimbs - 1] & ~top_mask) throw quire_encoding_error("quire encoding has bits beyond the capacity segment");
+		reset();
+		for (size_t i = 0; i < count; ++i) _limb[first + i] = limbs[first + i];
+		_sign = (buffer[8] != 0);
+		if (count) {
+			_first = first;
+			_last = first + count - 1;
+			trim();
+		}
+		if (iszero()) _sign = false;
+		return encoding_header + 8 * count;
+	}
+	// validate the header of an encoding against the configuration, returns the number of limbs that follow it
+	static size_t decode_header(const uint8_t* buffer, size_t size) {
+		if (size < encoding_header) throw quire_encoding_error("truncated quire encoding");
+		if (buffer[0] != 'Q' || buffer[1] != 'R' || buffer[2] != encoding_version) throw quire_encoding_error("not a quire encoding");
+		if (load_le(buffer + 3, 2) != nbits || buffer[5] != es || load_le(buffer + 6, 2) != capacity) {
+			throw quire_encoding_error("quire encoding of a different configuration");
+		}
+		if (buffer[8] > 1) throw quire_encoding_error("invalid sign in quire encoding");
+		uint64_t first = load_le(buffer + 9, 4), count = load_le(buffer + 13, 4);
+		if (first > qlimbs || count > qlimbs - first) throw quire_encoding_error("quire encoding has limbs beyond the capacity segment");
+		return size_t(count);
+	}
+
 // Selectors
 	
 	// Compare magnitudes between quire and value: returns -1 if q < v, 0 if q == v, and 1 if q > v
@@ -451,21 +485,13 @@ public:
 	inline size_t total_bits() const { return qbits + 1; }
 	inline bool isneg() const { return _sign; }
 	inline bool ispos() const { return _sign; }
-	inline bool iszero() const { return _capacity.none() && _upper.none() && _lower.none(); }
+	inline bool iszero() const {
+		for (size_t i = _first; i <= _last; ++i) if (_limb[i]) return false;
+		return true;
+	}
+	// scale of the most significant bit, -half_range - 1 for a zero quire
 	int scale() const {
-		int msb = int(capacity)-1; // indicative of no bits set
-		for (; msb >= 0; msb--) {
-			if (_capacity.test(msb)) break;
-		}
-		if (msb >= 0) return msb + upper_range;
-		for (msb = int(upper_range) - 1; msb >= 0; msb--) {
-			if (_upper.test(msb)) break;
-		}
-		if (msb >= 0) return msb;
-		for (int i = int(half_range) - 1; i >= 0; i--, msb--) {
-			if (_lower.test(i)) break;
-		}
-		return msb;
+		return msb() - int(half_range);
 	}
 
 	// Return value of the sign bit: true indicates a negative number, false a positive number or zero
@@ -473,303 +499,239 @@ public:
 	inline float sign_value() const {	return (_sign ? -1.0 : 1.0); }
 	bitblock<qbits+1> get() const {
 		bitblock<qbits+1> q;
-		int msb = 0;
-		for (int i = 0; i < half_range; i++) {
-			q[msb] = _lower[i];
-			msb++;
-		}
-		for (int i = 0; i < upper_range; i++) {
-			q[msb] = _upper[i];
-			msb++;
-		}
-		for (int i = 0; i < capacity; i++) {
-			q[msb] = _capacity[i];
-			msb++;
-		}
+#if BITBLOCK_LIMB_ENGINE
+		for (size_t i = _first; i <= _last; ++i) q.setblock(i, _limb[i]);
+#else
+		for (size_t i = 0; i < qbits + 1; ++i) q[i] = bit(i);
+#endif
 		return q;
 	}
 	value<qbits> to_value() const {
 		// find the MSB and build the fraction
 		bitblock<qbits> fraction;
-		bool isZero = false;
-		bool isNaR = false;   // TODO
-		int i;
-		int qbit = int(qbits);
-		int fbit = qbit - 1;
-		int scale = qbits;
-		for (i = int(capacity) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_capacity.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _capacity[i];
-			}
-		}
-		for (i = int(upper_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_upper.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _upper[i];
-			}
-		}
-		for (i = int(half_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_lower.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _lower[i];
-			}
-		}
-		if (scale == qbits) {
-			isZero = true;
-			scale = 0;
-		}
-		return value<qbits>(_sign, scale, fraction, isZero, isNaR);
+		int msbit = msb();
+		if (msbit < 0) return value<qbits>(_sign, 0, fraction, true, false);
+		// the fraction bits are the quire bits below the msb, left aligned in the qbits of the value
+		long long offset = (long long)msbit - (long long)qbits;
+#if BITBLOCK_LIMB_ENGINE
+		// only the blocks of the fraction that overlap the populated limbs can be nonzero
+		long long first_block = (64 * (long long)_first - 63 - offset) / 64;
+		for (size_t i = size_t(first_block < 0 ? 0 : first_block); i < bitblock<qbits>::nrBlocks; ++i) fraction.setblock(i, word_at(offset + (long long)(64 * i)));
+#else
+		for (size_t i = 0; i < qbits; ++i) fraction[i] = (offset + (long long)i >= 0 && bit(size_t(offset + (long long)i)));
+#endif
+		return value<qbits>(_sign, msbit - int(half_range), fraction, false, false);
 	}
 	bool anyAfter(int index) const {
-		for (int i = index; i >= 0; i--) {
-			if (this->operator[](i)) return true;
-		}
-		return false;
+		if (index < 0) return false;
+		if (index >= int(qbits)) return !iszero();
+		size_t top = size_t(index) / 64;
+		for (size_t i = _first; i < top; ++i) if (_limb[i]) return true;
+		uint64_t mask = (index % 64 == 63 ? ~uint64_t(0) : (uint64_t(1) << (index % 64 + 1)) - 1);
+		return (_limb[top] & mask) != 0;
 	}
 
 private:
 	bool				   _sign;
-	// segmented accumulator to demonstrate potential hw concurrency for high performance quires
-	bitblock<half_range>   _lower;
-	bitblock<upper_range>  _upper;
-	bitblock<capacity>     _capacity;
-
-	// add a value to the quire
+	size_t                 _first, _last;   // window of limbs that can be nonzero, empty when _first > _last
+	uint64_t               _limb[qlimbs];   // magnitude: lower segment at bit 0, then the upper and capacity segments
+
+	bool bit(size_t i) const { return ((_limb[i / 64] >> (i % 64)) & 1) != 0; }
+	void set_bit(size_t i, bool b) {
+		uint64_t mask = uint64_t(1) << (i % 64);
+		if (b) _limb[i / 64] |= mask; else _limb[i / 64] &= ~mask;
+	}
+	// position of the most significant bit of the magnitude, -1 when the quire is zero
+	int msb() const {
+		for (size_t i = _last + 1; i-- > _first; ) {
+			if (_limb[i]) return int(64 * i) + 63 - nlz(_limb[i]);
+		}
+		return -1;
+	}
+	// little-endian byte order of the binary encoding
+	static uint8_t* store_le(uint8_t* p, uint64_t v, size_t bytes) {
+		for (size_t i = 0; i < bytes; ++i, v >>= 8) *p++ = uint8_t(v);
+		return p;
+	}
+	static uint64_t load_le(const uint8_t* p, size_t bytes) {
+		uint64_t v = 0;
+		for (size_t i = bytes; i-- > 0; ) v = (v << 8) | p[i];
+		return v;
+	}
+	// grow the window of populated limbs to include [first, last]
+	void widen(size_t first, size_t last) {
+		if (first < _first) _first = first;
+		if (last > _last) _last = last;
+	}
+	// shrink the window of populated limbs to the nonzero limbs
+	void trim() {
+		while (_first <= _last && _limb[_first] == 0) ++_first;
+		if (_first > _last) {
+			_first = qlimbs;
+			_last = 0;
+			return;
+		}
+		while (_limb[_last] == 0) --_last;
+	}
+	// the 64 bits of the magnitude starting at bit position lsb, zero-filled outside of the limbs
+	uint64_t word_at(long long lsb) const {
+		if (lsb <= -64 || lsb >= (long long)(64 * qlimbs)) return 0;
+		if (lsb < 0) return _limb[0] << size_t(-lsb);
+		size_t i = size_t(lsb) / 64;
+		size_t shift = size_t(lsb) % 64;
+		uint64_t lo = _limb[i] >> shift;
+		if (shift == 0 || i + 1 >= qlimbs) return lo;
+		return lo | (_limb[i + 1] << (64 - shift));
+	}
+	// the 64 bits of the fixed-point significand 1.fraction starting at bit position lsb of the significand
 	template<size_t fbits>
-	void add_value(const value<fbits>& v) {
-		if (v.iszero()) return;
-		// scale is the location of the msb in the fixed point representation
-		// so scale  =  0 is the hidden bit at location 0, scale 1 = bit 1, etc.
-		// and scale = -1 is the first bit of the fraction
-		// we manage scale >= 0 in the _upper accumulator, and scale < 0 in the _lower accumulator
-		int lsb = v.scale() - int(fbits);
-		bool carry = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			int lsb = int(half_range) + v.scale() - int(fbits);
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// propagate any carries to the end of the lower accumulator
-			while (carry && i < int(half_range)) {
-				bool _a = _lower[i];
-				_lower[i] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			if (carry) {  // carry propagate to the _upper accumulator
-						  // need to increment the _upper
-				i = 0;
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-				if (carry) {
-					// next add the bits to the capacity segment
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ carry;
-						carry = carry & _a;
-						i++;
-					}
-				}
-			}
+	static uint64_t significand_word(const bitblock<fbits>& fraction, long long lsb) {
+#if BITBLOCK_LIMB_ENGINE
+		uint64_t w = fraction.block_at(lsb);
+#else
+		uint64_t w = 0;
+		for (long long i = 0; i < 64; ++i) {
+			long long pos = lsb + i;
+			if (pos >= 0 && pos < (long long)fbits && fraction[size_t(pos)]) w |= uint64_t(1) << i;
 		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			if (carry) {
-				// next add the bits to the capacity segment
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-			}
+#endif
+		long long hidden = (long long)fbits - lsb;
+		if (hidden >= 0 && hidden < 64) w |= uint64_t(1) << hidden;
+		return w;
+	}
+
+	// add a word to the magnitude at bit position lsb
+	void add_word(uint64_t w, size_t lsb) {
+		size_t first = lsb / 64;
+		size_t i = first;
+		size_t shift = lsb % 64;
+		uint64_t carry = 0;
+		_limb[i] = addcarry(_limb[i], w << shift, carry);
+		++i;
+		if (shift && i < qlimbs) {
+			_limb[i] = addcarry(_limb[i], w >> (64 - shift), carry);
+			++i;
+		}
+		for (; carry && i < qlimbs; ++i) _limb[i] = addcarry(_limb[i], 0, carry);
+		_limb[qlimbs - 1] &= top_mask;   // carries out of the capacity segment are lost
+		widen(first, i - 1);
+	}
+	// the 64 bits of a 128-bit significand hi.lo starting at bit position lsb
+	static uint64_t wide_word(uint64_t hi, uint64_t lo, long long lsb) {
+		if (lsb <= -64 || lsb >= 128) return 0;
+		if (lsb < 0) return lo << size_t(-lsb);
+		if (lsb == 0) return lo;
+		if (lsb < 64) return (lo >> size_t(lsb)) | (hi << size_t(64 - lsb));
+		return hi >> size_t(lsb - 64);
+	}
+
+	// add the magnitude of a value to the accumulator: bits below the lower segment are dropped
+	template<size_t fbits>
+	void add_magnitude(const value<fbits>& v) {
+		long long lsb = (long long)half_range + v.scale() - (long long)fbits;   // quire position of the lsb of the significand
+		bitblock<fbits> fraction = v.fraction();
+		add_words([&fraction](long long pos) { return significand_word(fraction, pos); }, lsb, size_t((long long)half_range + v.scale()) / 64);
+	}
+	// add (-1)^sign * hi.lo * 2^(scale - 127), a 128-bit significand with its hidden bit at bit 127, to the quire
+	void accumulate_significand(bool sign, int scale, uint64_t hi, uint64_t lo) {
+		if (scale > int(half_range)) throw operand_too_large_for_quire{};
+		if (scale < -int(half_range)) throw operand_too_small_for_quire{};
+		long long lsb = (long long)half_range + scale - 127;
+		accumulate(sign, [hi, lo](long long pos) { return wide_word(hi, lo, pos); }, lsb, size_t((long long)half_range + scale) / 64);
+	}
+	quire& accumulate_product(const posit<nbits, es>& a, const posit<nbits, es>& b, bool negate) {
+		if (a.isnar() || b.isnar()) throw operand_is_nar{};
+		if (a.iszero() || b.iszero()) return *this;
+#if POSIT_FAST_NATIVE_ARITHMETIC
+		if (native_arithmetic<nbits, es>::enabled) {
+			bool sign;
+			int scale;
+			uint64_t hi, lo;
+			native_arithmetic<nbits, es>::product(a.encoding(), b.encoding(), sign, scale, hi, lo);
+			accumulate_significand(sign != negate, scale, hi, lo);
+			return *this;
 		}
-		else {  // lsb < 0 && scale > 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// propagate any carries to the end of the upper accumulator
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			// next add the bits to the capacity segment
-			if (carry) {
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-			}
+#endif
+		return (negate ? operator-=(quire_mul(a, b)) : operator+=(quire_mul(a, b)));
+	}
+	// add or subtract a significand following the sign/magnitude classification of operator+=.
+	// word(pos) returns the 64 bits of the significand starting at bit position pos, which has its lsb at quire bit lsb
+	// and its msb in limb last
+	template<typename Significand>
+	void accumulate(bool sign, const Significand& word, long long lsb, size_t last) {
+		if (_sign == sign) {
+			add_words(word, lsb, last);
+			// _sign stays the same, so nothing new to assign
 		}
-	}
-	// subtract a value from the quire
-	template<size_t fbits>
-	void subtract_value(const value<fbits>& v) {
-		if (v.iszero()) return;
-		// lsb in the quire of the lowest bit of the explicit fixed point value including the hidden bit of the fraction
-		int lsb = v.scale() - int(fbits);
-		bool borrow = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			int lsb = int(half_range) + v.scale() - int(fbits);
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the lower accumulator
-			while (borrow && i < int(half_range)) {
-				bool _a = _lower[i];
-				_lower[i] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) { // borrow propagate to the _upper accumulator
-						  // need to decrement the _upper
-				i = 0;
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ borrow;
-						borrow = borrow & !_a;
-						i++;
-					}
-				}
-			}
+		else if (subtract_words(word, lsb, last)) {
+			// the addend was bigger: the magnitude has been negated into b - a
+			_sign = sign;
 		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-			}
+		else if (iszero()) {
+			_sign = false;
 		}
-		else {   // lsb < 0 && scale >= 0
-				 // part upper, and part lower accumulator
-				 // first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-			}
+	}
+	template<typename Significand>
+	void add_words(const Significand& word, long long lsb, size_t last) {
+		size_t first = (lsb > 0 ? size_t(lsb) / 64 : 0);
+		uint64_t carry = 0;
+		size_t i;
+		for (i = first; i <= last; ++i) _limb[i] = addcarry(_limb[i], word((long long)(64 * i) - lsb), carry);
+		for (; carry && i < qlimbs; ++i) _limb[i] = addcarry(_limb[i], 0, carry);
+		_limb[qlimbs - 1] &= top_mask;   // carries out of the capacity segment are lost
+		widen(first, i - 1);
+	}
+	// subtract a significand from the accumulator. When the significand is the bigger one, the borrow leaves
+	// the populated limbs and the magnitude is negated into significand - quire; returns true in that case
+	template<typename Significand>
+	bool subtract_words(const Significand& word, long long lsb, size_t last) {
+		size_t first = (lsb > 0 ? size_t(lsb) / 64 : 0);
+		uint64_t borrow = 0;
+		size_t i;
+		for (i = first; i <= last; ++i) _limb[i] = subborrow(_limb[i], word((long long)(64 * i) - lsb), borrow);
+		widen(first, last);
+		for (; borrow && i <= _last; ++i) _limb[i] = subborrow(_limb[i], 0, borrow);
+		if (borrow == 0) return false;
+		// the limbs above the window are zero in the difference value - quire
+		borrow = 0;
+		for (i = _first; i <= _last; ++i) _limb[i] = subborrow(0, _limb[i], borrow);
+		return true;
+	}
+
+	// add or subtract the full magnitude of another quire, following the same sign/magnitude classification as a value
+	quire& merge(const quire& q, bool negate) {
+		if (q.iszero()) return *this;
+		size_t i;
+		if (_sign == (q._sign != negate)) {
+			uint64_t carry = 0;
+			for (i = q._first; i <= q._last; ++i) _limb[i] = addcarry(_limb[i], q._limb[i], carry);
+			for (; carry && i < qlimbs; ++i) _limb[i] = addcarry(_limb[i], 0, carry);
+			_limb[qlimbs - 1] &= top_mask;   // carries out of the capacity segment are lost
+			widen(q._first, i - 1);
+			return *this;
+		}
+		uint64_t borrow = 0;
+		for (i = q._first; i <= q._last; ++i) _limb[i] = subborrow(_limb[i], q._limb[i], borrow);
+		widen(q._first, q._last);
+		for (; borrow && i <= _last; ++i) _limb[i] = subborrow(_limb[i], 0, borrow);
+		if (borrow) {
+			// q was the bigger magnitude: negate into q - this
+			borrow = 0;
+			for (i = _first; i <= _last; ++i) _limb[i] = subborrow(0, _limb[i], borrow);
+			_sign = (q._sign != negate);
+		}
+		else if (iszero()) {
+			_sign = false;
 		}
+		return *this;
 	}
 
 	// template parameters need names different from class template parameters (for gcc and clang)
 	template<size_t nnbits, size_t nes, size_t ncapacity>
+	friend class deferred_quire;
+	template<size_t nnbits, size_t nes, size_t ncapacity>
+	friend class concurrent_quire;
+	template<size_t nnbits, size_t nes, size_t ncapacity>
 	friend std::ostream& operator<< (std::ostream& ostr, const quire<nnbits,nes,ncapacity>& q);
 	template<size_t nnbits, size_t nes, size_t ncapacity>
 	friend std::istream& operator>> (std::istream& istr, quire<nnbits, nes, ncapacity>& q);
@@ -826,8 +788,36 @@ inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lh
 ////////////////// QUIRE stream operators
 template<size_t nbits, size_t es, size_t capacity>
 inline std::ostream& operator<<(std::ostream& ostr, const quire<nbits, es, capacity>& q) {
-	ostr << (q._sign ? "-:" : "+:") << q._capacity << "_" << q._upper << "." << q._lower;
-	return ostr;
+	typedef quire<nbits, es, capacity> Quire;
+	std::string bits;
+	bits.reserve(Quire::qbits + 5);
+	bits += (q._sign ? "-:" : "+:");
+	for (size_t i = Quire::qbits + 1; i-- > 0; ) {
+		if (i + 1 == Quire::half_range + Quire::upper_range) bits += '_';   // capacity_upper.lower
+		if (i + 1 == Quire::half_range) bits += '.';
+		bits += (q.bit(i) ? '1' : '0');
+	}
+	return ostr << bits;
+}
+
+// write the binary encoding of a quire to a stream
+template<size_t nbits, size_t es, size_t capacity>
+inline std::ostream& write_binary(std::ostream& ostr, const quire<nbits, es, capacity>& q) {
+	std::vector<uint8_t> buffer = q.encode();
+	return ostr.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+}
+// read the binary encoding of a quire from a stream: the failbit is set and the quire is unchanged
+// when the stream ends early, and a quire_encoding_error is thrown when the bytes are not a valid encoding
+template<size_t nbits, size_t es, size_t capacity>
+inline std::istream& read_binary(std::istream& istr, quire<nbits, es, capacity>& q) {
+	typedef quire<nbits, es, capacity> Quire;
+	std::vector<uint8_t> buffer(Quire::encoding_header);
+	if (!istr.read(reinterpret_cast<char*>(buffer.data()), std::streamsize(buffer.size()))) return istr;
+	size_t count = Quire::decode_header(buffer.data(), buffer.size());
+	buffer.resize(Quire::encoding_header + 8 * count);
+	if (!istr.read(reinterpret_cast<char*>(buffer.data() + Quire::encoding_header), std::streamsize(8 * count))) return istr;
+	q.decode(buffer.data(), buffer.size());
+	return istr;
 }
 
 template<size_t nbits, size_t es, size_t capacity>
@@ -837,7 +827,13 @@ inline std::istream& operator>> (std::istream& istr, const quire<nbits, es, capa
 }
 
 template<size_t nbits, size_t es, size_t capacity>
-inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
+inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
+	if (lhs._sign != rhs._sign) return false;
+	// outside of both windows the limbs are zero
+	size_t first = std::min(lhs._first, rhs._first), last = std::max(lhs._last, rhs._last);
+	for (size_t i = first; i <= last; ++i) if (lhs._limb[i] != rhs._limb[i]) return false;
+	return true;
+}
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator!=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
 template<size_t nbits, size_t es, size_t capacity>
@@ -847,14 +843,12 @@ inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits,
 		bSmaller = true;
 	}
 	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-			bSmaller = true;
+		size_t first = std::min(lhs._first, rhs._first), last = std::max(lhs._last, rhs._last);
+		for (size_t i = last + 1; i-- > first; ) {
+			if (lhs._limb[i] != rhs._limb[i]) {
+				bSmaller = lhs._limb[i] < rhs._limb[i];
+				break;
+			}
 		}
 	}
 	return bSmaller;
@@ -977,6 +971,17 @@ value<nbits - es + 2> quire_add(const posit<nbits, es>& lhs, const posit<nbits,
 	return sum;
 }
 
+// posit value to be added to the quire, for generic and specialized posits alike
+template<size_t nbits, size_t es>
+value<nbits - 3 - es> quire_value(const posit<nbits, es>& p) {
+	static constexpr size_t fbits = nbits - 3 - es;
+	value<fbits> v;  // constructs to zero value
+	if (p.isnar()) { v.setinf(); return v; }
+	if (p.iszero()) return v;
+	v.set(sign(p), scale(p), extract_fraction<nbits, es, fbits>(p), false, false);
+	return v;
+}
+
 // unrounded posit multiplication to be added to the quire
 template<size_t nbits, size_t es>
 value<2 * (nbits - 2 - es)> quire_mul(const posit<nbits, es>& lhs, const posit<nbits, es>& rhs) {
@@ -12,6 +12,12 @@
 // For example, POSIT_FAST_POSIT_8_0, when set to 1, will enable the fast implementation of posit<8,0>.
 // The individual POSIT_FAST_### macros enable fine grain control over which configurations
 // use fast code.
+//
+// Configurations without a dedicated specialization that have nbits <= 64 and es <= 4,
+// such as posit<10,1>, posit<24,1>, or posit<48,2>, are selected by native_arithmetic<nbits,es>
+// and run their arithmetic operators on the integer encoding. Configurations with nbits > 64
+// and es <= 5, such as posit<80,2>, are selected by limb_arithmetic<nbits,es> and run on 64-bit limbs.
+// POSIT_FAST_NATIVE_ARITHMETIC set to 0 reverts them to the value<> pipeline.
 #ifdef POSIT_FAST_SPECIALIZATION
 #define POSIT_FAST_POSIT_2_0   1
 #define POSIT_FAST_POSIT_3_0   1
@@ -20,9 +26,9 @@
 #define POSIT_FAST_POSIT_8_0   1
 #define POSIT_FAST_POSIT_16_1  1
 #define POSIT_FAST_POSIT_32_2  1
-#define POSIT_FAST_POSIT_64_3  0
-#define POSIT_FAST_POSIT_128_4 0
-#define POSIT_FAST_POSIT_256_5 0
+#define POSIT_FAST_POSIT_64_3  1
+#define POSIT_FAST_POSIT_128_4 1
+#define POSIT_FAST_POSIT_256_5 1
 #endif
 
 // fast specializations for special posit configurations
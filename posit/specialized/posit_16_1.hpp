@@ -436,7 +436,8 @@ namespace sw {
 			return tmp;
 		}
 		posit reciprocate() const {
-			posit p = 1.0 / *this;
+			posit p(1.0);
+			p /= *this;
 			return p;
 		}
 		// SELECTORS
@@ -548,6 +549,27 @@ namespace sw {
 
 		template <typename T>
 		posit& float_assign(const T& rhs) {
+#if POSIT_FAST_IEEE_CONVERSION
+			if (ieee_decoder<T>::enabled) {
+				// decode the IEEE fields from the bit pattern and round the significand onto the posit directly
+				bool sign;
+				int scale;
+				uint64_t hi, lo;
+				switch (ieee_decoder<T>::decode(rhs, sign, scale, hi, lo)) {
+				case FP_ZERO:
+					setzero();
+					return *this;
+				case FP_INFINITE:
+				case FP_NAN:
+					setnar();
+					return *this;
+				default:
+					break;
+				}
+				_bits = uint16_t(native_arithmetic<NBITS_IS_16, ES_IS_1>::encode(sign, scale, hi, lo != 0));
+				return *this;
+			}
+#endif
 			constexpr int dfbits = std::numeric_limits<T>::digits - 1;
 			value<dfbits> v((T)rhs);
 
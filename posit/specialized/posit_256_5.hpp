@@ -13,6 +13,9 @@ namespace sw {
 #pragma message("Fast specialization of posit<256,5>")
 
 	// fast specialized posit<256,5>
+	// The encoding is held in four 64-bit limbs, and the operators run on the fixed-width
+	// multi-limb engine: clz regime extraction, 256-bit significands, and exact results in
+	// eight limbs (Comba products, Knuth long division) rounded once.
 	template<>
 	class posit<NBITS_IS_256, ES_IS_5> {
 	public:
@@ -23,9 +26,9 @@ namespace sw {
 		static constexpr size_t ebits = es;
 		static constexpr size_t fbits = nbits - 3 - es;
 		static constexpr size_t fhbits = fbits + 1;
-		static constexpr uint64_t sign_mask = 0x8000'0000'0000'0000ull;
+		static constexpr uint64_t sign_mask = 0x8000'0000'0000'0000ull;   // sign bit in the most significant limb
 
-		posit() { _bits = 0; }
+		posit() { _bits.fill(0); }
 		posit(const posit&) = default;
 		posit(posit&&) = default;
 		posit& operator=(const posit&) = default;
@@ -42,52 +45,62 @@ namespace sw {
 		posit(const unsigned int initial_value)       { *this = initial_value; }
 		posit(const unsigned long initial_value)      { *this = initial_value; }
 		posit(const unsigned long long initial_value) { *this = initial_value; }
+#if defined(__SIZEOF_INT128__)
+		posit(const int128_native initial_value)      { *this = initial_value; }
+		posit(const uint128_native initial_value)     { *this = initial_value; }
+#endif
 		posit(const float initial_value)              { *this = initial_value; }
 		posit(const double initial_value)             { *this = initial_value; }
 		posit(const long double initial_value)        { *this = initial_value; }
 
 		// assignment operators for native types
-		posit& operator=(const signed char rhs)       { 
+		posit& operator=(const signed char rhs)       { return operator=((long long)(rhs)); }
+		posit& operator=(const short rhs)             { return operator=((long long)(rhs)); }
+		posit& operator=(const int rhs)               { return operator=((long long)(rhs)); }
+		posit& operator=(const long rhs)              { return operator=((long long)(rhs)); }
+		posit& operator=(const long long rhs) {
 			// special case for speed as this is a common initialization
 			if (rhs == 0) {
-				_bits = 0x00;
+				clear();
 				return *this;
 			}
-
-			bool sign = bool(rhs & 0x80);
-			int8_t v = sign ? -rhs : rhs; // project to positve side of the projective reals
-			uint8_t raw;
-			if (v > 48 || v == -128) { // +-maxpos, 0x80 is special in int8 arithmetic as it is its own negation
-				raw = 0x7F;
+			bool sign = rhs < 0;
+			uint64_t v = sign ? ~uint64_t(rhs) + 1 : uint64_t(rhs); // project to positive side of the projective reals
+			_bits = integer_assign(sign, v);
+			return *this;
+		}
+		posit& operator=(const char rhs)              { return operator=((long long)(rhs)); }
+		posit& operator=(const unsigned short rhs)    { return operator=((unsigned long long)(rhs)); }
+		posit& operator=(const unsigned int rhs)      { return operator=((unsigned long long)(rhs)); }
+		posit& operator=(const unsigned long rhs)     { return operator=((unsigned long long)(rhs)); }
+		posit& operator=(const unsigned long long rhs) {
+			// special case for speed as this is a common initialization
+			if (rhs == 0) {
+				clear();
+				return *this;
 			}
-			else {
-				uint8_t mask = 0x40;
-				int8_t k = 6;
-				uint8_t fraction_bits = v;
-				while (!(fraction_bits & mask)) {
-					k--;
-					fraction_bits <<= 1;
-				}
-				fraction_bits = (fraction_bits ^ mask);
-				raw = (0x7F ^ (0x3F >> k)) | (fraction_bits >> (k + 1));
-
-				mask = 0x1 << k; //bitNPlusOne
-				if (mask & fraction_bits) {
-					if (((mask - 1) & fraction_bits) | ((mask << 1) & fraction_bits)) raw++;
-				}
+			_bits = integer_assign(false, rhs);
+			return *this;
+		}
+#if defined(__SIZEOF_INT128__)
+		posit& operator=(const int128_native rhs) {
+			if (rhs == 0) {
+				setzero();
+				return *this;
 			}
-			_bits = sign ? -raw : raw;
+			uint128_native magnitude = (rhs < 0 ? uint128_native(0) - uint128_native(rhs) : uint128_native(rhs));
+			_bits = integer_assign(rhs < 0, uint64_t(magnitude >> 64), uint64_t(magnitude));
 			return *this;
 		}
-		posit& operator=(const short rhs)             { return operator=((signed char)(rhs)); }
-		posit& operator=(const int rhs)               { return operator=((signed char)(rhs)); }
-		posit& operator=(const long rhs)              { return operator=((signed char)(rhs)); }
-		posit& operator=(const long long rhs)         { return operator=((signed char)(rhs)); }
-		posit& operator=(const char rhs)              { return operator=((signed char)(rhs)); }
-		posit& operator=(const unsigned short rhs)    { return operator=((signed char)(rhs)); }
-		posit& operator=(const unsigned int rhs)      { return operator=((signed char)(rhs)); }
-		posit& operator=(const unsigned long rhs)     { return operator=((signed char)(rhs)); }
-		posit& operator=(const unsigned long long rhs){ return operator=((signed char)(rhs)); }
+		posit& operator=(const uint128_native rhs) {
+			if (rhs == 0) {
+				setzero();
+				return *this;
+			}
+			_bits = integer_assign(false, uint64_t(rhs >> 64), uint64_t(rhs));
+			return *this;
+		}
+#endif
 		posit& operator=(const float rhs)             { return float_assign(rhs); }
 		posit& operator=(const double rhs)            { return float_assign(rhs); }
 		posit& operator=(const long double rhs)       { return float_assign(rhs); }
@@ -98,16 +111,21 @@ namespace sw {
 		explicit operator long long() const { return to_long_long(); }
 		explicit operator long() const { return to_long(); }
 		explicit operator int() const { return to_int(); }
-		explicit operator unsigned long long() const { return to_long_long(); }
-		explicit operator unsigned long() const { return to_long(); }
-		explicit operator unsigned int() const { return to_int(); }
+		explicit operator unsigned long long() const { return to_integer<unsigned long long, unsigned long long>(); }
+		explicit operator unsigned long() const { return to_integer<unsigned long, unsigned long>(); }
+		explicit operator unsigned int() const { return to_integer<unsigned int, unsigned int>(); }
+#if defined(__SIZEOF_INT128__)
+		explicit operator int128_native() const { return to_integer<int128_native, uint128_native>(); }
+		explicit operator uint128_native() const { return to_integer<uint128_native, uint128_native>(); }
+#endif
 
-		posit& set(sw::unum::bitblock<NBITS_IS_256>& raw) {
-			_bits = uint8_t(raw.to_ulong());
+		posit& set(const sw::unum::bitblock<NBITS_IS_256>& raw) {
+			_bits = engine::load(raw);
 			return *this;
 		}
 		posit& set_raw_bits(uint64_t value) {
-			_bits = uint8_t(value & 0xff);
+			clear();
+			_bits[0] = value;
 			return *this;
 		}
 		posit operator-() const {
@@ -118,197 +136,90 @@ namespace sw {
 				return *this;
 			}
 			posit p;
-			return p.set_raw_bits((~_bits) + 1);
-		}
-		posit& operator+=(const posit& b) { // derived from SoftPosit
-			uint8_t lhs = _bits;
-			uint8_t rhs = b._bits;
-			// process special cases
-			if (isnar() || b.isnar()) {  // infinity
-				_bits = 0x80;
-				return *this;
+			p._bits = engine::negate(_bits);
+			return p;
+		}
+		posit& operator+=(const posit& b) {
+			// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+			if (isnar() || b.isnar()) {
+				throw operand_is_nar{};
 			}
-			if (iszero() || b.iszero()) { // zero
-				_bits = lhs | rhs;
+#else
+			if (isnar() || b.isnar()) {
+				setnar();
 				return *this;
 			}
-			bool sign = bool(_bits & 0x80);
-			if (sign) {
-				lhs = -lhs & 0xFF;
-				rhs = -rhs & 0xFF;
-			}
-			if (lhs < rhs) std::swap(lhs, rhs);
-			
-			// decode the regime of lhs
-			int8_t m = 0; // pattern length
-			uint8_t remaining = 0;
-			decode_regime(lhs, m, remaining);
-			uint16_t frac16A = (0x80 | remaining) << 7;
-			int8_t shiftRight = m;
-			// adjust shift and extract fraction bits of rhs
-			extractAddand(rhs, shiftRight, remaining);
-			uint16_t frac16B = (0x80 | remaining) << 7;
-
-			// Work-around CLANG (LLVM) compiler when shifting right more than number of bits
-			(shiftRight>7) ? (frac16B = 0) : (frac16B >>= shiftRight); 
-
-			frac16A += frac16B;
-
-			bool rcarry = bool(0x8000 & frac16A); // is MSB set
-			if (rcarry) {
-				m++;
-				frac16A >>= 1;
-			}
-
-			_bits = round(m, frac16A);
-			if (sign) _bits = -_bits & 0xFF;
+#endif
+			_bits = engine::add(_bits, b._bits);
 			return *this;
 		}
-		posit& operator-=(const posit& b) {  // derived from SoftPosit
-			uint8_t lhs = _bits;
-			uint8_t rhs = b._bits;
-			// process special cases
+		posit& operator+=(double rhs) {
+			return *this += posit<nbits, es>(rhs);
+		}
+		posit& operator-=(const posit& b) {
+			// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
 			if (isnar() || b.isnar()) {
-				_bits = 0x80;
-				return *this;
-			}
-			if (iszero() || b.iszero()) {
-				_bits = lhs | rhs;
-				return *this;
-			}
-			// Both operands are actually the same sign if rhs inherits sign of sub: Make both positive
-			bool sign = bool(lhs & 0x80);
-			(sign) ? (lhs = (-lhs & 0xFF)) : (rhs = (-rhs & 0xFF));
-
-			if (lhs == rhs) {
-				_bits = 0x00;
-				return *this;
-			}
-			if (lhs < rhs) {
-				std::swap(lhs, rhs);
-				sign = !sign;
+				throw operand_is_nar{};
 			}
-
-			// decode the regime of lhs
-			int8_t m = 0; // pattern length
-			uint8_t remaining = 0;
-			decode_regime(lhs, m, remaining);
-			uint16_t frac16A = (0x80 | remaining) << 7;
-			int8_t shiftRight = m;
-			// adjust shift and extract fraction bits of rhs
-			extractAddand(rhs, shiftRight, remaining);
-			uint16_t frac16B = (0x80 | remaining) << 7;
-
-			// do the subtraction of the fractions
-			if (shiftRight >= 14) {
-				_bits = lhs;
-				if (sign) _bits = -_bits & 0xFFFF;
+#else
+			if (isnar() || b.isnar()) {
+				setnar();
 				return *this;
 			}
-			else {
-				frac16B >>= shiftRight;
-			}
-			frac16A -= frac16B;
-
-			while ((frac16A >> 14) == 0) {
-				m--;
-				frac16A <<= 1;
-			}
-			bool ecarry = bool (0x4000 & frac16A);
-			if (!ecarry) {
-				m--;
-				frac16A <<= 1;
-			}
-
-			_bits = round(m, frac16A);
-			if (sign) _bits = -_bits & 0xFF;
+#endif
+			_bits = engine::sub(_bits, b._bits);
 			return *this;
 		}
+		posit& operator-=(double rhs) {
+			return *this -= posit<nbits, es>(rhs);
+		}
 		posit& operator*=(const posit& b) {
-			uint8_t lhs = _bits;
-			uint8_t rhs = b._bits;
-			// process special cases
+			// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
 			if (isnar() || b.isnar()) {
-				_bits = 0x80;
-				return *this;
+				throw operand_is_nar{};
 			}
-			if (iszero() || b.iszero()) {
-				_bits = 0x00;
+#else
+			if (isnar() || b.isnar()) {
+				setnar();
 				return *this;
 			}
-
-			// calculate the sign of the result
-			bool sign = bool(lhs & 0x80) ^ bool(rhs & 0x80);
-			lhs = lhs & 0x80 ? -lhs : lhs;
-			rhs = rhs & 0x80 ? -rhs : rhs;
-
-			// decode the regime of lhs
-			int8_t m = 0; // pattern length
-			uint8_t remaining = 0;
-			decode_regime(lhs, m, remaining);
-			uint8_t lhs_fraction = (0x80 | remaining);
-			// adjust shift and extract fraction bits of rhs
-			extractMultiplicand(rhs, m, remaining);
-			uint8_t rhs_fraction = (0x80 | remaining);
-			uint16_t result_fraction = uint16_t(lhs_fraction) * uint16_t(rhs_fraction);
-
-			bool rcarry = bool(result_fraction & 0x8000);
-			if (rcarry) {
-				m++;
-				result_fraction >>= 1;
-			}
-
-			// round
-			_bits = round(m, result_fraction);
-			if (sign) _bits = -_bits & 0xFF;
+#endif // POSIT_THROW_ARITHMETIC_EXCEPTION
+			_bits = engine::mul(_bits, b._bits);
 			return *this;
 		}
+		posit& operator*=(double rhs) {
+			return *this *= posit<nbits, es>(rhs);
+		}
 		posit& operator/=(const posit& b) {
-			uint8_t lhs = _bits;
-			uint8_t rhs = b._bits;
-			// process special cases
-			if (isnar() || b.isnar() || b.iszero()) {
-				_bits = 0x80;
-				return *this;
+			// since we are encoding error conditions as NaR (Not a Real), we need to process that condition first
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+			if (b.iszero()) {
+				throw divide_by_zero{};    // not throwing is a quiet signalling NaR
 			}
-			if (iszero()) {
-				_bits = 0x00;
-				return *this;
+			if (b.isnar()) {
+				throw divide_by_nar{};
 			}
-
-			// calculate the sign of the result
-			bool sign = bool(lhs & 0x80) ^ bool(rhs & 0x80);
-			lhs = lhs & 0x80 ? -lhs : lhs;
-			rhs = rhs & 0x80 ? -rhs : rhs;
-
-			// decode the regime of lhs
-			int8_t m = 0; // pattern length
-			uint8_t remaining = 0;
-			decode_regime(lhs, m, remaining);
-			uint16_t lhs_fraction = (0x80 | remaining) << 7;
-			// adjust shift and extract fraction bits of rhs
-			extractDividand(rhs, m, remaining);
-			uint8_t rhs_fraction = (0x80 | remaining);
-			div_t result = div(lhs_fraction, uint16_t(rhs_fraction));
-			uint16_t result_fraction = result.quot;
-			uint16_t remainder = result.rem;
-
-			if (result_fraction != 0) {
-				bool rcarry = result_fraction >> 7; // this is the hidden bit (7th bit) , extreme right bit is bit 0
-				if (!rcarry) {
-					--m;
-					result_fraction <<= 1;
-				}
+			if (isnar()) {
+				throw numerator_is_nar{};
 			}
-
-			// round
-			_bits = adjustAndRound(m, result_fraction, remainder != 0);
-			if (sign) _bits = -_bits & 0xFF;
-
+#else
+			if (isnar() || b.isnar() || b.iszero()) {
+				setnar();
+				return *this;
+			}
+#endif // POSIT_THROW_ARITHMETIC_EXCEPTION
+			_bits = engine::div(_bits, b._bits);
 			return *this;
 		}
+		posit& operator/=(double rhs) {
+			return *this /= posit<nbits, es>(rhs);
+		}
+
 		posit& operator++() {
-			++_bits;
+			engine::increment(_bits);
 			return *this;
 		}
 		posit operator++(int) {
@@ -317,7 +228,7 @@ namespace sw {
 			return tmp;
 		}
 		posit& operator--() {
-			--_bits;
+			engine::decrement(_bits);
 			return *this;
 		}
 		posit operator--(int) {
@@ -326,117 +237,137 @@ namespace sw {
 			return tmp;
 		}
 		posit reciprocate() const {
-			posit p = 1.0 / *this;
+			posit p(1.0);
+			p /= *this;
 			return p;
 		}
 		// SELECTORS
-		inline bool isnar() const      { return (_bits == 0x80); }
-		inline bool iszero() const     { return (_bits == 0x00); }
-		inline bool isone() const      { return (_bits == 0x40); } // pattern 010000...
-		inline bool isminusone() const { return (_bits == 0xC0); } // pattern 110000...
-		inline bool isneg() const      { return (_bits & 0x80); }
+		inline bool isnar() const      { return engine::isnar(_bits); }
+		inline bool iszero() const     { return engine::iszero(_bits); }
+		inline bool isone() const      { return (_bits[3] == 0x4000'0000'0000'0000ull && _bits[2] == 0 && _bits[1] == 0 && _bits[0] == 0); } // pattern 010000...
+		inline bool isminusone() const { return (_bits[3] == 0xC000'0000'0000'0000ull && _bits[2] == 0 && _bits[1] == 0 && _bits[0] == 0); } // pattern 110000...
+		inline bool isneg() const      { return (_bits[3] & sign_mask) != 0; }
 		inline bool ispos() const      { return !isneg(); }
-		inline bool ispowerof2() const { return !(_bits & 0x1); }
+		inline bool ispowerof2() const { return !(_bits[0] & 0x1); }
 
-		inline int sign_value() const  { return (_bits & 0x8 ? -1 : 1); }
+		inline int sign_value() const  { return (_bits[3] & sign_mask ? -1 : 1); }
 
-		bitblock<NBITS_IS_256> get() const { bitblock<NBITS_IS_256> bb; bb = int(_bits); return bb; }
-		unsigned long long encoding() const { return (unsigned long long)(_bits); }
+		bitblock<NBITS_IS_256> get() const { bitblock<NBITS_IS_256> bb; engine::store(_bits, bb); return bb; }
+		unsigned long long encoding() const { return get().to_ullong(); }
 
-		inline void clear() { _bits = 0; }
+		inline void clear() { _bits.fill(0); }
 		inline void setzero() { clear(); }
-		inline void setnar() { _bits = 0x80; }
+		inline void setnar() { _bits = engine::nar(); }
 		inline posit twosComplement() const {
 			posit<NBITS_IS_256, ES_IS_5> p;
-			int8_t v = -*(int8_t*)&_bits;
-			p.set_raw_bits(v);
+			p._bits = engine::negate(_bits);
 			return p;
 		}
-	private:
-		uint8_t _bits;
 
-		// Conversion functions
-#if POSIT_THROW_ARITHMETIC_EXCEPTION
-		int         to_int() const {
-			if (iszero()) return 0;
-			if (isnar()) throw not_a_real{};
-			return int(to_float());
+		// normalized (sign, scale, fraction) triples for the quire
+		value<fbits> to_value() const {
+			value<fbits> v;
+			normalize(v);
+			return v;
 		}
-		long        to_long() const {
-			if (iszero()) return 0;
-			if (isnar()) throw not_a_real{};
-			return long(to_double());
+		void normalize(value<fbits>& v) const {
+			normalize_to(v);
 		}
-		long long   to_long_long() const {
-			if (iszero()) return 0;
-			if (isnar()) throw not_a_real{};
-			return long(to_long_double());
+		template<size_t tgt_fbits>
+		void normalize_to(value<tgt_fbits>& v) const {
+			if (iszero() || isnar()) {
+				v.set(false, 0, bitblock<tgt_fbits>(), iszero(), isnar());
+				return;
+			}
+			bool sign;
+			int scale;
+			engine::limbs significand;
+			engine::decode(_bits, sign, scale, significand);
+			// the significand holds the hidden bit at bit 255 followed by the fraction bits
+			bitblock<tgt_fbits> fraction;
+			for (int tgt = int(tgt_fbits) - 1, src = 254; tgt >= 0 && src >= 0; --tgt, --src) {
+				fraction[size_t(tgt)] = ((significand[size_t(src) / 64] >> (src % 64)) & 1) != 0;
+			}
+			v.set(sign, scale, fraction, false, false);
 		}
+
+	private:
+		using engine = limb_arithmetic<NBITS_IS_256, ES_IS_5>;
+		engine::limbs _bits;
+
+		// Conversion functions
+		int         to_int() const       { return to_integer<int, unsigned int>(); }
+		long        to_long() const      { return to_integer<long, unsigned long>(); }
+		long long   to_long_long() const { return to_integer<long long, unsigned long long>(); }
+		// the integer part truncated toward zero, saturated to the range of the integer; NaR converts to its minimum
+		template<typename Integer, typename Magnitude>
+		Integer to_integer() const {
+			if (iszero()) return Integer(0);
+			if (isnar()) {
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+				throw not_a_real{};
 #else
-		int         to_int() const {
-			if (iszero()) return 0;
-			if (isnar())  return int(INFINITY);
-			return int(to_float());
-		}
-		long        to_long() const {
-			if (iszero()) return 0;
-			if (isnar())  return long(INFINITY);
-			return long(to_double());
-		}
-		long long   to_long_long() const {
-			if (iszero()) return 0;
-			if (isnar())  return (long long)(INFINITY);
-			return long(to_long_double());
-		}
+				return std::numeric_limits<Integer>::min();
 #endif
+			}
+			bool sign;
+			int scale;
+			engine::limbs significand;
+			engine::decode(_bits, sign, scale, significand);
+			return truncate_to_integer<Integer, Magnitude>(sign, scale, significand[engine::nrLimbs - 1], significand[engine::nrLimbs - 2]);
+		}
 		float       to_float() const {
-			return (float)to_double();
+			return engine::to_native<float>(_bits);
 		}
+		// the 256-bit significand is rounded once to the precision of the target type
 		double      to_double() const {
-			if (iszero())	return 0.0;
-			if (isnar())	return NAN;
-			bool		     	 _sign;
-			regime<nbits, es>    _regime;
-			exponent<nbits, es>  _exponent;
-			fraction<fbits>      _fraction;
-			bitblock<nbits>		 _raw_bits;
-			_raw_bits.reset();
-			uint64_t mask = 1;
-			for (size_t i = 0; i < nbits; i++) {
-				_raw_bits.set(i, (_bits & mask));
-				mask <<= 1;
-			}
-			decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-			double s = (_sign ? -1.0 : 1.0);
-			double r = _regime.value();
-			double e = _exponent.value();
-			double f = (1.0 + _fraction.value());
-			return s * r * e * f;
+			return engine::to_native<double>(_bits);
 		}
 		long double to_long_double() const {
-			if (iszero())  return 0.0;
-			if (isnar())   return NAN;
-			bool		     	 _sign;
-			regime<nbits, es>    _regime;
-			exponent<nbits, es>  _exponent;
-			fraction<fbits>      _fraction;
-			bitblock<nbits>		 _raw_bits;
-			_raw_bits.reset();
-			uint64_t mask = 1;
-			for (size_t i = 0; i < nbits; i++) {
-				_raw_bits.set(i, (_bits & mask));
-				mask <<= 1;
-			}
-			decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-			long double s = (_sign ? -1.0 : 1.0);
-			long double r = _regime.value();
-			long double e = _exponent.value();
-			long double f = (1.0 + _fraction.value());
-			return s * r * e * f;
+			return engine::to_native<long double>(_bits);
+		}
+
+		// integer magnitudes are exact in the top limb of the significand: normalize and round once
+		static engine::limbs integer_assign(bool sign, uint64_t v) {
+			int shift = nlz(v);
+			engine::limbs significand = engine::zero();
+			significand[3] = v << shift;
+			return engine::encode(sign, 63 - shift, significand, false);
+		}
+
+		static engine::limbs integer_assign(bool sign, uint64_t hi, uint64_t lo) {
+			int scale;
+			engine::limbs significand = engine::zero();
+			ieee_normalize(hi, lo, 0, scale, significand[engine::nrLimbs - 1], significand[engine::nrLimbs - 2]);
+			return engine::encode(sign, scale, significand, false);
 		}
 
 		template <typename T>
 		posit& float_assign(const T& rhs) {
+#if POSIT_FAST_IEEE_CONVERSION
+			if (ieee_decoder<T>::enabled) {
+				// decode the IEEE fields from the bit pattern and round the significand onto the posit directly
+				bool sign;
+				int scale;
+				uint64_t hi, lo;
+				switch (ieee_decoder<T>::decode(rhs, sign, scale, hi, lo)) {
+				case FP_ZERO:
+					setzero();
+					return *this;
+				case FP_INFINITE:
+				case FP_NAN:
+					setnar();
+					return *this;
+				default:
+					break;
+				}
+				engine::limbs significand = engine::zero();
+				significand[engine::nrLimbs - 1] = hi;
+				significand[engine::nrLimbs - 2] = lo;
+				_bits = engine::encode(sign, scale, significand, false);
+				return *this;
+			}
+#endif
 			constexpr int dfbits = std::numeric_limits<T>::digits - 1;
 			value<dfbits> v((T)rhs);
 
@@ -450,146 +381,13 @@ namespace sw {
 				return *this;
 			}
 
-			bitblock<NBITS_IS_256> ptt;
-			convert_to_bb<NBITS_IS_256, ES_IS_5, dfbits>(v.sign(), v.scale(), v.fraction(), ptt); // TODO: needs to be faster
-			_bits = uint8_t(ptt.to_ulong());
+			// the IEEE fractions of float, double, and long double fit below the hidden bit in the top limb
+			engine::limbs significand = engine::zero();
+			significand[3] = (uint64_t(1) << 63) | (uint64_t(v.fraction().to_ullong()) << (63 - dfbits));
+			_bits = engine::encode(v.sign(), v.scale(), significand, false);
 			return *this;
 		}
 
-		// helper method
-		// decode_regime takes the raw bits of the posit, and returns the regime run-length, m, and the remaining fraction bits in remainder
-		inline void decode_regime(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-			remaining = (bits << 2) & 0xFF;
-			if (bits & 0x40) {  // positive regimes
-				while (remaining >> 7) {
-					++m;
-					remaining = (remaining << 1) & 0xFF;
-				}
-			}
-			else {              // negative regimes
-				m = -1;
-				while (!(remaining >> 7)) {
-					--m;
-					remaining = (remaining << 1) & 0xFF;
-				}
-				remaining &= 0x7F;
-			}
-		}
-		inline void extractAddand(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-			remaining = (bits << 2) & 0xFF;
-			if (bits & 0x40) {  // positive regimes
-				while (remaining >> 7) {
-					--m;
-					remaining = (remaining << 1) & 0xFF;
-				}
-			}
-			else {              // negative regimes
-				++m;
-				while (!(remaining >> 7)) {
-					++m;
-					remaining = (remaining << 1) & 0xFF;
-				}
-				remaining &= 0x7F;
-			}
-		}
-		inline void extractMultiplicand(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-			remaining = (bits << 2) & 0xFF;
-			if (bits & 0x40) {  // positive regimes
-				while (remaining >> 7) {
-					++m;
-					remaining = (remaining << 1) & 0xFF;
-				}
-			}
-			else {              // negative regimes
-				--m;
-				while (!(remaining >> 7)) {
-					--m;
-					remaining = (remaining << 1) & 0xFF;
-				}
-				remaining &= 0x7F;
-			}
-		}
-		inline void extractDividand(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-			remaining = (bits << 2) & 0xFF;
-			if (bits & 0x40) {  // positive regimes
-				while (remaining >> 7) {
-					--m;
-					remaining = (remaining << 1) & 0xFF;
-				}
-			}
-			else {              // negative regimes
-				++m;
-				while (!(remaining >> 7)) {
-					++m;
-					remaining = (remaining << 1) & 0xFF;
-				}
-				remaining &= 0x7F;
-			}
-		}
-		inline uint8_t round(const int8_t m, uint16_t fraction) const {
-			uint8_t scale, regime, bits;
-			if (m < 0) {
-				scale = (-m & 0xFF);
-				regime = 0x40 >> scale;
-			}
-			else {
-				scale = m + 1;
-				regime = 0x7F - (0x7F >> scale);
-			}
-
-			if (scale > 6) {
-				bits = m<0 ? 0x1 : 0x7F;  // minpos and maxpos
-			}
-			else {
-				fraction = (fraction & 0x3FFF) >> scale;
-				uint8_t final_fbits = uint8_t(fraction >> 8);
-				bool bitNPlusOne = bool(0x80 & fraction);
-				bits = uint8_t(regime) + uint8_t(final_fbits);
-				// n+1 frac bit is 1. Need to check if another bit is 1 too if not round to even
-				if (bitNPlusOne) {
-					uint8_t moreBits = (0x7F & fraction) ? 0x01 : 0x00;
-					bits += (bits & 0x01) | moreBits;
-				}
-			}
-			return bits;
-		}
-		inline uint8_t adjustAndRound(const int8_t k, uint16_t fraction, bool nonZeroRemainder) const {
-			uint8_t scale, regime, bits;
-			if (k < 0) {
-				scale = (-k & 0xFF);
-				regime = 0x40 >> scale;
-			}
-			else {
-				scale = k + 1;
-				regime = 0x7F - (0x7F >> scale);
-			}
-
-			if (scale > 6) {
-				bits = k<0 ? 0x1 : 0x7F;  // minpos and maxpos
-			}
-			else {
-				//remove carry and rcarry bits and shift to correct position
-				fraction &= 0x7F;
-				uint8_t final_fbits = (uint_fast16_t)fraction >> (scale + 1);
-				bool bitNPlusOne = (0x1 & (fraction >> scale));
-				bits = uint8_t(regime) + uint8_t(final_fbits);
-#ifdef NOW
-				std::cout << std::hex;
-				std::cout << "fraction raw   = " << int(fraction) << std::endl;
-				std::cout << "fraction final = " << int(final_fbits) << std::endl;
-				std::cout << "posit bits     = " << int(bits) << std::endl;
-				std::cout << std::dec;
-#endif
-				if (bitNPlusOne) {
-					uint8_t moreBits = (((1 << scale) - 1) & fraction) ? 0x01 : 0x00;
-					if (nonZeroRemainder) moreBits = 0x01;
-					//std::cout << "bitsMore = " << (moreBits ? "true" : "false") << std::endl;
-					// n+1 frac bit is 1. Need to check if another bit is 1 too if not round to even
-					bits += (bits & 0x01) | moreBits;
-				}
-			}
-			return bits;
-		}
 		// I/O operators
 		friend std::ostream& operator<< (std::ostream& ostr, const posit<NBITS_IS_256, ES_IS_5>& p);
 		friend std::istream& operator>> (std::istream& istr, posit<NBITS_IS_256, ES_IS_5>& p);
@@ -623,7 +421,7 @@ namespace sw {
 		return ostr << ss.str();
 	}
 
-	// read an ASCII float or posit format: nbits.esxNN...NNp, for example: 32.2x80000000p
+	// read an ASCII float or posit format: nbits.esxNN...NNp, for example: 256.5x8000000000000000000000000000000000000000000000000000000000000000p
 	inline std::istream& operator>> (std::istream& istr, posit<NBITS_IS_256, ES_IS_5>& p) {
 		std::string txt;
 		istr >> txt;
@@ -634,12 +432,12 @@ namespace sw {
 	}
 
 	// convert a posit value to a string using "nar" as designation of NaR
-	std::string to_string(const posit<NBITS_IS_256, ES_IS_5>& p, std::streamsize precision) {
+	inline std::string to_string(const posit<NBITS_IS_256, ES_IS_5>& p, std::streamsize precision) {
 		if (p.isnar()) {
 			return std::string("nar");
 		}
 		std::stringstream ss;
-		ss << std::setprecision(precision) << float(p);
+		ss << std::setprecision(precision) << (long double)p;
 		return ss.str();
 	}
 
@@ -651,7 +449,7 @@ namespace sw {
 		return !operator==(lhs, rhs);
 	}
 	inline bool operator< (const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
-		return *(signed char*)(&lhs._bits) < *(signed char*)(&rhs._bits);
+		return limb_arithmetic<NBITS_IS_256, ES_IS_5>::less(lhs._bits, rhs._bits);
 	}
 	inline bool operator> (const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
 		return operator< (rhs, lhs);
@@ -663,28 +461,7 @@ namespace sw {
 		return !operator< (lhs, rhs);
 	}
 
-	inline posit<NBITS_IS_256, ES_IS_5> operator+(const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
-		posit<NBITS_IS_256, ES_IS_5> result = lhs;
-		if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
-			result += rhs;
-		} 
-		else {
-			result -= rhs;
-		}
-		return result;
-	}
-	inline posit<NBITS_IS_256, ES_IS_5> operator-(const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
-		posit<NBITS_IS_256, ES_IS_5> result = lhs;
-		if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
-			result -= rhs.twosComplement();
-		}
-		else {
-			result += rhs.twosComplement();
-		}
-		return result;
-
-	}
-	// binary operator*() is provided by generic class
+	// binary arithmetic operators are provided by generic class
 
 #if POSIT_ENABLE_LITERALS
 	// posit - literal logic functions
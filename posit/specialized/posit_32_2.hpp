@@ -139,12 +139,12 @@ namespace sw {
 		explicit operator long long() const { return to_long_long(); }
 		explicit operator long() const { return to_long(); }
 		explicit operator int() const { return to_int(); }
-		explicit operator unsigned long long() const { return to_long_long(); }
-		explicit operator unsigned long() const { return to_long(); }
-		explicit operator unsigned int() const { return to_int(); }
+		explicit operator unsigned long long() const { return to_integer<unsigned long long, unsigned long long>(); }
+		explicit operator unsigned long() const { return to_integer<unsigned long, unsigned long>(); }
+		explicit operator unsigned int() const { return to_integer<unsigned int, unsigned int>(); }
 
 		posit& set(sw::unum::bitblock<NBITS_IS_32>& raw) {
-			_bits = uint8_t(raw.to_ulong());
+			_bits = uint32_t(raw.to_ulong());
 			return *this;
 		}
 		posit& set_raw_bits(uint64_t value) {
@@ -472,7 +472,8 @@ namespace sw {
 			return tmp;
 		}
 		posit reciprocate() const {
-			posit p = 1.0 / *this;
+			posit p(1.0);
+			p /= *this;
 			return p;
 		}
 		// SELECTORS
@@ -502,39 +503,27 @@ namespace sw {
 		uint32_t _bits;
 
 		// Conversion functions
+		int         to_int() const       { return to_integer<int, unsigned int>(); }
+		long        to_long() const      { return to_integer<long, unsigned long>(); }
+		long long   to_long_long() const { return to_integer<long long, unsigned long long>(); }
+		// the integer part truncated toward zero, saturated to the range of the integer; NaR converts to its minimum
+		template<typename Integer, typename Magnitude>
+		Integer to_integer() const {
+			if (iszero()) return Integer(0);
+			if (isnar()) {
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
-		int         to_int() const {
-			if (iszero()) return 0;
-			if (isnar()) throw not_a_real{};
-			return int(to_float());
-		}
-		long        to_long() const {
-			if (iszero()) return 0;
-			if (isnar()) throw not_a_real{};
-			return long(to_double());
-		}
-		long long   to_long_long() const {
-			if (iszero()) return 0;
-			if (isnar()) throw not_a_real{};
-			return long(to_long_double());
-		}
+				throw not_a_real{};
 #else
-		int         to_int() const {
-			if (iszero()) return 0;
-			if (isnar())  return int(INFINITY);
-			return int(to_float());
-		}
-		long        to_long() const {
-			if (iszero()) return 0;
-			if (isnar())  return long(INFINITY);
-			return long(to_double());
-		}
-		long long   to_long_long() const {
-			if (iszero()) return 0;
-			if (isnar())  return (long long)(INFINITY);
-			return long(to_long_double());
-		}
+				return std::numeric_limits<Integer>::min();
 #endif
+			}
+			// the value of the posit is exact in a double
+			bool sign = false;
+			int scale = 0;
+			uint64_t hi = 0, lo = 0;
+			ieee_decoder<double>::decode(to_double(), sign, scale, hi, lo);
+			return truncate_to_integer<Integer, Magnitude>(sign, scale, hi, lo);
+		}
 		float       to_float() const {
 			return (float)to_double();
 		}
@@ -583,6 +572,27 @@ namespace sw {
 
 		template <typename T>
 		posit& float_assign(const T& rhs) {
+#if POSIT_FAST_IEEE_CONVERSION
+			if (ieee_decoder<T>::enabled) {
+				// decode the IEEE fields from the bit pattern and round the significand onto the posit directly
+				bool sign;
+				int scale;
+				uint64_t hi, lo;
+				switch (ieee_decoder<T>::decode(rhs, sign, scale, hi, lo)) {
+				case FP_ZERO:
+					setzero();
+					return *this;
+				case FP_INFINITE:
+				case FP_NAN:
+					setnar();
+					return *this;
+				default:
+					break;
+				}
+				_bits = uint32_t(native_arithmetic<NBITS_IS_32, ES_IS_2>::encode(sign, scale, hi, lo != 0));
+				return *this;
+			}
+#endif
 			constexpr int dfbits = std::numeric_limits<T>::digits - 1;
 			value<dfbits> v((T)rhs);
 
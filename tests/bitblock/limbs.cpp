@@ -0,0 +1,286 @@
+//  limbs.cpp :  test suite for the multi-limb arithmetic of the bitblock engine
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include "common.hpp"
+#include <random>
+#include "../../posit/exceptions.hpp"	// TODO: remove namespace polution
+#include "../../bitblock/bitblock.hpp"
+#include "../tests/test_helpers.hpp"
+
+// The reference functions below are the bit-serial ripple algorithms of the original std::bitset engine.
+// The word-level implementations of the bitblock helpers must produce identical bits for operands that
+// span one or more 64-bit limbs, including partially filled top limbs.
+
+template<size_t nbits>
+sw::unum::bitblock<nbits> RandomBitblock(std::mt19937_64& eng) {
+	sw::unum::bitblock<nbits> bits;
+	for (size_t i = 0; i < nbits; ++i) bits.set(i, (eng() & 0x1) != 0);
+	return bits;
+}
+
+template<size_t nbits>
+bool ReferenceAdd(const sw::unum::bitblock<nbits>& a, const sw::unum::bitblock<nbits>& b, sw::unum::bitblock<nbits + 1>& sum) {
+	bool carry = false;
+	for (size_t i = 0; i < nbits; i++) {
+		bool _a = a[i], _b = b[i];
+		sum.set(i, _a ^ _b ^ carry);
+		carry = (_a & _b) | (carry & (_a ^ _b));
+	}
+	sum.set(nbits, carry);
+	return carry;
+}
+
+template<size_t nbits>
+bool ReferenceSubtract(const sw::unum::bitblock<nbits>& a, const sw::unum::bitblock<nbits>& b, sw::unum::bitblock<nbits + 1>& dif) {
+	bool borrow = false;
+	for (size_t i = 0; i < nbits; i++) {
+		bool _a = a[i], _b = b[i];
+		dif.set(i, _a ^ _b ^ borrow);
+		borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
+	}
+	dif.set(nbits, borrow);
+	return borrow;
+}
+
+template<size_t nbits>
+void ReferenceMultiply(const sw::unum::bitblock<nbits>& a, const sw::unum::bitblock<nbits>& b, sw::unum::bitblock<2 * nbits>& result) {
+	result.reset();
+	for (size_t i = 0; i < nbits; i++) {
+		if (!a[i]) continue;
+		bool carry = false;
+		for (size_t j = 0; j < 2 * nbits - i; j++) {
+			bool _a = (j < nbits ? b[j] : false), _b = result[i + j];
+			result.set(i + j, _a ^ _b ^ carry);
+			carry = (_a & _b) | (carry & (_a ^ _b));
+		}
+	}
+}
+
+template<size_t nbits>
+int ReferenceMostSignificantBit(const sw::unum::bitblock<nbits>& bits) {
+	for (int i = int(nbits) - 1; i >= 0; --i) if (bits[size_t(i)]) return i;
+	return -1;
+}
+
+template<size_t nbits>
+int ReferenceCompare(const sw::unum::bitblock<nbits>& a, const sw::unum::bitblock<nbits>& b) {
+	for (int i = int(nbits) - 1; i >= 0; --i) {
+		if (a[size_t(i)] != b[size_t(i)]) return (b[size_t(i)] ? -1 : 1);
+	}
+	return 0;
+}
+
+// restoring division of a * 2^(rbits - nbits) by b, one quotient bit per step
+template<size_t nbits, size_t rbits>
+void ReferenceDivideWithFraction(const sw::unum::bitblock<nbits>& a, const sw::unum::bitblock<nbits>& b, sw::unum::bitblock<rbits>& quotient) {
+	sw::unum::bitblock<nbits + 1> remainder, divisor;
+	sw::unum::bitblock<nbits + 2> dif;
+	for (size_t i = 0; i < nbits; ++i) divisor.set(i, b[i]);
+	quotient.reset();
+	for (int i = int(rbits) - 1; i >= 0; --i) {
+		for (size_t j = nbits; j > 0; --j) remainder.set(j, remainder[j - 1]);
+		int k = i - int(rbits - nbits);
+		remainder.set(0, k >= 0 && a[size_t(k)]);
+		if (ReferenceCompare(remainder, divisor) >= 0) {
+			ReferenceSubtract(remainder, divisor, dif);
+			for (size_t j = 0; j <= nbits; ++j) remainder.set(j, dif[j]);
+			quotient.set(size_t(i));
+		}
+	}
+}
+
+template<size_t nbits>
+int VerifyLimbArithmetic(bool bReportIndividualTestCases, size_t nrOfRandoms = 1000) {
+	using namespace sw::unum;
+	int nrOfFailedTestCases = 0;
+	std::mt19937_64 eng(nbits);
+
+	for (size_t t = 0; t < nrOfRandoms; ++t) {
+		bitblock<nbits> a = RandomBitblock<nbits>(eng);
+		bitblock<nbits> b = RandomBitblock<nbits>(eng);
+		if (t % 8 == 0) b = a;           // exercise the equality paths
+		if (t % 16 == 1) a.set();        // exercise the carry propagation across all limbs
+		bitblock<nbits + 1> result, ref;
+		bool carry, refCarry;
+
+		carry = add_unsigned(a, b, result);
+		refCarry = ReferenceAdd(a, b, ref);
+		if (carry != refCarry || result != ref) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL add_unsigned " << a << " + " << b << " = " << result << " ref " << ref << std::endl;
+		}
+
+		carry = subtract_unsigned(a, b, result);
+		refCarry = ReferenceSubtract(a, b, ref);
+		if (carry != refCarry || result != ref) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL subtract_unsigned " << a << " - " << b << " = " << result << " ref " << ref << std::endl;
+		}
+
+		bitblock<2 * nbits> product, refProduct;
+		multiply_unsigned(a, b, product);
+		ReferenceMultiply(a, b, refProduct);
+		if (product != refProduct) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL multiply_unsigned " << a << " * " << b << " = " << product << " ref " << refProduct << std::endl;
+		}
+
+		// accumulate and subtract into a wider accumulator only touch the lower nbits
+		bitblock<nbits + 7> acc = RandomBitblock<nbits + 7>(eng), accRef = acc;
+		carry = accumulate(a, acc);
+		bitblock<nbits> lower;
+		for (size_t i = 0; i < nbits; ++i) lower.set(i, accRef[i]);
+		refCarry = ReferenceAdd(lower, a, ref);
+		for (size_t i = 0; i < nbits; ++i) accRef.set(i, ref[i]);
+		if (carry != refCarry || acc != accRef) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL accumulate " << a << " result " << acc << " ref " << accRef << std::endl;
+		}
+		carry = subtract(acc, b);
+		for (size_t i = 0; i < nbits; ++i) lower.set(i, accRef[i]);
+		refCarry = ReferenceSubtract(lower, b, ref);
+		for (size_t i = 0; i < nbits; ++i) accRef.set(i, ref[i]);
+		if (carry != refCarry || acc != accRef) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL subtract " << b << " result " << acc << " ref " << accRef << std::endl;
+		}
+
+		int cmp = ReferenceCompare(a, b);
+		if ((a < b) != (cmp < 0) || (a <= b) != (cmp <= 0) || (a > b) != (cmp > 0) || (a >= b) != (cmp >= 0) || (a == b) != (cmp == 0)) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL comparison " << a << " <=> " << b << std::endl;
+		}
+
+		if (findMostSignificantBit(a) != ReferenceMostSignificantBit(a)) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL findMostSignificantBit " << a << std::endl;
+		}
+
+		// shifts, increment, and decrement
+		size_t shift = size_t(eng() % (nbits + 1));
+		bitblock<nbits> shifted = a, refShifted;
+		shifted <<= shift;
+		for (size_t i = shift; i < nbits; ++i) refShifted.set(i, a[i - shift]);
+		if (shifted != refShifted) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL " << a << " << " << shift << " = " << shifted << " ref " << refShifted << std::endl;
+		}
+		shifted = a;
+		shifted >>= shift;
+		refShifted.reset();
+		for (size_t i = shift; i < nbits; ++i) refShifted.set(i - shift, a[i]);
+		if (shifted != refShifted) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL " << a << " >> " << shift << " = " << shifted << " ref " << refShifted << std::endl;
+		}
+
+		bitblock<nbits> one, inc = a, dec = a;
+		one.set(0);
+		carry = increment_bitset(inc);
+		ReferenceAdd(a, one, ref);
+		refCarry = ref[nbits];
+		bool incFail = (carry != refCarry);
+		for (size_t i = 0; i < nbits; ++i) incFail |= (inc[i] != ref[i]);
+		carry = decrement_bitset(dec);
+		ReferenceSubtract(a, one, ref);
+		refCarry = ref[nbits];
+		incFail |= (carry != refCarry);
+		for (size_t i = 0; i < nbits; ++i) incFail |= (dec[i] != ref[i]);
+		if (incFail) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL increment/decrement " << a << std::endl;
+		}
+
+		// sticky bit of the lower bits
+		int msb = int(eng() % nbits);
+		bool refSticky = false;
+		for (int i = msb; i >= 0; --i) refSticky |= b[size_t(i)];
+		if (anyAfter(b, msb) != refSticky) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL anyAfter " << b << " at " << msb << std::endl;
+		}
+
+		// quotient must satisfy q * b <= a < (q + 1) * b
+		if (b.any()) {
+			bitblock<2 * nbits> q;
+			integer_divide_unsigned(a, b, q);
+			bitblock<nbits> quotient;
+			for (size_t i = 0; i < nbits; ++i) quotient.set(i, q[i]);
+			bitblock<2 * nbits> lowerBound, upperBound, wideA;
+			multiply_unsigned(quotient, b, lowerBound);
+			increment_bitset(quotient);
+			multiply_unsigned(quotient, b, upperBound);
+			copy_into(a, 0, wideA);
+			if (!(lowerBound <= wideA) || (quotient.any() && !(wideA < upperBound))) {
+				++nrOfFailedTestCases;
+				if (bReportIndividualTestCases) std::cout << "FAIL integer_divide_unsigned " << a << " / " << b << " = " << q << std::endl;
+			}
+
+			// the fraction bits of the quotient, as module_divide requests them
+			bitblock<3 * nbits + 4> fraction, refFraction;
+			divide_with_fraction(a, b, fraction);
+			ReferenceDivideWithFraction(a, b, refFraction);
+			if (fraction != refFraction) {
+				++nrOfFailedTestCases;
+				if (bReportIndividualTestCases) std::cout << "FAIL divide_with_fraction " << a << " / " << b << " = " << fraction << " ref " << refFraction << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Bitblock limb arithmetic failed";
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<65>(true, 10), "bitblock< 65>", "limbs");
+
+#else
+
+	cout << "Test of multi-limb arithmetic on bitblocks" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<  5>(bReportIndividualTestCases), "bitblock<  5>", "limbs");
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic< 63>(bReportIndividualTestCases), "bitblock< 63>", "limbs");
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic< 64>(bReportIndividualTestCases), "bitblock< 64>", "limbs");
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic< 65>(bReportIndividualTestCases), "bitblock< 65>", "limbs");
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<100>(bReportIndividualTestCases), "bitblock<100>", "limbs");
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<128>(bReportIndividualTestCases), "bitblock<128>", "limbs");
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<191>(bReportIndividualTestCases), "bitblock<191>", "limbs");
+	// operands at and above BITBLOCK_KARATSUBA_THRESHOLD limbs take the Karatsuba path of multiply_unsigned
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<1000>(bReportIndividualTestCases, 20), "bitblock<1000>", "limbs");
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<2000>(bReportIndividualTestCases, 5), "bitblock<2000>", "limbs");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<256>(bReportIndividualTestCases, 10000), "bitblock<256>", "limbs");
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbArithmetic<521>(bReportIndividualTestCases, 10000), "bitblock<521>", "limbs");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
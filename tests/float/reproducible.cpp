@@ -0,0 +1,305 @@
+// reproducible.cpp: functional tests for the reproducible sum, dot, and gemv operators on IEEE floats
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <vector>
+#include <algorithm>
+// minimum set of include files
+#include "../../posit/exceptions.hpp"
+#include "../../bitblock/bitblock.hpp"
+#include "../../posit/value.hpp"
+#include "../../float/quire.hpp"
+#include "../../float/reproducible.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+
+// same value and same sign, with NaN equal to NaN
+template<typename Real>
+bool Identical(Real a, Real b) {
+	if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+	return a == b && std::signbit(a) == std::signbit(b);
+}
+
+// products of integers scaled by small powers of 2 have an exact sum in a 128-bit integer, and the conversion
+// of that integer to double is correctly rounded: the reference for the rounding of the quire
+int VerifyDotAgainstIntegerReference(const std::string& tag, bool bReportIndividualTestCases, size_t n) {
+	using namespace sw::ieee;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(n);
+	std::uniform_int_distribution<long long> significand(-(1ll << 26), (1ll << 26));
+	std::uniform_int_distribution<int> scale(0, 18);
+	for (int trial = 0; trial < 20; ++trial) {
+		std::vector<double> x(n), y(n);
+		std::vector<long long> as(n), bs(n);
+		std::vector<int> sas(n), sbs(n);
+		sw::unum::int128_native reference = 0;
+		for (size_t i = 0; i < n; ++i) {
+			long long a = significand(eng), b = significand(eng);
+			int sa = scale(eng), sb = scale(eng);
+			// cancel most of the head to leave a sum that needs rounding at many different positions
+			if (i >= n / 2 && trial % 2) {
+				size_t k = i - n / 2;
+				a = trial - as[k];
+				b = bs[k];
+				sa = sas[k];
+				sb = sbs[k];
+			}
+			as[i] = a; bs[i] = b; sas[i] = sa; sbs[i] = sb;
+			x[i] = std::ldexp(double(a), sa);
+			y[i] = std::ldexp(double(b), sb);
+			reference += (sw::unum::int128_native(a) * b) << (sa + sb);
+		}
+		double expected = double(reference);
+		double result = reproducible_dot(x, y);
+		if (!Identical(result, expected)) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " n = " << n << " dot = " << std::hexfloat << result << " golden reference is " << expected << std::defaultfloat << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// floats with a narrow range of exponents have an exact sum in a double
+int VerifyFloatSum(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::ieee;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(24);
+	std::uniform_real_distribution<float> distr(-32.0f, 32.0f);
+	for (size_t n : { size_t(1), size_t(10), size_t(1000) }) {
+		std::vector<float> x(n);
+		double exact = 0.0;
+		for (size_t i = 0; i < n; ++i) {
+			x[i] = distr(eng);
+			exact += x[i];
+		}
+		float result = reproducible_sum(x);
+		if (!Identical(result, float(exact))) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " float sum of " << n << " terms = " << result << " golden reference is " << float(exact) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// rounding to nearest-even, subnormals, overflow, and the special values
+int VerifyRoundingCases(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::ieee;
+	int nrOfFailedTests = 0;
+	const double ulp = std::ldexp(1.0, -52);
+	const double tiny = std::numeric_limits<double>::denorm_min();
+	const double huge = std::numeric_limits<double>::max();
+	const double inf = std::numeric_limits<double>::infinity();
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	struct Case { std::vector<double> terms; double expected; const char* label; };
+	std::vector<Case> cases = {
+		{ { 1.0, ulp / 2 },                  1.0,                 "tie rounds to even (down)" },
+		{ { 1.0 + ulp, ulp / 2 },            1.0 + 2 * ulp,       "tie rounds to even (up)" },
+		{ { 1.0, ulp / 2, tiny },            1.0 + ulp,           "sticky bit breaks the tie" },
+		{ { 1.0, ulp / 2, -tiny },           1.0,                 "below the tie" },
+		{ { 1.0e300, 1.0, -1.0e300 },        1.0,                 "cancellation" },
+		{ { 3 * tiny, -tiny },               2 * tiny,            "subnormal result" },
+		{ { tiny, -tiny },                   0.0,                 "exact zero" },
+		{ { huge, huge },                    inf,                 "overflow" },
+		{ { -huge, -huge },                  -inf,                "negative overflow" },
+		{ { huge, huge, -huge },             huge,                "intermediate overflow" },
+		{ { 1.0, inf, 2.0 },                 inf,                 "infinity" },
+		{ { inf, -inf },                     nan,                 "inf - inf" },
+		{ { 1.0, nan },                      nan,                 "NaN" },
+	};
+	for (const Case& c : cases) {
+		for (size_t nrThreads : { size_t(1), size_t(2) }) {
+			double result = reproducible_sum(c.terms, nrThreads);
+			if (!Identical(result, c.expected)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cerr << tag << " " << c.label << ": " << std::hexfloat << result << " golden reference is " << c.expected << std::defaultfloat << std::endl;
+			}
+		}
+	}
+	// products below the smallest subnormal are held exactly by the quire
+	std::vector<double> x = { tiny, tiny, 1.0 }, y = { tiny, -tiny, tiny };
+	if (!Identical(reproducible_dot(x, y), tiny)) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " subnormal products" << std::endl;
+	}
+	reproducible_accumulator<double> acc;
+	acc.add_product(tiny, tiny);
+	acc.add_product(tiny, tiny);
+	if (acc.get_quire().iszero() || !Identical(acc.value(), 0.0)) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " product of subnormals lost" << std::endl;
+	}
+	acc.add_product(-inf, 0.0);
+	if (!std::isnan(acc.value())) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " inf * 0 is not NaN" << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+// the 64-bit significand of a long double carries out of the word when the quire rounds up to a power of 2
+int VerifyLongDoubleRounding(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::ieee;
+	int nrOfFailedTests = 0;
+	const long double two64 = std::ldexp(1.0l, 64);
+	struct Case { double low; long double expected; const char* label; };
+	std::vector<Case> cases = {
+		{ -0.25,  two64,                         "carry out of the significand" },
+		{ -0.5,   two64,                         "tie rounds to even carries out" },
+		{ -0.75,  two64 - 1.0l,                  "below the carry" },
+		{ -1.0,   two64 - 1.0l,                  "exact all ones significand" },
+	};
+	for (const Case& c : cases) {
+		for (bool negative : { false, true }) {
+			quire<64, 11, 30> q;
+			q.add(negative ? -std::ldexp(1.0, 64) : std::ldexp(1.0, 64));
+			q.add(negative ? -c.low : c.low);
+			long double result = q.to_long_double();
+			long double expected = (negative ? -c.expected : c.expected);
+			if (!Identical(result, expected)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cerr << tag << " " << c.label << ": " << std::hexfloat << result << " golden reference is " << expected << std::defaultfloat << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the result is bit-identical for any number of threads and any order of the terms
+int VerifyReproducibility(const std::string& tag, bool bReportIndividualTestCases, size_t n) {
+	using namespace sw::ieee;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(n);
+	std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+	std::uniform_int_distribution<int> exponent(-300, 300);
+	std::vector<double> x(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = std::ldexp(mantissa(eng), exponent(eng));
+		y[i] = std::ldexp(mantissa(eng), exponent(eng));
+	}
+	double sum = reproducible_sum(x), dot = reproducible_dot(x, y);
+	for (size_t nrThreads : { size_t(2), size_t(3), size_t(4), size_t(7), size_t(16) }) {
+		double psum = reproducible_sum(n, x.data(), 1, nrThreads);
+		double pdot = reproducible_dot(n, x.data(), 1, y.data(), 1, nrThreads);
+		if (!Identical(psum, sum) || !Identical(pdot, dot)) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " " << nrThreads << " threads: sum " << psum << " dot " << pdot << " golden reference is " << sum << " " << dot << std::endl;
+		}
+	}
+	std::vector<size_t> order(n);
+	for (size_t i = 0; i < n; ++i) order[i] = i;
+	std::shuffle(order.begin(), order.end(), eng);
+	std::vector<double> xs(n), ys(n);
+	for (size_t i = 0; i < n; ++i) {
+		xs[i] = x[order[i]];
+		ys[i] = y[order[i]];
+	}
+	if (!Identical(reproducible_sum(xs, 4), sum) || !Identical(reproducible_dot(xs, ys, 3), dot)) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " shuffled terms change the result" << std::endl;
+	}
+	// strided access picks the same terms as the contiguous vectors
+	std::vector<double> xy(2 * n);
+	for (size_t i = 0; i < n; ++i) {
+		xy[2 * i] = x[i];
+		xy[2 * i + 1] = y[i];
+	}
+	if (!Identical(reproducible_dot(n, xy.data(), 2, xy.data() + 1, 2, 5), dot)) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " strided dot product" << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+// every element of gemv is the correctly rounded dot product of a row with x, plus beta * y
+template<typename Real>
+int VerifyGemv(const std::string& tag, bool bReportIndividualTestCases, size_t m, size_t n) {
+	using namespace sw::ieee;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(m * n);
+	std::uniform_real_distribution<Real> distr(-1.0, 1.0);
+	const size_t lda = n + 3;
+	std::vector<Real> A(m * lda), x(n), y0(m);
+	for (auto& a : A) a = distr(eng);
+	for (auto& v : x) v = distr(eng);
+	for (auto& v : y0) v = distr(eng);
+	for (Real beta : { Real(0), Real(-0.75) }) {
+		std::vector<Real> expected(m);
+		for (size_t i = 0; i < m; ++i) {
+			reproducible_accumulator<Real> acc;
+			for (size_t j = 0; j < n; ++j) acc.add_product(A[i * lda + j], x[j]);
+			acc.add_product(beta, y0[i]);
+			expected[i] = acc.value();
+		}
+		for (size_t nrThreads : { size_t(1), size_t(3), size_t(8) }) {
+			std::vector<Real> y = y0;
+			if (beta == Real(0)) std::fill(y.begin(), y.end(), std::numeric_limits<Real>::quiet_NaN());   // y is not read
+			reproducible_gemv(m, n, A.data(), lda, x.data(), 1, beta, y.data(), 1, nrThreads);
+			for (size_t i = 0; i < m; ++i) {
+				if (!Identical(y[i], expected[i])) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cerr << tag << " gemv row " << i << " with " << nrThreads << " threads = " << y[i] << " golden reference is " << expected[i] << std::endl;
+				}
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::ieee;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "reproducible operator failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingCases(tag, true), "double", "rounding");
+
+#else
+
+	cout << "Reproducible IEEE sum, dot, and gemv validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingCases(tag, bReportIndividualTestCases), "double", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyLongDoubleRounding(tag, bReportIndividualTestCases), "long double", "rounding");
+	for (size_t n : { size_t(1), size_t(2), size_t(17), size_t(1000) }) {
+		nrOfFailedTestCases += ReportTestResult(VerifyDotAgainstIntegerReference(tag, bReportIndividualTestCases, n), "double", "dot n = " + std::to_string(n));
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyFloatSum(tag, bReportIndividualTestCases), "float", "sum");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility(tag, bReportIndividualTestCases, 10000), "double", "thread and order invariance");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<double>(tag, bReportIndividualTestCases, 37, 53), "double", "gemv");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<float>(tag, bReportIndividualTestCases, 16, 100), "float", "gemv");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility(tag, bReportIndividualTestCases, 10000000), "double", "thread and order invariance");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -9,11 +9,13 @@
 // enable/disable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 0
 #include "../../posit/posit.hpp"
+#include "../../posit/quire.hpp"
 // posit type manipulators such as pretty printers
 #include "../../posit/posit_manipulators.hpp"
 // test helpers
 #include "../test_helpers.hpp"
 #include "../posit_test_helpers.hpp"
+#include "../posit_fused_helpers.hpp"
 
 // generate specific test case that you can trace with the trace conditions in posit.h
 // for most bugs they are traceable with _trace_conversion and _trace_sub
@@ -35,7 +37,7 @@ void GenerateTestCase(Ty a, Ty b, Ty c) {
 	std::cout << std::setprecision(5);
 }
 
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
 // forward references
@@ -48,7 +50,7 @@ try {
 	using namespace std;
 	using namespace sw::unum;
 
-	//bool bReportIndividualTestCases = false;
+	bool bReportIndividualTestCases = false;
 	int nrOfFailedTestCases = 0;
 
 	std::string tag = "Fused Multiply-Accumulate failed: ";
@@ -92,12 +94,38 @@ try {
 
 #else
 
-	nrOfFailedTestCases += ReportTestResult(ValidateFMA<2, 0>(tag, bReportIndividualTestCases), "posit<2,0>", "fused multiply-accumulate");
+	cout << "Fused multiply-add, add-multiply, and multiply-multiply-add validation" << endl;
 
+	for (FusedOpcode opcode : { FUSED_FMA, FUSED_FAM }) {
+		std::string op = fused_operation_string[opcode];
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperator<3, 0>(tag, bReportIndividualTestCases, opcode), "posit<3,0>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperator<4, 0>(tag, bReportIndividualTestCases, opcode), "posit<4,0>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperator<5, 1>(tag, bReportIndividualTestCases, opcode), "posit<5,1>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperator<6, 2>(tag, bReportIndividualTestCases, opcode), "posit<6,2>", op);
+	}
+	for (FusedOpcode opcode : { FUSED_FMMA, FUSED_FMMS }) {
+		std::string op = fused_operation_string[opcode];
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperator<3, 0>(tag, bReportIndividualTestCases, opcode), "posit<3,0>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperator<4, 1>(tag, bReportIndividualTestCases, opcode), "posit<4,1>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperator<5, 0>(tag, bReportIndividualTestCases, opcode), "posit<5,0>", op);
+	}
+	for (FusedOpcode opcode : { FUSED_FMA, FUSED_FAM, FUSED_FMMA, FUSED_FMMS }) {
+		std::string op = fused_operation_string[opcode];
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperatorThroughRandoms< 8, 0>(tag, bReportIndividualTestCases, opcode, 10000), "posit< 8,0>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperatorThroughRandoms<16, 1>(tag, bReportIndividualTestCases, opcode, 10000), "posit<16,1>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperatorThroughRandoms<32, 2>(tag, bReportIndividualTestCases, opcode, 10000), "posit<32,2>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperatorThroughRandoms<64, 3>(tag, bReportIndividualTestCases, opcode, 2000), "posit<64,3>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperatorThroughRandoms<64, 0>(tag, bReportIndividualTestCases, opcode, 2000), "posit<64,0>", op);
+	}
 
 #if STRESS_TESTING
-
-#endif
+	for (FusedOpcode opcode : { FUSED_FMA, FUSED_FAM, FUSED_FMMA, FUSED_FMMS }) {
+		std::string op = fused_operation_string[opcode];
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperatorThroughRandoms<24, 1>(tag, bReportIndividualTestCases, opcode, 100000), "posit<24,1>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperatorThroughRandoms<48, 2>(tag, bReportIndividualTestCases, opcode, 100000), "posit<48,2>", op);
+		nrOfFailedTestCases += ReportTestResult(ValidateFusedOperatorThroughRandoms<80, 3>(tag, bReportIndividualTestCases, opcode, 1000), "posit<80,3>", op);
+	}
+#endif  // STRESS_TESTING
 
 #endif
 
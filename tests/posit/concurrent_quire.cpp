@@ -0,0 +1,170 @@
+// concurrent_quire.cpp: stress tests for the quire accumulation mode that many threads add to concurrently
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <thread>
+#include <vector>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+#include "../../posit/quire.hpp"
+#include "../../posit/concurrent_quire.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+#include "../posit_test_helpers.hpp"
+
+// many threads add the products of interleaved slices through all the accumulation paths of the concurrent quire,
+// and the resolved sum must equal the quire that accumulated the same terms sequentially
+template<size_t nbits, size_t es, size_t capacity>
+int VerifyConcurrentAccumulation(const std::string& tag, bool bReportIndividualTestCases, size_t n, size_t nrThreads) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	std::vector< posit<nbits, es> > x, y;
+	GenerateDotProductOperands(n, x, y, false);
+	quire<nbits, es, capacity> reference;
+	for (size_t i = 0; i < n; ++i) {
+		switch (i % 5) {
+		case 0: reference += quire_mul(x[i], y[i]); break;
+		case 1: reference -= quire_mul(x[i], y[i]); break;
+		case 2: reference.add_product(x[i], y[i]); break;
+		case 3: reference.subtract_product(x[i], y[i]); break;
+		case 4: reference += x[i]; break;
+		}
+	}
+
+	concurrent_quire<nbits, es, capacity> cq;
+	std::vector<std::thread> producers;
+	for (size_t t = 0; t < nrThreads; ++t) {
+		producers.push_back(std::thread([&, t]() {
+			// every eighth producer sums its terms in a private quire and adds it at the end
+			quire<nbits, es, capacity> partial;
+			for (size_t i = t; i < n; i += nrThreads) {
+				switch (i % 5) {
+				case 0: if (t % 8 == 7) partial += quire_mul(x[i], y[i]); else cq += quire_mul(x[i], y[i]); break;
+				case 1: cq -= quire_mul(x[i], y[i]); break;
+				case 2: cq.add_product(x[i], y[i]); break;
+				case 3: cq.subtract_product(x[i], y[i]); break;
+				case 4: cq += x[i]; break;
+				}
+			}
+			cq += partial;
+		}));
+	}
+	for (auto& producer : producers) producer.join();
+	if (cq != reference) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " " << nrThreads << " threads\n" << cq << " golden reference is\n" << reference << std::endl;
+	}
+	// removing a quire is exact too, and leaves a positive zero
+	cq -= reference;
+	if (!cq.iszero() || cq.sign()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " " << nrThreads << " threads: sum minus reference is " << cq << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+// carries through the capacity segment from concurrent producers, and a negative sum
+template<size_t nbits, size_t es, size_t capacity>
+int VerifyConcurrentCarries(const std::string& tag, bool bReportIndividualTestCases, size_t nrThreads) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	posit<nbits, es> maxpos = sw::unum::maxpos<nbits, es>(), minpos = sw::unum::minpos<nbits, es>();
+	constexpr size_t NR_OF_TERMS = (size_t(1) << (capacity - 1)) - 1;
+	quire<nbits, es, capacity> reference;
+	for (size_t i = 0; i < NR_OF_TERMS; ++i) reference -= quire_mul(maxpos, maxpos);
+	reference += quire_mul(minpos, minpos);
+
+	concurrent_quire<nbits, es, capacity> cq;
+	std::vector<std::thread> producers;
+	for (size_t t = 0; t < nrThreads; ++t) {
+		producers.push_back(std::thread([&, t]() {
+			for (size_t i = t; i < NR_OF_TERMS; i += nrThreads) cq.subtract_product(maxpos, maxpos);
+			if (t == 0) cq.add_product(minpos, minpos);
+		}));
+	}
+	for (auto& producer : producers) producer.join();
+	if (cq != reference) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " carries with " << nrThreads << " threads\n" << cq << " golden reference is\n" << reference << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Concurrent quire failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyConcurrentAccumulation<16, 1, 10>(tag, true, 1000, 4), "quire<16,1,10>", "concurrent accumulation");
+
+#else
+
+	cout << "Concurrent quire validation" << endl;
+
+	for (size_t nrThreads : { size_t(1), size_t(4), size_t(32) }) {
+		std::string threads = std::to_string(nrThreads) + " threads";
+		nrOfFailedTestCases += ReportTestResult(VerifyConcurrentAccumulation< 8, 0, 10>(tag, bReportIndividualTestCases, 20000, nrThreads), "quire< 8,0,10>", "concurrent accumulation " + threads);
+		nrOfFailedTestCases += ReportTestResult(VerifyConcurrentAccumulation<16, 1, 10>(tag, bReportIndividualTestCases, 20000, nrThreads), "quire<16,1,10>", "concurrent accumulation " + threads);
+		nrOfFailedTestCases += ReportTestResult(VerifyConcurrentAccumulation<32, 2, 30>(tag, bReportIndividualTestCases, 20000, nrThreads), "quire<32,2,30>", "concurrent accumulation " + threads);
+		nrOfFailedTestCases += ReportTestResult(VerifyConcurrentAccumulation<64, 3, 30>(tag, bReportIndividualTestCases, 20000, nrThreads), "quire<64,3,30>", "concurrent accumulation " + threads);
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyConcurrentCarries< 8, 0,  4>(tag, bReportIndividualTestCases, 3), "quire< 8,0,4>", "concurrent carries");
+	nrOfFailedTestCases += ReportTestResult(VerifyConcurrentCarries<16, 1, 10>(tag, bReportIndividualTestCases, 8), "quire<16,1,10>", "concurrent carries");
+	nrOfFailedTestCases += ReportTestResult(VerifyConcurrentCarries<32, 2, 14>(tag, bReportIndividualTestCases, 8), "quire<32,2,14>", "concurrent carries");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyConcurrentAccumulation<32, 2, 30>(tag, bReportIndividualTestCases, 10000000, 64), "quire<32,2,30>", "concurrent accumulation 64 threads");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,304 @@
+// conversion_ieee.cpp: functional tests for the conversions between posits and the bit patterns of IEEE float, double, and long double
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <vector>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+
+// the reference conversion through value<>, which extracts the IEEE components with frexp
+template<size_t nbits, size_t es, typename Real>
+sw::unum::posit<nbits, es> ReferenceConversion(Real x) {
+	using namespace sw::unum;
+	posit<nbits, es> p;
+	value<std::numeric_limits<Real>::digits - 1> v(x);
+	if (v.iszero()) p.setzero();
+	else if (v.isinf() || v.isnan()) p.setnar();
+	else convert(v, p);
+	return p;
+}
+
+// IEEE values around the dynamic range of the posit: random significands with scales just beyond maxpos and minpos,
+// values halfway between posits, subnormals, and the special values
+template<size_t nbits, size_t es, typename Real>
+std::vector<Real> GenerateIeeeValues(size_t nrOfRandoms) {
+	using namespace sw::unum;
+	std::vector<Real> values = { Real(0), -Real(0), Real(1), Real(-1), Real(0.5), Real(3),
+		std::numeric_limits<Real>::infinity(), -std::numeric_limits<Real>::infinity(), std::numeric_limits<Real>::quiet_NaN(),
+		std::numeric_limits<Real>::max(), std::numeric_limits<Real>::lowest(), std::numeric_limits<Real>::min(),
+		std::numeric_limits<Real>::denorm_min(), -std::numeric_limits<Real>::denorm_min(), std::numeric_limits<Real>::min() / Real(3) };
+	std::mt19937_64 eng(nbits * 16 + es + std::numeric_limits<Real>::digits);
+	std::uniform_real_distribution<double> significand(1.0, 2.0);
+	constexpr int max_scale = (int(nbits) - 2) * (1 << es);
+	int range = std::min(max_scale + 8, std::numeric_limits<Real>::max_exponent - 1);
+	std::uniform_int_distribution<int> scale(-range, range);
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		// the extra bits below the double significand reach the rounding positions of the wider formats
+		Real m = Real(significand(eng)) + std::ldexp(Real(significand(eng)), -53);
+		Real x = std::ldexp(m, scale(eng));
+		values.push_back(i % 2 ? -x : x);
+	}
+	// the midpoints and neighbors of posits, which exercise round-to-nearest-even and the sticky bit
+	posit<nbits, es> p;
+	std::uniform_int_distribution<unsigned long long> encoding;
+	for (size_t i = 0; i < nrOfRandoms / 4; ++i) {
+		p.set_raw_bits(encoding(eng));
+		if (p.isnar() || p.iszero()) continue;
+		posit<nbits, es> q = p;
+		++q;
+		if (q.isnar()) continue;
+		long double a = (long double)p, b = (long double)q;
+		Real mid = Real((a + b) / 2);
+		values.push_back(mid);
+		values.push_back(std::nextafter(mid, Real(a)));
+		values.push_back(std::nextafter(mid, Real(b)));
+	}
+	return values;
+}
+
+// the direct conversion must match the reference conversion through value<> for every value
+template<size_t nbits, size_t es, typename Real>
+int VerifyIeeeConversion(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	for (Real x : GenerateIeeeValues<nbits, es, Real>(nrOfRandoms)) {
+		posit<nbits, es> p(x);
+		posit<nbits, es> reference = ReferenceConversion<nbits, es>(x);
+		if (p != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " " << std::setprecision(std::numeric_limits<Real>::max_digits10) << x << " converts to " << p.get() << " golden reference is " << reference.get() << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyAllIeeeTypes(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	int nrOfFailedTests = 0;
+	nrOfFailedTests += VerifyIeeeConversion<nbits, es, float>(tag, bReportIndividualTestCases, nrOfRandoms);
+	nrOfFailedTests += VerifyIeeeConversion<nbits, es, double>(tag, bReportIndividualTestCases, nrOfRandoms);
+	nrOfFailedTests += VerifyIeeeConversion<nbits, es, long double>(tag, bReportIndividualTestCases, nrOfRandoms);
+	return nrOfFailedTests;
+}
+
+// posits up to 64 bits have at most 63 fraction bits and scales within the range of the x87 long double,
+// so their exact value is a long double and its conversion to Real is the correctly rounded reference
+template<size_t nbits, size_t es, typename Real>
+Real ReferenceIeeeValue(const sw::unum::posit<nbits, es>& p) {
+	using namespace sw::unum;
+	if (p.iszero()) return Real(0);
+	if (p.isnar()) return std::numeric_limits<Real>::quiet_NaN();
+	bool sign;
+	int scale;
+	bitblock<p.fbits> fraction;
+	decode<nbits, es>(p.get(), sign, scale, fraction);
+	long double significand = 1.0l;
+	for (int i = int(p.fbits) - 1; i >= 0; --i) significand = 2 * significand + (fraction[i] ? 1 : 0);
+	long double v = std::ldexp(significand, scale - int(p.fbits));
+	return Real(sign ? -v : v);
+}
+
+// the conversion of posits to IEEE values must round once: compare against the exact reference
+// for random encodings, the encodings around the IEEE subnormal and overflow boundaries, and the special cases
+template<size_t nbits, size_t es, typename Real>
+int VerifyPositToIeee(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	static_assert(nbits <= 64, "reference requires the value of the posit to be exact in a long double");
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(nbits * 16 + es);
+	std::uniform_int_distribution<unsigned long long> encoding;
+	std::vector<unsigned long long> encodings = { 0, 1, 2, 3, (1ull << (nbits - 1)) - 1, (1ull << (nbits - 1)), (1ull << (nbits - 1)) + 1 };
+	for (size_t i = 0; i < nrOfRandoms; ++i) encodings.push_back(encoding(eng));
+	posit<nbits, es> p;
+	for (Real boundary : { std::numeric_limits<Real>::max(), std::numeric_limits<Real>::min(), std::numeric_limits<Real>::denorm_min() }) {
+		p = boundary;
+		for (int d = -8; d <= 8; ++d) encodings.push_back(p.encoding() + d);
+	}
+	for (unsigned long long bits : encodings) {
+		p.set_raw_bits(bits);
+		Real v = Real(p);
+		Real reference = ReferenceIeeeValue<nbits, es, Real>(p);
+		if (!(v == reference && std::signbit(v) == std::signbit(reference)) && !(std::isnan(v) && std::isnan(reference))) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " " << p.get() << " converts to " << std::setprecision(std::numeric_limits<Real>::max_digits10) << v << " golden reference is " << reference << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// wider posits are checked against the midpoints between the IEEE value and its neighbors: at scales where the
+// posit has more fraction bits than the midpoints, the midpoints are exact posits, and a correctly rounded
+// IEEE value has the posit between them, with ties on the value with an even significand.
+// The long double scales stay within the double range of the random posits.
+template<size_t nbits, size_t es, typename Real>
+int VerifyWidePositToIeee(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(nbits * 16 + es);
+	std::uniform_real_distribution<double> significand(1.0, 2.0);
+	std::uniform_int_distribution<int> scale(std::max(std::numeric_limits<Real>::min_exponent - 24, -100), 100);
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		// a quotient fills all the fraction bits of the posit
+		posit<nbits, es> p = posit<nbits, es>(std::ldexp(significand(eng), scale(eng))) / posit<nbits, es>(significand(eng));
+		if (i % 2) p = -p;
+		Real v = Real(p);
+		Real below = std::nextafter(v, -std::numeric_limits<Real>::infinity()), above = std::nextafter(v, std::numeric_limits<Real>::infinity());
+		// the sums of neighbors are exact posits, where a long double midpoint of long doubles would round
+		posit<nbits, es> half(0.5);
+		posit<nbits, es> low = (posit<nbits, es>(v) + posit<nbits, es>(below)) * half, high = (posit<nbits, es>(v) + posit<nbits, es>(above)) * half;
+		int exponent = std::max(std::ilogb(v), std::numeric_limits<Real>::min_exponent - 1);
+		bool even = (std::fmod(std::ldexp(v, std::numeric_limits<Real>::digits - 1 - exponent), Real(2)) == 0);
+		bool rounded = (low < p && p < high) || ((p == low || p == high) && even);
+		if (!rounded) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " " << p << " converts to " << std::setprecision(std::numeric_limits<Real>::max_digits10) << v << " which is not the nearest value" << std::endl;
+		}
+	}
+	posit<nbits, es> nar;
+	nar.setnar();
+	if (!std::isnan(Real(nar)) || Real(posit<nbits, es>(0)) != Real(0)) ++nrOfFailedTests;
+	return nrOfFailedTests;
+}
+
+// the posits around the midpoints of the IEEE values near 1 and 2 round to nearest even, including the carry
+// of an all ones significand into the next binade: requires the posit to hold digits + 26 fraction bits near 1
+template<size_t nbits, size_t es, typename Real>
+int VerifyPositToIeeeRounding(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	constexpr int digits = std::numeric_limits<Real>::digits;
+	using Posit = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	Posit one(1), two(2), half_ulp(std::ldexp(Real(1), -digits)), three_half_ulps(std::ldexp(Real(3), -digits)), tiny(std::ldexp(Real(1), -digits - 26));
+	struct { Posit p; Real golden; } cases[] = {
+		{ one + half_ulp,                 Real(1) },                                      // tie to the even 1
+		{ one + half_ulp + tiny,          Real(1) + std::ldexp(Real(1), 1 - digits) },
+		{ one + half_ulp - tiny,          Real(1) },
+		{ one + three_half_ulps,          Real(1) + std::ldexp(Real(1), 2 - digits) },    // tie to even rounds up
+		{ two - half_ulp,                 Real(2) },                                      // carries into the exponent
+		{ two - half_ulp - tiny,          Real(2) - std::ldexp(Real(1), 1 - digits) },
+		{ -(two - half_ulp),              Real(-2) },
+	};
+	for (auto& c : cases) {
+		Real v = Real(c.p);
+		if (v != c.golden) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " " << c.p << " converts to " << std::setprecision(std::numeric_limits<Real>::max_digits10) << v << " golden reference is " << c.golden << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyAllPositToIeee(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	int nrOfFailedTests = 0;
+	nrOfFailedTests += VerifyPositToIeee<nbits, es, float>(tag, bReportIndividualTestCases, nrOfRandoms);
+	nrOfFailedTests += VerifyPositToIeee<nbits, es, double>(tag, bReportIndividualTestCases, nrOfRandoms);
+	nrOfFailedTests += VerifyPositToIeee<nbits, es, long double>(tag, bReportIndividualTestCases, nrOfRandoms);
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "IEEE conversion failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeConversion<16, 1, double>(tag, true, 100), "posit<16,1>", "double conversion");
+
+#else
+
+	cout << "IEEE float, double, and long double to posit conversion validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes<  4, 0>(tag, bReportIndividualTestCases, 1000), "posit<  4,0>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes<  8, 0>(tag, bReportIndividualTestCases, 5000), "posit<  8,0>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes<  8, 2>(tag, bReportIndividualTestCases, 5000), "posit<  8,2>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes< 16, 1>(tag, bReportIndividualTestCases, 5000), "posit< 16,1>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes< 24, 5>(tag, bReportIndividualTestCases, 5000), "posit< 24,5>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes< 32, 2>(tag, bReportIndividualTestCases, 5000), "posit< 32,2>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes< 48, 3>(tag, bReportIndividualTestCases, 5000), "posit< 48,3>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes< 64, 3>(tag, bReportIndividualTestCases, 5000), "posit< 64,3>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes< 80, 4>(tag, bReportIndividualTestCases, 2000), "posit< 80,4>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes<128, 4>(tag, bReportIndividualTestCases, 2000), "posit<128,4>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes<128, 6>(tag, bReportIndividualTestCases, 1000), "posit<128,6>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes<256, 5>(tag, bReportIndividualTestCases, 500), "posit<256,5>", "ieee conversion");
+
+	cout << "posit to IEEE float, double, and long double conversion validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyAllPositToIeee<  4, 0>(tag, bReportIndividualTestCases, 100), "posit<  4,0>", "to ieee");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllPositToIeee<  8, 0>(tag, bReportIndividualTestCases, 1000), "posit<  8,0>", "to ieee");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllPositToIeee< 16, 1>(tag, bReportIndividualTestCases, 5000), "posit< 16,1>", "to ieee");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllPositToIeee< 24, 5>(tag, bReportIndividualTestCases, 5000), "posit< 24,5>", "to ieee");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllPositToIeee< 32, 2>(tag, bReportIndividualTestCases, 5000), "posit< 32,2>", "to ieee");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllPositToIeee< 32, 3>(tag, bReportIndividualTestCases, 5000), "posit< 32,3>", "to ieee");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllPositToIeee< 48, 3>(tag, bReportIndividualTestCases, 5000), "posit< 48,3>", "to ieee");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllPositToIeee< 64, 3>(tag, bReportIndividualTestCases, 5000), "posit< 64,3>", "to ieee");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllPositToIeee< 64, 5>(tag, bReportIndividualTestCases, 5000), "posit< 64,5>", "to ieee");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositToIeee< 80, 4, float>(tag, bReportIndividualTestCases, 2000), "posit< 80,4>", "to float");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositToIeee< 80, 4, double>(tag, bReportIndividualTestCases, 2000), "posit< 80,4>", "to double");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositToIeee<128, 4, float>(tag, bReportIndividualTestCases, 2000), "posit<128,4>", "to float");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositToIeee<128, 4, double>(tag, bReportIndividualTestCases, 2000), "posit<128,4>", "to double");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositToIeee<128, 6, double>(tag, bReportIndividualTestCases, 1000), "posit<128,6>", "to double");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositToIeee< 80, 4, long double>(tag, bReportIndividualTestCases, 2000), "posit< 80,4>", "to long double");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositToIeee<128, 4, long double>(tag, bReportIndividualTestCases, 2000), "posit<128,4>", "to long double");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToIeeeRounding< 96, 2, double>(tag, bReportIndividualTestCases), "posit< 96,2>", "to double rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToIeeeRounding< 96, 2, long double>(tag, bReportIndividualTestCases), "posit< 96,2>", "to long double rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToIeeeRounding<128, 4, long double>(tag, bReportIndividualTestCases), "posit<128,4>", "to long double rounding");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes< 32, 2>(tag, bReportIndividualTestCases, 1000000), "posit< 32,2>", "ieee conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyAllIeeeTypes<256, 5>(tag, bReportIndividualTestCases, 10000), "posit<256,5>", "ieee conversion");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
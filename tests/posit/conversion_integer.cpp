@@ -0,0 +1,287 @@
+// conversion_integer.cpp: functional tests for the conversions between posits and 64-bit and 128-bit integers
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <vector>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+
+// the reference conversion of an integer magnitude hi.lo through value<127>, which rounds it with convert()
+template<size_t nbits, size_t es>
+sw::unum::posit<nbits, es> ReferenceIntegerConversion(bool sign, uint64_t hi, uint64_t lo) {
+	using namespace sw::unum;
+	posit<nbits, es> p;
+	if ((hi | lo) == 0) {
+		p.setzero();
+		return p;
+	}
+	// the msb is the hidden bit, the bits below it are the fraction
+	int msb = (hi ? 127 - int(nlz(hi)) : 63 - int(nlz(lo)));
+	bitblock<127> fraction;
+	for (int i = msb - 1, f = 126; i >= 0; --i, --f) {
+		fraction[f] = (((i >= 64 ? hi >> (i - 64) : lo >> i) & 1) != 0);
+	}
+	value<127> v;
+	v.set(sign, msb, fraction, false, false);
+	convert(v, p);
+	return p;
+}
+
+// integers around the powers of two, where the posit rounds, and random integers of every width
+std::vector<uint64_t> GenerateMagnitudes(std::mt19937_64& eng, size_t nrOfRandoms) {
+	std::vector<uint64_t> magnitudes = { 0, 1, 2, 3, 5, 7, 255, 256, 1000000, ~uint64_t(0), ~uint64_t(0) >> 1, uint64_t(1) << 63 };
+	for (int b = 1; b < 64; ++b) {
+		uint64_t pow2 = uint64_t(1) << b;
+		magnitudes.push_back(pow2 - 1);
+		magnitudes.push_back(pow2 + 1);
+		magnitudes.push_back(pow2 + (pow2 >> 1) + (pow2 >> 2));
+	}
+	for (size_t i = 0; i < nrOfRandoms; ++i) magnitudes.push_back(eng() >> (eng() % 64));
+	return magnitudes;
+}
+
+// integer assignment rounds once: compare against the value<> reference for signed, unsigned, and 128-bit integers
+template<size_t nbits, size_t es>
+int VerifyIntegerToPosit(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(nbits * 16 + es);
+	for (uint64_t m : GenerateMagnitudes(eng, nrOfRandoms)) {
+		posit<nbits, es> p(m), reference = ReferenceIntegerConversion<nbits, es>(false, 0, m);
+		if (p != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " unsigned " << m << " converts to " << p.get() << " golden reference is " << reference.get() << std::endl;
+		}
+		long long s = (long long)(m >> 1);
+		for (long long v : { s, -s }) {
+			p = v;
+			reference = ReferenceIntegerConversion<nbits, es>(v < 0, 0, uint64_t(s));
+			if (p != reference) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cerr << tag << " signed " << v << " converts to " << p.get() << " golden reference is " << reference.get() << std::endl;
+			}
+		}
+	}
+	posit<nbits, es> p(std::numeric_limits<long long>::min()), reference = ReferenceIntegerConversion<nbits, es>(true, 0, uint64_t(1) << 63);
+	if (p != reference) ++nrOfFailedTests;
+	p = (signed char)(-100);
+	if (p != posit<nbits, es>(-100.0)) ++nrOfFailedTests;
+#if defined(__SIZEOF_INT128__)
+	for (uint64_t hi : GenerateMagnitudes(eng, nrOfRandoms / 4)) {
+		uint64_t lo = eng();
+		uint128_native m = (uint128_native(hi) << 64) | lo;
+		p = m;
+		reference = ReferenceIntegerConversion<nbits, es>(false, hi, lo);
+		if (p != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " unsigned 128-bit " << hi << ":" << lo << " converts to " << p.get() << " golden reference is " << reference.get() << std::endl;
+		}
+		hi >>= 1;
+		p = -int128_native((uint128_native(hi) << 64) | lo);
+		reference = ReferenceIntegerConversion<nbits, es>(true, hi, lo);
+		if (p != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " signed 128-bit -" << hi << ":" << lo << " converts to " << p.get() << " golden reference is " << reference.get() << std::endl;
+		}
+	}
+#endif
+	return nrOfFailedTests;
+}
+
+// the exact value of a posit up to 64 bits as a long double
+template<size_t nbits, size_t es>
+long double ExactValue(const sw::unum::posit<nbits, es>& p) {
+	using namespace sw::unum;
+	bool sign;
+	int scale;
+	bitblock<p.fbits> fraction;
+	decode<nbits, es>(p.get(), sign, scale, fraction);
+	long double significand = 1.0l;
+	for (int i = int(p.fbits) - 1; i >= 0; --i) significand = 2 * significand + (fraction[i] ? 1 : 0);
+	long double v = std::ldexp(significand, scale - int(p.fbits));
+	return (sign ? -v : v);
+}
+
+// the reference of the conversion to Integer: truncate the exact value toward zero and saturate to the range of Integer
+template<typename Integer, size_t nbits, size_t es>
+Integer ReferenceTruncation(const sw::unum::posit<nbits, es>& p) {
+	if (p.iszero()) return Integer(0);
+	if (p.isnar()) return std::numeric_limits<Integer>::min();
+	long double v = std::trunc(ExactValue(p));
+	long double limit = std::ldexp(1.0l, std::numeric_limits<Integer>::digits);
+	if (v >= limit) return std::numeric_limits<Integer>::max();
+	if (v < 0 && !std::numeric_limits<Integer>::is_signed) return Integer(0);
+	if (v < -limit) return std::numeric_limits<Integer>::min();
+	return Integer(v);
+}
+
+template<typename Integer, size_t nbits, size_t es>
+int VerifyTruncation(const std::string& tag, const std::string& type, bool bReportIndividualTestCases, const std::vector< sw::unum::posit<nbits, es> >& posits) {
+	int nrOfFailedTests = 0;
+	for (const auto& p : posits) {
+		Integer i = Integer(p), reference = ReferenceTruncation<Integer>(p);
+		if (i != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " " << p << " converts to " << type << " " << (long double)i << " golden reference is " << (long double)reference << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the conversion to integers truncates toward zero and saturates, for every encoding or random encodings
+template<size_t nbits, size_t es>
+int VerifyPositToInteger(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	static_assert(nbits <= 64, "reference requires the value of the posit to be exact in a long double");
+	std::mt19937_64 eng(nbits * 16 + es);
+	std::vector< posit<nbits, es> > posits;
+	posit<nbits, es> p;
+	if (nbits <= 16) {
+		for (uint64_t bits = 0; bits < (uint64_t(1) << nbits); ++bits) posits.push_back(p.set_raw_bits(bits));
+	}
+	else {
+		for (size_t i = 0; i < nrOfRandoms; ++i) posits.push_back(p.set_raw_bits(eng()));
+		// the integers around the boundaries of the integer types, and their neighbors
+		for (int b : { 31, 32, 63, 64, 127, 128 }) {
+			for (long double v : { std::ldexp(1.0l, b), -std::ldexp(1.0l, b) }) {
+				p = v;
+				for (int d = -3; d <= 3; ++d) posits.push_back(posit<nbits, es>().set_raw_bits(p.encoding() + d));
+			}
+		}
+	}
+	int nrOfFailedTests = 0;
+	nrOfFailedTests += VerifyTruncation<int>(tag, "int", bReportIndividualTestCases, posits);
+	nrOfFailedTests += VerifyTruncation<unsigned int>(tag, "unsigned int", bReportIndividualTestCases, posits);
+	nrOfFailedTests += VerifyTruncation<long long>(tag, "long long", bReportIndividualTestCases, posits);
+	nrOfFailedTests += VerifyTruncation<unsigned long long>(tag, "unsigned long long", bReportIndividualTestCases, posits);
+#if defined(__SIZEOF_INT128__)
+	nrOfFailedTests += VerifyTruncation<sw::unum::int128_native>(tag, "int128", bReportIndividualTestCases, posits);
+	nrOfFailedTests += VerifyTruncation<sw::unum::uint128_native>(tag, "uint128", bReportIndividualTestCases, posits);
+#endif
+	return nrOfFailedTests;
+}
+
+// posits wider than a long double: integers up to 48 bits are exact posits and convert back to themselves,
+// a quarter added to them is truncated away, and the values beyond the range saturate
+template<size_t nbits, size_t es>
+int VerifyWidePositToInteger(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(nbits * 16 + es);
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		long long v = (long long)(eng() >> (16 + eng() % 48));
+		if (i % 2) v = -v;
+		posit<nbits, es> p(v);
+		posit<nbits, es> q = p + posit<nbits, es>(v < 0 ? -0.25 : 0.25);
+		if ((long long)p != v || (long long)q != v) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " " << v << " converts back to " << (long long)p << " and " << (long long)q << std::endl;
+		}
+#if defined(__SIZEOF_INT128__)
+		// 110-bit integers are exact only in posits with enough fraction bits
+		int128_native w = (int128_native(v) << 62) + (v < 0 ? -1 : 1);
+		if (posit<nbits, es>::fbits >= 126 && int128_native(posit<nbits, es>(w)) != w) ++nrOfFailedTests;
+#endif
+	}
+	posit<nbits, es> maxpos = sw::unum::maxpos<nbits, es>(), nar;
+	nar.setnar();
+	if ((long long)maxpos != std::numeric_limits<long long>::max() || (long long)(-maxpos) != std::numeric_limits<long long>::min()) ++nrOfFailedTests;
+	if ((unsigned long long)(-maxpos) != 0 || (unsigned int)maxpos != std::numeric_limits<unsigned int>::max()) ++nrOfFailedTests;
+	if ((long long)nar != std::numeric_limits<long long>::min()) ++nrOfFailedTests;
+	if ((long long)posit<nbits, es>(-0.75) != 0 || (int)posit<nbits, es>(-1.75) != -1) ++nrOfFailedTests;
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Integer conversion failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerToPosit<16, 1>(tag, true, 100), "posit<16,1>", "integer to posit");
+
+#else
+
+	cout << "Integer to posit conversion validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerToPosit<  8, 0>(tag, bReportIndividualTestCases, 1000), "posit<  8,0>", "integer to posit");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerToPosit< 16, 1>(tag, bReportIndividualTestCases, 1000), "posit< 16,1>", "integer to posit");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerToPosit< 24, 5>(tag, bReportIndividualTestCases, 1000), "posit< 24,5>", "integer to posit");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerToPosit< 32, 2>(tag, bReportIndividualTestCases, 1000), "posit< 32,2>", "integer to posit");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerToPosit< 64, 3>(tag, bReportIndividualTestCases, 1000), "posit< 64,3>", "integer to posit");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerToPosit< 80, 2>(tag, bReportIndividualTestCases, 1000), "posit< 80,2>", "integer to posit");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerToPosit<128, 4>(tag, bReportIndividualTestCases, 1000), "posit<128,4>", "integer to posit");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerToPosit<160, 6>(tag, bReportIndividualTestCases, 500), "posit<160,6>", "integer to posit");
+
+	cout << "Posit to integer conversion validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToInteger<  8, 0>(tag, bReportIndividualTestCases, 0), "posit<  8,0>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToInteger< 12, 2>(tag, bReportIndividualTestCases, 0), "posit< 12,2>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToInteger< 16, 1>(tag, bReportIndividualTestCases, 0), "posit< 16,1>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToInteger< 24, 5>(tag, bReportIndividualTestCases, 5000), "posit< 24,5>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToInteger< 32, 2>(tag, bReportIndividualTestCases, 5000), "posit< 32,2>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToInteger< 48, 3>(tag, bReportIndividualTestCases, 5000), "posit< 48,3>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToInteger< 64, 3>(tag, bReportIndividualTestCases, 5000), "posit< 64,3>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToInteger< 64, 5>(tag, bReportIndividualTestCases, 5000), "posit< 64,5>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositToInteger< 80, 2>(tag, bReportIndividualTestCases, 1000), "posit< 80,2>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositToInteger<128, 4>(tag, bReportIndividualTestCases, 1000), "posit<128,4>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositToInteger<160, 6>(tag, bReportIndividualTestCases, 1000), "posit<160,6>", "posit to integer");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyPositToInteger< 20, 1>(tag, bReportIndividualTestCases, 0), "posit< 20,1>", "posit to integer");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerToPosit<256, 5>(tag, bReportIndividualTestCases, 100000), "posit<256,5>", "integer to posit");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,247 @@
+// conversion_posit.cpp: functional tests for the conversion between posit configurations
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <vector>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+#include "../../posit/posit_cast.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+
+// the exact value of a posit up to 64 bits as a long double
+template<size_t nbits, size_t es>
+long double ExactValue(const sw::unum::posit<nbits, es>& p) {
+	using namespace sw::unum;
+	bool sign;
+	int scale;
+	bitblock<p.fbits> fraction;
+	decode<nbits, es>(p.get(), sign, scale, fraction);
+	long double significand = 1.0l;
+	for (int i = int(p.fbits) - 1; i >= 0; --i) significand = 2 * significand + (fraction[i] ? 1 : 0);
+	long double v = std::ldexp(significand, scale - int(p.fbits));
+	return (sign ? -v : v);
+}
+
+// the reference conversion through value<>, which holds all fraction bits of the source and rounds them with convert()
+template<size_t tnbits, size_t tes, size_t nbits, size_t es>
+sw::unum::posit<tnbits, tes> ReferenceConversion(const sw::unum::posit<nbits, es>& p) {
+	using namespace sw::unum;
+	posit<tnbits, tes> t;
+	if (p.iszero()) {
+		t.setzero();
+		return t;
+	}
+	if (p.isnar()) {
+		t.setnar();
+		return t;
+	}
+	bool sign;
+	int scale;
+	bitblock<p.fbits> fraction;
+	decode<nbits, es>(p.get(), sign, scale, fraction);
+	value<p.fbits> v(sign, scale, fraction, false);
+	return convert(v, t);
+}
+
+// posits up to 64 bits are exact in a long double, whose conversion to the target rounds once
+template<size_t tnbits, size_t tes, size_t nbits, size_t es>
+int VerifyPositCast(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	static_assert(nbits - es <= 66, "reference requires the value of the posit to be exact in a long double");
+	std::mt19937_64 eng(nbits * 16 + es);
+	std::vector< posit<nbits, es> > posits;
+	posit<nbits, es> p;
+	if (nbits <= 16) {
+		for (uint64_t bits = 0; bits < (uint64_t(1) << nbits); ++bits) posits.push_back(p.set_raw_bits(bits));
+	}
+	else {
+		for (size_t i = 0; i < nrOfRandoms; ++i) posits.push_back(p.set_raw_bits(eng()));
+	}
+	int nrOfFailedTests = 0;
+	for (const auto& a : posits) {
+		posit<tnbits, tes> t = posit_cast<tnbits, tes>(a), reference;
+		if (a.isnar()) reference.setnar();
+		else if (a.iszero()) reference.setzero();
+		else reference = ExactValue(a);
+		if (t != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " " << posit_format(a) << " converts to " << posit_format(t) << " golden reference is " << posit_format(reference) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// configurations beyond a long double are verified against the value<> pipeline
+template<size_t tnbits, size_t tes, size_t nbits, size_t es>
+int VerifyWidePositCast(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(nbits * 16 + es);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		bitblock<nbits> raw_bits;
+		for (size_t b = 0; b < nbits; b += 64) {
+			uint64_t word = eng();
+			for (size_t j = 0; j < 64 && b + j < nbits; ++j) raw_bits[b + j] = ((word >> j) & 1) != 0;
+		}
+		// sparse fractions exercise the ties and the sticky bit below the 128-bit significand
+		if (i % 4 == 0) {
+			for (size_t j = 0; j + 8 < nbits; ++j) raw_bits[j] = false;
+			raw_bits[eng() % (nbits - 8)] = true;
+		}
+		posit<nbits, es> p;
+		p.set(raw_bits);
+		posit<tnbits, tes> t = posit_cast<tnbits, tes>(p), reference = ReferenceConversion<tnbits, tes>(p);
+		if (t != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " " << posit_format(p) << " converts to " << posit_format(t) << " golden reference is " << posit_format(reference) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// a posit<nbits,es> is exact in a wider posit with the same es, so widening and narrowing back is the identity
+template<size_t nbits, size_t es, size_t wnbits>
+int VerifyRoundTrip(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(nbits * 16 + es);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		bitblock<nbits> raw_bits;
+		for (size_t b = 0; b < nbits; b += 64) {
+			uint64_t word = eng();
+			for (size_t j = 0; j < 64 && b + j < nbits; ++j) raw_bits[b + j] = ((word >> j) & 1) != 0;
+		}
+		posit<nbits, es> p;
+		p.set(raw_bits);
+		posit<wnbits, es> w = posit_cast<wnbits, es>(p);
+		posit<nbits, es> q = posit_cast<nbits, es>(w);
+		if (q != p) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " " << posit_format(p) << " returns as " << posit_format(q) << " through " << posit_format(w) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the strided and vector conversions produce the scalar conversions
+int VerifyArrayCast(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	constexpr size_t N = 97;
+	std::mt19937_64 eng(0);
+	std::vector< posit<32, 2> > x(2 * N);
+	for (auto& v : x) v.set_raw_bits(eng());
+	std::vector< posit<16, 1> > y(3 * N);
+	posit_cast(N, x.data() + 1, 2, y.data(), 3);
+	std::vector< posit<8, 0> > z = posit_cast<8, 0>(x);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < N; ++i) {
+		if (y[3 * i] != posit_cast<16, 1>(x[2 * i + 1]) || !y[3 * i + 1].iszero()) ++nrOfFailedTests;
+	}
+	if (z.size() != x.size()) return nrOfFailedTests + 1;
+	for (size_t i = 0; i < x.size(); ++i) {
+		if (z[i] != posit_cast<8, 0>(x[i])) ++nrOfFailedTests;
+	}
+	if (nrOfFailedTests > 0 && bReportIndividualTestCases) std::cerr << tag << " array conversions differ from the scalar conversions" << std::endl;
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Posit conversion failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast<8, 0, 16, 1>(tag, true, 0), "posit<16,1> to posit<8,0>", "posit_cast");
+
+#else
+
+	cout << "Posit to posit conversion validation" << endl;
+
+	// narrowing
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast<  8, 0,  16, 1>(tag, bReportIndividualTestCases, 0), "posit< 16,1> to posit<  8,0>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast<  4, 1,  12, 2>(tag, bReportIndividualTestCases, 0), "posit< 12,2> to posit<  4,1>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast< 16, 1,  32, 2>(tag, bReportIndividualTestCases, 100000), "posit< 32,2> to posit< 16,1>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast<  8, 0,  32, 2>(tag, bReportIndividualTestCases, 100000), "posit< 32,2> to posit<  8,0>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast< 32, 2,  64, 3>(tag, bReportIndividualTestCases, 100000), "posit< 64,3> to posit< 32,2>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast< 24, 5,  48, 1>(tag, bReportIndividualTestCases, 100000), "posit< 48,1> to posit< 24,5>", "posit_cast");
+	// widening and changing the exponent size
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast< 16, 1,   8, 0>(tag, bReportIndividualTestCases, 0), "posit<  8,0> to posit< 16,1>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast< 12, 0,  16, 3>(tag, bReportIndividualTestCases, 0), "posit< 16,3> to posit< 12,0>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast< 64, 3,  32, 2>(tag, bReportIndividualTestCases, 100000), "posit< 32,2> to posit< 64,3>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast< 80, 2,  32, 2>(tag, bReportIndividualTestCases, 10000), "posit< 32,2> to posit< 80,2>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast<128, 4,  64, 3>(tag, bReportIndividualTestCases, 10000), "posit< 64,3> to posit<128,4>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast<  2, 0,   8, 0>(tag, bReportIndividualTestCases, 0), "posit<  8,0> to posit<  2,0>", "posit_cast");
+
+	// configurations beyond a long double
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositCast< 32, 2, 128, 4>(tag, bReportIndividualTestCases, 10000), "posit<128,4> to posit< 32,2>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositCast< 64, 3, 256, 5>(tag, bReportIndividualTestCases, 10000), "posit<256,5> to posit< 64,3>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositCast<128, 4, 256, 5>(tag, bReportIndividualTestCases, 10000), "posit<256,5> to posit<128,4>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositCast< 80, 2, 128, 4>(tag, bReportIndividualTestCases, 10000), "posit<128,4> to posit< 80,2>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositCast<160, 5, 256, 5>(tag, bReportIndividualTestCases, 2000), "posit<256,5> to posit<160,5>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositCast<256, 5, 128, 4>(tag, bReportIndividualTestCases, 2000), "posit<128,4> to posit<256,5>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyWidePositCast< 16, 1, 200, 7>(tag, bReportIndividualTestCases, 2000), "posit<200,7> to posit< 16,1>", "posit_cast");
+
+	// widening is exact
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<  8, 0,  16>(tag, bReportIndividualTestCases, 1000), "posit<  8,0> through posit< 16,0>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip< 32, 2,  80>(tag, bReportIndividualTestCases, 10000), "posit< 32,2> through posit< 80,2>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip< 64, 3, 128>(tag, bReportIndividualTestCases, 10000), "posit< 64,3> through posit<128,3>", "posit_cast");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<128, 4, 256>(tag, bReportIndividualTestCases, 10000), "posit<128,4> through posit<256,4>", "posit_cast");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayCast(tag, bReportIndividualTestCases), "strided and vector", "posit_cast");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyPositCast< 16, 1,  20, 1>(tag, bReportIndividualTestCases, 0), "posit< 20,1> to posit< 16,1>", "posit_cast");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
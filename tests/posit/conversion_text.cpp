@@ -0,0 +1,412 @@
+// conversion_text.cpp: functional tests for the conversion of decimal and posit format text to posits
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <vector>
+#include <cstring>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+#include "../../posit/posit_cast.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+
+// arbitrary precision decimal integer in base 10^9 limbs, least significant limb first
+class DecimalInteger {
+public:
+	DecimalInteger() : limbs(1, 0) {}
+	void multiply_add(uint32_t m, uint32_t a) {
+		uint64_t carry = a;
+		for (auto& limb : limbs) {
+			uint64_t t = uint64_t(limb) * m + carry;
+			limb = uint32_t(t % BASE);
+			carry = t / BASE;
+		}
+		if (carry) limbs.push_back(uint32_t(carry));
+	}
+	void decrement() {
+		for (auto& limb : limbs) {
+			if (limb > 0) {
+				--limb;
+				break;
+			}
+			limb = BASE - 1;
+		}
+		if (limbs.size() > 1 && limbs.back() == 0) limbs.pop_back();
+	}
+	std::string str() const {
+		std::string digits = std::to_string(limbs.back());
+		for (size_t i = limbs.size() - 1; i > 0; --i) {
+			std::string limb = std::to_string(limbs[i - 1]);
+			digits += std::string(9 - limb.size(), '0') + limb;
+		}
+		return digits;
+	}
+private:
+	static constexpr uint32_t BASE = 1000000000;
+	std::vector<uint32_t> limbs;
+};
+
+// the exact value of a posit as an integer significand N and a decimal exponent: value = N * 10^exponent
+template<size_t nbits, size_t es>
+DecimalInteger ExactDecimal(const sw::unum::posit<nbits, es>& p, int& exponent) {
+	using namespace sw::unum;
+	constexpr size_t fbits = posit<nbits, es>::fbits;
+	bool sign;
+	int scale;
+	bitblock<fbits> fraction;
+	decode<nbits, es>(p.get(), sign, scale, fraction);
+	DecimalInteger n;
+	n.multiply_add(1, 1);
+	for (int i = int(fbits) - 1; i >= 0; --i) n.multiply_add(2, fraction[i] ? 1 : 0);
+	int q = scale - int(fbits);
+	for (int i = 0; i < q; ++i) n.multiply_add(2, 0);
+	for (int i = 0; i > q; --i) n.multiply_add(5, 0);
+	exponent = (q < 0 ? q : 0);
+	return n;
+}
+
+// the same decimal number with a fixed decimal point instead of an exponent, padded with leading zeros when needed
+std::string FixedNotation(const std::string& digits, int exponent) {
+	if (exponent >= 0) return digits + std::string(exponent, '0');
+	size_t point = size_t(-exponent);
+	if (point >= digits.size()) return "0." + std::string(point - digits.size(), '0') + digits;
+	return digits.substr(0, digits.size() - point) + "." + digits.substr(digits.size() - point);
+}
+
+template<size_t nbits, size_t es>
+bool ParseAndCompare(const std::string& txt, const sw::unum::posit<nbits, es>& expected, const std::string& tag, bool bReportIndividualTestCases) {
+	sw::unum::posit<nbits, es> p;
+	bool ok = sw::unum::parse(txt, p) && p == expected;
+	if (!ok && bReportIndividualTestCases) {
+		std::cerr << tag << " " << (txt.size() > 80 ? txt.substr(0, 77) + "..." : txt) << " -> " << posit_format(p) << " expected " << posit_format(expected) << std::endl;
+	}
+	return ok;
+}
+
+// Each rounding boundary between two adjacent posits a and a+1 is the posit<nbits+1,es> in between them.
+// Its exact decimal expansion must round to the even encoding of the two, and the smallest perturbation
+// above and below it, one decimal digit further or thousands of digits further, must round to a+1 and a.
+template<size_t nbits, size_t es>
+int VerifyRoundingBoundaries(std::string tag, bool bReportIndividualTestCases, size_t nrRandoms) {
+	using namespace sw::unum;
+	const size_t NR_ENCODINGS = (size_t(1) << (nbits < 64 ? nbits - 1 : 0)) - 1;    // below maxpos
+	std::mt19937_64 eng(nbits * 16 + es);
+	std::uniform_int_distribution<uint64_t> distr;
+	bool exhaustive = (nrRandoms == 0);
+	size_t nrTests = (exhaustive ? NR_ENCODINGS - 1 : nrRandoms);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrTests; ++i) {
+		bitblock<nbits> lower;
+		if (exhaustive) {
+			lower = convert_to_bitblock<nbits>(uint64_t(i + 1));
+		}
+		else {
+			do {
+				for (size_t b = 0; b < nbits - 1; b += 64) {
+					uint64_t r = distr(eng);
+					for (size_t j = 0; j < 64 && b + j < nbits - 1; ++j) lower[b + j] = (r >> j) & 1;
+				}
+			} while (lower.none() || lower.count() == nbits - 1);
+		}
+		posit<nbits, es> a, b;
+		a.set(lower);
+		b = a;
+		++b;
+		bitblock<nbits + 1> between;
+		between[0] = true;
+		for (size_t j = 0; j < nbits; ++j) between[j + 1] = lower[j];
+		posit<nbits + 1, es> boundary;
+		boundary.set(between);
+
+		int exponent;
+		DecimalInteger n = ExactDecimal(boundary, exponent);
+		std::string digits = n.str();
+		n.decrement();
+		std::string below = n.str() + "9";
+		const posit<nbits, es>& even = (lower[0] ? b : a);
+		std::string e = "e" + std::to_string(exponent);
+		std::string e1 = "e" + std::to_string(exponent - 1);
+
+		int failures = 0;
+		failures += !ParseAndCompare(digits + e, even, tag, bReportIndividualTestCases);
+		failures += !ParseAndCompare("-" + digits + e, -even, tag, bReportIndividualTestCases);
+		failures += !ParseAndCompare(FixedNotation(digits, exponent), even, tag, bReportIndividualTestCases);
+		failures += !ParseAndCompare(digits + "1" + e1, b, tag, bReportIndividualTestCases);
+		failures += !ParseAndCompare(below + e1, a, tag, bReportIndividualTestCases);
+		failures += !ParseAndCompare("-" + FixedNotation(below, exponent - 1), -a, tag, bReportIndividualTestCases);
+		if (i % 64 == 0) {
+			// the perturbation lies beyond the significant digits the scanner accumulates and only survives as the sticky bit
+			std::string zeros(4000, '0');
+			failures += !ParseAndCompare(digits + zeros + "1e" + std::to_string(exponent - 4001), b, tag, bReportIndividualTestCases);
+			failures += !ParseAndCompare(FixedNotation(digits + zeros + "1", exponent - 4001), b, tag, bReportIndividualTestCases);
+			failures += !ParseAndCompare(FixedNotation(below + std::string(4000, '9'), exponent - 4001), a, tag, bReportIndividualTestCases);
+		}
+		nrOfFailedTests += (failures > 0);
+	}
+	return nrOfFailedTests;
+}
+
+// the exact decimal expansion of every posit rounds to itself
+template<size_t nbits, size_t es>
+int VerifyExactDecimal(std::string tag, bool bReportIndividualTestCases, size_t nrRandoms) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(nbits * 32 + es);
+	std::uniform_int_distribution<uint64_t> distr;
+	bool exhaustive = (nrRandoms == 0);
+	size_t nrTests = (exhaustive ? (size_t(1) << (nbits < 64 ? nbits : 0)) : nrRandoms);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrTests; ++i) {
+		bitblock<nbits> raw;
+		for (size_t b = 0; b < nbits; b += 64) {
+			uint64_t r = (exhaustive ? uint64_t(i) : distr(eng));
+			for (size_t j = 0; j < 64 && b + j < nbits; ++j) raw[b + j] = (exhaustive && b > 0 ? false : ((r >> j) & 1));
+		}
+		if (!exhaustive && i < 2) {
+			// minpos and maxpos, which have the longest decimal expansions
+			raw.reset();
+			for (size_t j = 0; j < (i == 0 ? 1 : nbits - 1); ++j) raw[j] = true;
+		}
+		posit<nbits, es> p;
+		p.set(raw);
+		if (p.iszero() || p.isnar()) continue;
+		int exponent;
+		std::string digits = ExactDecimal(p, exponent).str();
+		if (p.isneg()) digits = "-" + digits;
+		nrOfFailedTests += !ParseAndCompare(digits + "e" + std::to_string(exponent), p, tag, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
+// the posit format of a posit in the same configuration round-trips the encoding, including zero and NaR
+template<size_t nbits, size_t es>
+int VerifyPositFormat(std::string tag, bool bReportIndividualTestCases, size_t nrRandoms) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(nbits * 64 + es);
+	std::uniform_int_distribution<uint64_t> distr;
+	bool exhaustive = (nrRandoms == 0);
+	size_t nrTests = (exhaustive ? (size_t(1) << (nbits < 64 ? nbits : 0)) : nrRandoms + 2);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrTests; ++i) {
+		posit<nbits, es> p;
+		if (exhaustive || i < 2) {
+			bitblock<nbits> raw;
+			if (exhaustive) raw = convert_to_bitblock<nbits>(uint64_t(i));
+			else raw[nbits - 1] = (i == 1);
+			p.set(raw);
+		}
+		else {
+			bitblock<nbits> raw;
+			for (size_t b = 0; b < nbits; b += 64) {
+				uint64_t r = distr(eng);
+				for (size_t j = 0; j < 64 && b + j < nbits; ++j) raw[b + j] = (r >> j) & 1;
+			}
+			p.set(raw);
+		}
+		nrOfFailedTests += !ParseAndCompare(posit_format(p), p, tag, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
+// the posit format of another configuration converts by value with a single rounding, as posit_cast does
+template<size_t nbits, size_t es, size_t snbits, size_t ses>
+int VerifyForeignPositFormat(std::string tag, bool bReportIndividualTestCases, size_t nrRandoms) {
+	using namespace sw::unum;
+	std::mt19937_64 eng(snbits * 64 + ses);
+	std::uniform_int_distribution<uint64_t> distr;
+	bool exhaustive = (nrRandoms == 0);
+	size_t nrTests = (exhaustive ? (size_t(1) << (snbits < 64 ? snbits : 0)) : nrRandoms);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrTests; ++i) {
+		bitblock<snbits> raw;
+		for (size_t b = 0; b < snbits; b += 64) {
+			uint64_t r = (exhaustive ? uint64_t(i) : distr(eng));
+			for (size_t j = 0; j < 64 && b + j < snbits; ++j) raw[b + j] = (exhaustive && b > 0 ? false : ((r >> j) & 1));
+		}
+		posit<snbits, ses> s;
+		s.set(raw);
+		nrOfFailedTests += !ParseAndCompare(posit_format(s), posit_cast<nbits, es>(s), tag, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
+// syntax, error reporting, and saturation of from_chars and parse
+int VerifySyntax(std::string tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	using Posit = posit<32, 2>;
+	Posit maxpos, minpos, nar;
+	maxpos.set_raw_bits(0x7FFFFFFFull);
+	minpos.set_raw_bits(0x00000001ull);
+	nar.setnar();
+	struct Case {
+		const char* txt;
+		size_t consumed;      // 0 for an error
+		Posit expected;
+	} cases[] = {
+		{ "1.5e+", 3, Posit(1.5) },
+		{ "1.5e-x", 3, Posit(1.5) },
+		{ "1e", 1, Posit(1) },
+		{ "1e5x", 3, Posit(1.0e5) },
+		{ "1E+03", 5, Posit(1000) },
+		{ ".5", 2, Posit(0.5) },
+		{ "5.", 2, Posit(5) },
+		{ "+2.25", 5, Posit(2.25) },
+		{ "-0.0", 4, Posit(0) },
+		{ "0e999999999", 11, Posit(0) },
+		{ "000000000000000000000000000000000000000042", 42, Posit(42) },
+		{ "0x10", 1, Posit(0) },
+		{ "12abc", 2, Posit(12) },
+		{ "1e999999999999999999999", 23, maxpos },
+		{ "-1e999999999", 12, -maxpos },
+		{ "1e-999999999999999999999", 24, minpos },
+		{ "-1e-40", 6, -minpos },
+		{ "nar", 3, nar },
+		{ "NaR", 3, nar },
+		{ "-nan", 4, nar },
+		{ "inf", 3, nar },
+		{ "Infinity", 8, nar },
+		{ "32.2x40000000p", 14, Posit(1) },
+		{ "32.2xc0000000p", 14, Posit(-1) },
+		{ "32.2x40000000", 13, Posit(1) },
+		{ "32.2x", 4, Posit(32.2) },
+		{ "8.0x40p", 7, Posit(1) },
+		{ "8.0x80p", 7, nar },
+		{ "64.3x4000000000000000p", 22, Posit(1) },
+		{ "", 0, Posit(7) },
+		{ "-", 0, Posit(7) },
+		{ ".", 0, Posit(7) },
+		{ "e5", 0, Posit(7) },
+		{ " 1", 0, Posit(7) },
+		{ "-.e1", 0, Posit(7) },
+		{ "8.0x1ffp", 3, Posit(8) },
+		{ "1.0x1p", 3, Posit(1) },
+		{ "1.5x3", 3, Posit(1.5) },
+		{ "32.31x0p", 5, Posit(32.31) },
+	};
+	int nrOfFailedTests = 0;
+	for (const Case& c : cases) {
+		Posit p(7);
+		size_t length = std::strlen(c.txt);
+		from_chars_result result = from_chars(c.txt, c.txt + length, p);
+		bool ok = (c.consumed == 0 ? result.ec != std::errc() && result.ptr == c.txt : result.ec == std::errc() && size_t(result.ptr - c.txt) == c.consumed);
+		ok = ok && p == c.expected;
+		// parse accepts a string only when from_chars consumes all of it, and leaves the posit unchanged otherwise
+		Posit q(7);
+		bool accepted = (c.consumed > 0 && c.consumed == length);
+		ok = ok && parse(std::string(c.txt), q) == accepted && q == (accepted ? c.expected : Posit(7));
+		if (!ok) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " '" << c.txt << "' -> " << posit_format(p) << " consumed " << (result.ptr - c.txt) << " expected " << posit_format(c.expected) << " consumed " << c.consumed << std::endl;
+		}
+	}
+	// a well-known constant with more digits than any of the configurations hold
+	const std::string pi = "3.14159265358979323846264338327950288419716939937510582097494459230781640628620899862803482534211706798214808651";
+	nrOfFailedTests += !ParseAndCompare(pi, posit<32, 2>(3.141592653589793238462643383279502884l), tag, bReportIndividualTestCases);
+	nrOfFailedTests += !ParseAndCompare(pi, posit<64, 3>(3.141592653589793238462643383279502884l), tag, bReportIndividualTestCases);
+	posit<128, 4> wide_pi;
+	nrOfFailedTests += !(parse(pi, wide_pi) && posit_format(wide_pi) == "128.4x43243f6a8885a308d313198a2e037073p");
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Text conversion failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingBoundaries<8, 0>(tag, true, 0), "posit<8,0>", "decimal boundaries");
+
+#else
+
+	cout << "Decimal and posit format text to posit conversion validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifySyntax(tag, bReportIndividualTestCases), "posit< 32,2>", "syntax");
+
+	// correctly rounded decimal conversion
+	nrOfFailedTestCases += ReportTestResult(VerifyExactDecimal<  8, 0>(tag, bReportIndividualTestCases, 0), "posit<  8,0>", "exact decimal");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactDecimal< 12, 3>(tag, bReportIndividualTestCases, 0), "posit< 12,3>", "exact decimal");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactDecimal< 32, 2>(tag, bReportIndividualTestCases, 2000), "posit< 32,2>", "exact decimal");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactDecimal< 64, 3>(tag, bReportIndividualTestCases, 2000), "posit< 64,3>", "exact decimal");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactDecimal<128, 4>(tag, bReportIndividualTestCases, 500), "posit<128,4>", "exact decimal");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactDecimal<256, 5>(tag, bReportIndividualTestCases, 100), "posit<256,5>", "exact decimal");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingBoundaries<  8, 0>(tag, bReportIndividualTestCases, 0), "posit<  8,0>", "decimal boundaries");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingBoundaries< 10, 2>(tag, bReportIndividualTestCases, 0), "posit< 10,2>", "decimal boundaries");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingBoundaries< 16, 1>(tag, bReportIndividualTestCases, 2000), "posit< 16,1>", "decimal boundaries");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingBoundaries< 32, 2>(tag, bReportIndividualTestCases, 2000), "posit< 32,2>", "decimal boundaries");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingBoundaries< 48, 4>(tag, bReportIndividualTestCases, 1000), "posit< 48,4>", "decimal boundaries");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingBoundaries< 63, 3>(tag, bReportIndividualTestCases, 1000), "posit< 63,3>", "decimal boundaries");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingBoundaries< 80, 2>(tag, bReportIndividualTestCases, 500), "posit< 80,2>", "decimal boundaries");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingBoundaries<128, 4>(tag, bReportIndividualTestCases, 200), "posit<128,4>", "decimal boundaries");
+
+	// posit format
+	nrOfFailedTestCases += ReportTestResult(VerifyPositFormat<  8, 0>(tag, bReportIndividualTestCases, 0), "posit<  8,0>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositFormat< 16, 1>(tag, bReportIndividualTestCases, 0), "posit< 16,1>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositFormat< 32, 2>(tag, bReportIndividualTestCases, 10000), "posit< 32,2>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositFormat< 64, 3>(tag, bReportIndividualTestCases, 10000), "posit< 64,3>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositFormat<128, 4>(tag, bReportIndividualTestCases, 1000), "posit<128,4>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyPositFormat<256, 5>(tag, bReportIndividualTestCases, 1000), "posit<256,5>", "posit format");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyForeignPositFormat<  8, 0, 16, 1>(tag, bReportIndividualTestCases, 0), "posit< 16,1> to posit<  8,0>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyForeignPositFormat< 16, 1,  8, 0>(tag, bReportIndividualTestCases, 0), "posit<  8,0> to posit< 16,1>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyForeignPositFormat< 16, 1, 32, 2>(tag, bReportIndividualTestCases, 10000), "posit< 32,2> to posit< 16,1>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyForeignPositFormat< 32, 2, 64, 3>(tag, bReportIndividualTestCases, 10000), "posit< 64,3> to posit< 32,2>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyForeignPositFormat< 64, 3, 12, 0>(tag, bReportIndividualTestCases, 0), "posit< 12,0> to posit< 64,3>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyForeignPositFormat< 32, 2, 128, 4>(tag, bReportIndividualTestCases, 1000), "posit<128,4> to posit< 32,2>", "posit format");
+	nrOfFailedTestCases += ReportTestResult(VerifyForeignPositFormat<128, 4, 256, 5>(tag, bReportIndividualTestCases, 1000), "posit<256,5> to posit<128,4>", "posit format");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingBoundaries< 16, 1>(tag, bReportIndividualTestCases, 0), "posit< 16,1>", "decimal boundaries");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactDecimal< 16, 2>(tag, bReportIndividualTestCases, 0), "posit< 16,2>", "exact decimal");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,188 @@
+// decoded_arithmetic.cpp: functional tests for arithmetic on unpacked posits
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+#include "../../posit/posit_decoded.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+#include "../../posit/math_functions.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+
+enum DecodedOpcode { DECODED_ADD, DECODED_SUB, DECODED_MUL, DECODED_DIV, DECODED_SQRT };
+
+template<size_t nbits, size_t es>
+sw::unum::posit<nbits, es> PositOperation(DecodedOpcode opcode, const sw::unum::posit<nbits, es>& a, const sw::unum::posit<nbits, es>& b) {
+	switch (opcode) {
+	case DECODED_ADD:  return a + b;
+	case DECODED_SUB:  return a - b;
+	case DECODED_MUL:  return a * b;
+	case DECODED_DIV:  return a / b;
+	case DECODED_SQRT: return sw::unum::sqrt(a);
+	}
+	return a;
+}
+
+template<size_t nbits, size_t es>
+sw::unum::posit_decoded<nbits, es> DecodedOperation(DecodedOpcode opcode, const sw::unum::posit_decoded<nbits, es>& a, const sw::unum::posit_decoded<nbits, es>& b) {
+	switch (opcode) {
+	case DECODED_ADD:  return a + b;
+	case DECODED_SUB:  return a - b;
+	case DECODED_MUL:  return a * b;
+	case DECODED_DIV:  return a / b;
+	case DECODED_SQRT: return sw::unum::sqrt(a);
+	}
+	return a;
+}
+
+template<size_t nbits, size_t es>
+void ReportDecodedError(const std::string& test_case, DecodedOpcode opcode, uint64_t a, uint64_t b, uint64_t result, uint64_t reference) {
+	static const char* op[] = { " + ", " - ", " * ", " / ", " sqrt " };
+	std::cerr << test_case << std::hex << " 0x" << a << op[opcode] << "0x" << b
+		<< " != 0x" << result << " golden reference is 0x" << reference << std::dec << std::endl;
+}
+
+// enumerate all operand pairs of a small posit configuration: unpack, operate, and pack must match the posit operator
+template<size_t nbits, size_t es>
+int VerifyDecodedOperation(const std::string& tag, bool bReportIndividualTestCases, DecodedOpcode opcode) {
+	using namespace sw::unum;
+	constexpr uint64_t NR_POSITS = (uint64_t(1) << nbits);
+	int nrOfFailedTests = 0;
+	posit<nbits, es> pa, pb;
+	for (uint64_t a = 0; a < NR_POSITS; ++a) {
+		pa.set_raw_bits(a);
+		for (uint64_t b = 0; b < (opcode == DECODED_SQRT ? 1 : NR_POSITS); ++b) {
+			pb.set_raw_bits(b);
+			uint64_t result = pack(DecodedOperation(opcode, unpack(pa), unpack(pb))).encoding();
+			uint64_t reference = PositOperation(opcode, pa, pb).encoding();
+			if (result != reference) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) ReportDecodedError<nbits, es>(tag, opcode, a, b, result, reference);
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// run a long chain of operations on posits and on unpacked posits side by side:
+// every intermediate of the unpacked chain must pack into the posit of the posit chain
+template<size_t nbits, size_t es>
+int VerifyDecodedChain(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfOperations) {
+	using namespace sw::unum;
+	constexpr uint64_t mask = native_arithmetic<nbits, es>::mask;
+	std::mt19937_64 generator(nbits * 8 + es);
+	std::uniform_real_distribution<double> distr(-4.0, 4.0);
+	int nrOfFailedTests = 0;
+	posit<nbits, es> p(1.0);
+	posit_decoded<nbits, es> d(p);
+	for (size_t i = 0; i < nrOfOperations; ++i) {
+		posit<nbits, es> operand;
+		if (i % 8 == 7) operand.set_raw_bits(generator() & mask); else operand = distr(generator);
+		DecodedOpcode opcode = DecodedOpcode(i % 5);
+		uint64_t before = p.encoding();
+		p = PositOperation(opcode, p, operand);
+		d = DecodedOperation(opcode, d, unpack(operand));
+		if (pack(d).encoding() != p.encoding()) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) ReportDecodedError<nbits, es>(tag, opcode, before, operand.encoding(), pack(d).encoding(), p.encoding());
+		}
+		// restart the chain when it has collapsed onto zero or NaR
+		if (p.iszero() || p.isnar()) {
+			p = 1.0;
+			d = p;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyDecodedArithmetic(const std::string& tag, bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	for (DecodedOpcode opcode : { DECODED_ADD, DECODED_SUB, DECODED_MUL, DECODED_DIV, DECODED_SQRT }) {
+		nrOfFailedTests += VerifyDecodedOperation<nbits, es>(tag, bReportIndividualTestCases, opcode);
+	}
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Decoded arithmetic failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedOperation<5, 1>(tag, true, DECODED_ADD), "posit<5,1>", "decoded add");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedChain<32, 2>(tag, true, 1000), "posit<32,2>", "decoded chain");
+
+#else
+
+	cout << "Unpacked posit arithmetic validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedArithmetic<4, 0>(tag, bReportIndividualTestCases), "posit<4,0>", "decoded arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedArithmetic<6, 1>(tag, bReportIndividualTestCases), "posit<6,1>", "decoded arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedArithmetic<7, 3>(tag, bReportIndividualTestCases), "posit<7,3>", "decoded arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedArithmetic<8, 0>(tag, bReportIndividualTestCases), "posit<8,0>", "decoded arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedArithmetic<8, 2>(tag, bReportIndividualTestCases), "posit<8,2>", "decoded arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedArithmetic<9, 4>(tag, bReportIndividualTestCases), "posit<9,4>", "decoded arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedChain<16, 1>(tag, bReportIndividualTestCases, 100000), "posit<16,1>", "decoded chain");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedChain<24, 1>(tag, bReportIndividualTestCases, 100000), "posit<24,1>", "decoded chain");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedChain<32, 2>(tag, bReportIndividualTestCases, 100000), "posit<32,2>", "decoded chain");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedChain<48, 2>(tag, bReportIndividualTestCases, 100000), "posit<48,2>", "decoded chain");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedChain<64, 3>(tag, bReportIndividualTestCases, 100000), "posit<64,3>", "decoded chain");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedArithmetic<10, 1>(tag, bReportIndividualTestCases), "posit<10,1>", "decoded arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodedChain<64, 4>(tag, bReportIndividualTestCases, 10000000), "posit<64,4>", "decoded chain");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,168 @@
+// deferred_quire.cpp: functional tests for the quire accumulation mode with deferred carry propagation
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+#include "../../posit/quire.hpp"
+#include "../../posit/deferred_quire.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+
+template<size_t nbits, size_t es, size_t capacity>
+void ReportDeferredQuireError(const std::string& test_case, size_t i, const sw::unum::deferred_quire<nbits, es, capacity>& dq, const sw::unum::quire<nbits, es, capacity>& q) {
+	std::cerr << test_case << " after " << i << " addends\n" << dq << " golden reference is\n" << q << std::endl;
+}
+
+// the resolved deferred quire must match the quire after every addend, with the sign of the sum crossing zero often
+template<size_t nbits, size_t es, size_t capacity>
+int VerifyDeferredAccumulation(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	typedef posit<nbits, es> Posit;
+	std::mt19937_64 generator(nbits * 8 + es);
+	std::uniform_int_distribution<unsigned long long> distr;
+	int nrOfFailedTests = 0;
+	quire<nbits, es, capacity> q;
+	deferred_quire<nbits, es, capacity> dq;
+	Posit a, b;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		a.set_raw_bits(distr(generator));
+		b.set_raw_bits(distr(generator));
+		if (a.isnar() || b.isnar() || a.iszero() || b.iszero()) continue;
+		switch (i % 4) {
+		case 0:	q += quire_mul(a, b); dq += quire_mul(a, b); break;
+		case 1:	q -= quire_mul(a, b); dq -= quire_mul(a, b); break;
+		case 2: q += a; dq += a; break;
+		case 3:
+			// cancel the previous product exactly, leaving the sum close to zero
+			q -= quire_mul(a, b); dq -= quire_mul(a, b);
+			q += quire_mul(a, b); dq += quire_mul(a, b);
+			break;
+		}
+		if (dq != q) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) ReportDeferredQuireError(tag, i, dq, q);
+		}
+	}
+	// continue from a negative quire
+	q = int64_t(-1);
+	dq = q;
+	for (size_t i = 0; i < 64; ++i) {
+		q += quire_mul(sw::unum::minpos<nbits, es>(), sw::unum::minpos<nbits, es>());
+		dq += quire_mul(sw::unum::minpos<nbits, es>(), sw::unum::minpos<nbits, es>());
+	}
+	q += Posit(1);
+	dq += Posit(1);
+	if (dq != q) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportDeferredQuireError(tag, 64, dq, q);
+	}
+	return nrOfFailedTests;
+}
+
+// carries that ripple through the upper and capacity segments are deferred until the quire is read
+template<size_t nbits, size_t es, size_t capacity>
+int VerifyDeferredCarries(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	posit<nbits, es> maxpos = sw::unum::maxpos<nbits, es>(), minpos = sw::unum::minpos<nbits, es>();
+	quire<nbits, es, capacity> q;
+	deferred_quire<nbits, es, capacity> dq;
+	// fill the capacity segment with maxpos^2 and take a minpos^2 away, so every bit of the quire is involved
+	constexpr size_t NR_OF_TERMS = (size_t(1) << (capacity - 1)) - 1;
+	for (size_t i = 0; i < NR_OF_TERMS; ++i) {
+		q += quire_mul(maxpos, maxpos);
+		dq += quire_mul(maxpos, maxpos);
+	}
+	q -= quire_mul(minpos, minpos);
+	dq -= quire_mul(minpos, minpos);
+	if (dq != q) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportDeferredQuireError(tag, NR_OF_TERMS + 1, dq, q);
+	}
+	// and remove it all again, the borrows are deferred as well
+	for (size_t i = 0; i < NR_OF_TERMS; ++i) dq -= quire_mul(maxpos, maxpos);
+	dq += quire_mul(minpos, minpos);
+	if (!dq.iszero() || dq.sign()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportDeferredQuireError(tag, 2 * NR_OF_TERMS + 2, dq, quire<nbits, es, capacity>());
+	}
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Deferred quire failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyDeferredAccumulation<16, 1, 10>(tag, true, 100), "quire<16,1,10>", "deferred accumulation");
+
+#else
+
+	cout << "Deferred quire validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDeferredAccumulation< 8, 0,  4>(tag, bReportIndividualTestCases, 10000), "quire< 8,0,4>", "deferred accumulation");
+	nrOfFailedTestCases += ReportTestResult(VerifyDeferredAccumulation<16, 1, 10>(tag, bReportIndividualTestCases, 10000), "quire<16,1,10>", "deferred accumulation");
+	nrOfFailedTestCases += ReportTestResult(VerifyDeferredAccumulation<32, 2, 30>(tag, bReportIndividualTestCases, 10000), "quire<32,2,30>", "deferred accumulation");
+	nrOfFailedTestCases += ReportTestResult(VerifyDeferredAccumulation<64, 3, 30>(tag, bReportIndividualTestCases, 10000), "quire<64,3,30>", "deferred accumulation");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDeferredCarries< 8, 0,  4>(tag, bReportIndividualTestCases), "quire< 8,0,4>", "deferred carries");
+	nrOfFailedTestCases += ReportTestResult(VerifyDeferredCarries<16, 1, 10>(tag, bReportIndividualTestCases), "quire<16,1,10>", "deferred carries");
+	nrOfFailedTestCases += ReportTestResult(VerifyDeferredCarries<32, 2, 10>(tag, bReportIndividualTestCases), "quire<32,2,10>", "deferred carries");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyDeferredCarries<32, 2, 20>(tag, bReportIndividualTestCases), "quire<32,2,20>", "deferred carries");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,171 @@
+// fdp_kernels.cpp: functional tests for the posit<8,0> and posit<16,1> fused dot product kernels
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <vector>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+#include "../../posit/quire.hpp"
+#include "../../posit/fused_expressions.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+#include "../posit_test_helpers.hpp"
+
+// the kernel must match the accumulation of the products one at a time, as a quire and as a rounded dot product
+template<size_t nbits, size_t es>
+int VerifyKernelDot(const std::string& tag, bool bReportIndividualTestCases, size_t n) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	std::vector< posit<nbits, es> > x, y;
+	GenerateDotProductOperands(n, x, y, true);
+	quire<nbits, es> qref, q(int64_t(-3));
+	for (size_t i = 0; i < n; ++i) qref.add_product(x[i], y[i]);
+	posit<nbits, es> presult = fdp(x, y), preference;
+	convert(qref.to_value(), preference);
+	if (presult != preference) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " n = " << n << " fdp = " << presult.get() << " golden reference is " << preference.get() << std::endl;
+	}
+	// continue a quire that holds a negative integer
+	fdp(q, x, y);
+	qref += quire<nbits, es>(int64_t(-3));
+	if (q != qref) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " n = " << n << " fdp(q) = " << q << " golden reference is " << qref << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+// the scalar and the AVX2 kernels must produce the same lanes
+template<size_t nbits, size_t es>
+int VerifyKernelLanes(const std::string& tag, bool bReportIndividualTestCases, size_t n) {
+	using namespace sw::unum;
+	typedef fdp_kernel<nbits, es> Kernel;
+	typedef typename Kernel::encoding_type Encoding;
+	int nrOfFailedTests = 0;
+	std::vector< posit<nbits, es> > x, y;
+	GenerateDotProductOperands(n, x, y, true);
+	std::vector<Encoding> xe(n), ye(n);
+	for (size_t i = 0; i < n; ++i) {
+		xe[i] = Encoding(x[i].encoding());
+		ye[i] = Encoding(y[i].encoding());
+	}
+	quire<nbits, es> qscalar, qdispatch;
+	typename Kernel::lanes scalar, dispatched;
+	Kernel::dot_scalar(xe.data(), ye.data(), n, scalar);
+	Kernel::dot(xe.data(), ye.data(), n, dispatched);
+	Kernel::reduce(scalar, qscalar);
+	Kernel::reduce(dispatched, qdispatch);
+	if (qscalar != qdispatch) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " n = " << n << " dispatched kernel " << qdispatch << " scalar kernel " << qscalar << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+// a NaR operand anywhere in the vectors makes the dot product NaR, and is rejected by a quire
+template<size_t nbits, size_t es>
+int VerifyKernelNaR(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+	for (size_t position : { size_t(0), size_t(7), size_t(8), size_t(4100), size_t(4200) }) {
+		std::vector< posit<nbits, es> > x, y;
+		GenerateDotProductOperands(4201, x, y, true);
+		(position % 2 ? x : y)[position].setnar();
+		if (!fdp(x, y).isnar()) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " NaR at " << position << " is not propagated" << std::endl;
+		}
+		quire<nbits, es> q(int64_t(1));
+		bool rejected = false;
+		try {
+			fdp(q, x, y);
+		}
+		catch (const operand_is_nar&) {
+			rejected = true;
+		}
+		if (!rejected || q != quire<nbits, es>(int64_t(1))) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " NaR at " << position << " modified the quire" << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "fdp kernel failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyKernelDot<16, 1>(tag, true, 17), "posit<16,1>", "fdp kernel");
+
+#else
+
+	cout << "Fused dot product kernel validation: " << (cpu_supports_avx2() ? "AVX2" : "scalar") << " kernels" << endl;
+
+	for (size_t n : { size_t(0), size_t(1), size_t(7), size_t(8), size_t(9), size_t(100), size_t(4095), size_t(4097), size_t(20000) }) {
+		nrOfFailedTestCases += ReportTestResult(VerifyKernelDot< 8, 0>(tag, bReportIndividualTestCases, n), "posit< 8,0>", "fdp n = " + std::to_string(n));
+		nrOfFailedTestCases += ReportTestResult(VerifyKernelDot<16, 1>(tag, bReportIndividualTestCases, n), "posit<16,1>", "fdp n = " + std::to_string(n));
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyKernelLanes< 8, 0>(tag, bReportIndividualTestCases, 1001), "posit< 8,0>", "scalar vs dispatched kernel");
+	nrOfFailedTestCases += ReportTestResult(VerifyKernelLanes<16, 1>(tag, bReportIndividualTestCases, 1001), "posit<16,1>", "scalar vs dispatched kernel");
+	nrOfFailedTestCases += ReportTestResult(VerifyKernelNaR< 8, 0>(tag, bReportIndividualTestCases), "posit< 8,0>", "fdp NaR");
+	nrOfFailedTestCases += ReportTestResult(VerifyKernelNaR<16, 1>(tag, bReportIndividualTestCases), "posit<16,1>", "fdp NaR");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyKernelDot< 8, 0>(tag, bReportIndividualTestCases, 10000000), "posit< 8,0>", "fdp n = 10M");
+	nrOfFailedTestCases += ReportTestResult(VerifyKernelDot<16, 1>(tag, bReportIndividualTestCases, 10000000), "posit<16,1>", "fdp n = 10M");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,370 @@
+// fused_expressions.cpp: functional tests for the quire-fused evaluation of posit expression templates
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+#include "../../posit/quire.hpp"
+#include "../../posit/fused_expressions.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+
+template<size_t nbits, size_t es>
+void ReportFusedError(const std::string& test_case, const std::string& expression, const sw::unum::posit<nbits, es>& result, const sw::unum::posit<nbits, es>& reference) {
+	std::cerr << test_case << expression << " = " << result.get() << " golden reference is " << reference.get() << std::endl;
+}
+
+// the reference accumulates the same terms in a quire by hand
+template<size_t nbits, size_t es, size_t capacity>
+sw::unum::posit<nbits, es> RoundQuire(const sw::unum::quire<nbits, es, capacity>& q) {
+	sw::unum::posit<nbits, es> p;
+	return convert(q.to_value(), p);
+}
+
+// a*b + c*d - e*f and its variants must match a hand-written quire accumulation
+template<size_t nbits, size_t es>
+int VerifySumOfProducts(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	using namespace sw::unum;
+	typedef posit<nbits, es> Posit;
+	std::mt19937_64 generator(nbits * 8 + es);
+	std::uniform_real_distribution<double> distr(-8.0, 8.0);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		Posit a(distr(generator)), b(distr(generator)), c(distr(generator)), d(distr(generator)), e(distr(generator)), f(distr(generator));
+		quire<nbits, es> q;
+
+		Posit result = fused(a)*b + fused(c)*d - fused(e)*f;
+		q += quire_mul(a, b);
+		q += quire_mul(c, d);
+		q -= quire_mul(e, f);
+		Posit reference = RoundQuire(q);
+		if (result != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) ReportFusedError(tag, "a*b + c*d - e*f", result, reference);
+		}
+
+		// posit terms and negation: g - (a*b - c) with g = e
+		result = e - (fused(a)*b - c);
+		q = 0;
+		q += e;
+		q -= quire_mul(a, b);
+		q += c;
+		reference = RoundQuire(q);
+		if (result != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) ReportFusedError(tag, "e - (a*b - c)", result, reference);
+		}
+
+		// the products cancel exactly, leaving c without any intermediate rounding
+		result = fused(a)*b - a*fused(b) + c;
+		if (result != c) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) ReportFusedError(tag, "a*b - a*b + c", result, c);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// reductions over ranges, and their continuation in an existing quire
+template<size_t nbits, size_t es>
+int VerifyRangeReductions(const std::string& tag, bool bReportIndividualTestCases, size_t n) {
+	using namespace sw::unum;
+	typedef posit<nbits, es> Posit;
+	std::mt19937_64 generator(nbits * 8 + es);
+	std::uniform_real_distribution<double> distr(-1.0, 1.0);
+	std::vector<Posit> x(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = distr(generator);
+		y[i] = distr(generator);
+	}
+	int nrOfFailedTests = 0;
+
+	quire<nbits, es, 10> q;
+	for (size_t i = 0; i < n; ++i) q += quire_mul(x[i], y[i]);
+	Posit result = evaluate<10>(fused_dot(x.begin(), x.end(), y.begin()));
+	Posit reference = RoundQuire(q);
+	if (result != reference) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "fused_dot(x, y)", result, reference);
+	}
+
+	// x.y - sum(x) continued in the quire that already holds x.y
+	quire<nbits, es, 10> qe(q);
+	qe -= fused_sum(x.begin(), x.end());
+	for (size_t i = 0; i < n; ++i) q -= x[i];
+	if (RoundQuire(qe) != RoundQuire(q)) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "x.y - sum(x)", RoundQuire(qe), RoundQuire(q));
+	}
+
+	// a vector whose exact sum is zero
+	for (size_t i = 0; i < n / 2; ++i) y[n / 2 + i] = -y[i];
+	result = fused_sum(y.begin(), y.end());
+	if (!result.iszero()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "sum(y, -y)", result, Posit(0));
+	}
+	return nrOfFailedTests;
+}
+
+// merging partial quires must reproduce the sequential accumulation bit for bit, including the capacity segment
+template<size_t nbits, size_t es>
+int VerifyQuireMerge(const std::string& tag, bool bReportIndividualTestCases, size_t n) {
+	using namespace sw::unum;
+	typedef posit<nbits, es> Posit;
+	std::mt19937_64 generator(nbits * 8 + es);
+	std::uniform_int_distribution<unsigned long long> distr;
+	int nrOfFailedTests = 0;
+
+	// products from the full dynamic range, with the sign pattern of the partial sums crossing zero
+	quire<nbits, es, 10> sequential, lower, upper;
+	for (size_t i = 0; i < n; ++i) {
+		Posit a, b;
+		a.set_raw_bits(distr(generator));
+		b.set_raw_bits(distr(generator));
+		if (a.isnar() || b.isnar() || a.iszero() || b.iszero()) continue;
+		sequential += quire_mul(a, b);
+		if (i < n / 2) lower += quire_mul(a, b); else upper += quire_mul(a, b);
+	}
+	quire<nbits, es, 10> merged(lower);
+	merged += upper;
+	if (merged != sequential) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "lower + upper", RoundQuire(merged), RoundQuire(sequential));
+	}
+	merged -= upper;
+	if (merged != lower) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "lower + upper - upper", RoundQuire(merged), RoundQuire(lower));
+	}
+	merged -= lower;
+	if (!merged.iszero() || merged.sign()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "lower - lower", RoundQuire(merged), Posit(0));
+	}
+
+	// partial sums that have grown into the capacity bits cannot be represented as a value, but merge exactly
+	Posit maxpos = sw::unum::maxpos<nbits, es>(), minpos = sw::unum::minpos<nbits, es>();
+	quire<nbits, es, 10> big, small, reference;
+	for (int i = 0; i < 8; ++i) big += quire_mul(maxpos, maxpos);
+	small -= quire_mul(minpos, minpos);
+	for (int i = 0; i < 8; ++i) reference += quire_mul(maxpos, maxpos);
+	reference -= quire_mul(minpos, minpos);
+	small += big;
+	if (small != reference) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "8*maxpos^2 - minpos^2", RoundQuire(small), RoundQuire(reference));
+	}
+	return nrOfFailedTests;
+}
+
+// the parallel dot product is bit-identical to the sequential one for any number of threads
+template<size_t nbits, size_t es>
+int VerifyParallelDot(const std::string& tag, bool bReportIndividualTestCases, size_t n) {
+	using namespace sw::unum;
+	typedef posit<nbits, es> Posit;
+	std::mt19937_64 generator(nbits * 8 + es);
+	std::uniform_int_distribution<unsigned long long> distr;
+	std::vector<Posit> x(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i].set_raw_bits(distr(generator));
+		y[i].set_raw_bits(distr(generator));
+		if (x[i].isnar()) x[i] = 0;
+		if (y[i].isnar()) y[i] = 1;
+	}
+	int nrOfFailedTests = 0;
+
+	quire<nbits, es, 10> reference;
+	for (size_t i = 0; i < n; ++i) if (!x[i].iszero() && !y[i].iszero()) reference += quire_mul(x[i], y[i]);
+	for (size_t nrThreads : { size_t(0), size_t(1), size_t(2), size_t(3), size_t(4), size_t(7), size_t(16), n + 1 }) {
+		quire<nbits, es, 10> q;
+		q += fused_dot(x.begin(), x.end(), y.begin(), nrThreads);
+		if (q != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) ReportFusedError(tag, "fused_dot(x, y, " + std::to_string(nrThreads) + ")", RoundQuire(q), RoundQuire(reference));
+		}
+		Posit result = evaluate<10>(fused_dot(x.begin(), x.end(), y.begin(), nrThreads) - fused_dot(x.begin(), x.end(), y.begin()));
+		if (!result.iszero()) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) ReportFusedError(tag, "parallel - sequential", result, Posit(0));
+		}
+	}
+
+	// a NaR anywhere in the ranges turns the parallel reduction into NaR
+	x[n - 1].setnar();
+	Posit result = fused_dot(x.begin(), x.end(), y.begin(), 4);
+	if (!result.isnar()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "fused_dot(x with NaR, y, 4)", result, x[n - 1]);
+	}
+	return nrOfFailedTests;
+}
+
+// fused dot products of the rows and columns of a matrix stored in a strided array
+template<size_t nbits, size_t es>
+int VerifyStridedDot(const std::string& tag, bool bReportIndividualTestCases, size_t d) {
+	using namespace sw::unum;
+	typedef posit<nbits, es> Posit;
+	std::mt19937_64 generator(nbits * 8 + es + 1);
+	std::uniform_int_distribution<unsigned long long> distr;
+	std::vector<Posit> A(d * d), x(d);
+	for (size_t i = 0; i < d * d; ++i) {
+		A[i].set_raw_bits(distr(generator));
+		if (A[i].isnar()) A[i] = 0;
+	}
+	for (size_t i = 0; i < d; ++i) {
+		x[i].set_raw_bits(distr(generator));
+		if (x[i].isnar()) x[i] = 1;
+	}
+	int nrOfFailedTests = 0;
+	for (size_t j = 0; j < d; ++j) {
+		// column j of A against x, and row j of A against column j of A
+		quire<nbits, es> column, row;
+		for (size_t k = 0; k < d; ++k) {
+			column.add_product(A[k * d + j], x[k]);
+			row.add_product(A[j * d + k], A[k * d + j]);
+		}
+		Posit result = fdp(d, &A[j], d, x.data(), 1), reference;
+		convert(column.to_value(), reference);
+		if (result != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) ReportFusedError(tag, "fdp(column " + std::to_string(j) + ", x)", result, reference);
+		}
+		quire<nbits, es> q(int64_t(1));
+		fdp_accumulate(q, d, &A[j * d], 1, &A[j], d);
+		row += quire<nbits, es>(int64_t(1));
+		if (q != row) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) ReportFusedError(tag, "fdp_accumulate(row " + std::to_string(j) + ", column " + std::to_string(j) + ")", RoundQuire(q), RoundQuire(row));
+		}
+	}
+
+	// a NaR between the strided elements is not part of the dot product
+	A[1].setnar();
+	if (fdp(d, &A[0], d, x.data(), 1).isnar()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "fdp(column 0 next to NaR, x)", fdp(d, &A[0], d, x.data(), 1), Posit(0));
+	}
+	// a NaR on the stride turns the dot product into NaR, and is rejected by a quire
+	A[(d - 1) * d].setnar();
+	Posit result = fdp(d, &A[0], d, x.data(), 1);
+	quire<nbits, es> q(int64_t(1));
+	bool rejected = false;
+	try {
+		fdp_accumulate(q, d, &A[0], d, x.data(), 1);
+	}
+	catch (const operand_is_nar&) {
+		rejected = true;
+	}
+	if (!result.isnar() || !rejected || q != quire<nbits, es>(int64_t(1))) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "fdp(column 0 with NaR, x)", result, A[(d - 1) * d]);
+	}
+	return nrOfFailedTests;
+}
+
+// NaR operands turn the whole expression into NaR
+template<size_t nbits, size_t es>
+int VerifyNaRPropagation(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	typedef posit<nbits, es> Posit;
+	int nrOfFailedTests = 0;
+	Posit a(1.5), b(-2.0), nar;
+	nar.setnar();
+	Posit result = fused(a)*b + fused(nar)*a;
+	if (!result.isnar()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "a*b + NaR*a", result, nar);
+	}
+	result = fused(a)*b - nar;
+	if (!result.isnar()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) ReportFusedError(tag, "a*b - NaR", result, nar);
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyFusedExpressions(const std::string& tag, bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	nrOfFailedTests += VerifySumOfProducts<nbits, es>(tag, bReportIndividualTestCases, 1000);
+	nrOfFailedTests += VerifyRangeReductions<nbits, es>(tag, bReportIndividualTestCases, 256);
+	nrOfFailedTests += VerifyNaRPropagation<nbits, es>(tag, bReportIndividualTestCases);
+	nrOfFailedTests += VerifyQuireMerge<nbits, es>(tag, bReportIndividualTestCases, 1000);
+	nrOfFailedTests += VerifyParallelDot<nbits, es>(tag, bReportIndividualTestCases, 1000);
+	nrOfFailedTests += VerifyStridedDot<nbits, es>(tag, bReportIndividualTestCases, 67);
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Fused expression failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifySumOfProducts<16, 1>(tag, true, 10), "posit<16,1>", "sum of products");
+
+#else
+
+	cout << "Posit quire-fused expression validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedExpressions< 8, 0>(tag, bReportIndividualTestCases), "posit< 8,0>", "fused expressions");
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedExpressions<16, 1>(tag, bReportIndividualTestCases), "posit<16,1>", "fused expressions");
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedExpressions<24, 1>(tag, bReportIndividualTestCases), "posit<24,1>", "fused expressions");
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedExpressions<32, 2>(tag, bReportIndividualTestCases), "posit<32,2>", "fused expressions");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedExpressions<64, 3>(tag, bReportIndividualTestCases), "posit<64,3>", "fused expressions");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
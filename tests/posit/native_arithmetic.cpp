@@ -0,0 +1,247 @@
+// native_arithmetic.cpp: functional tests for the integer-encoded arithmetic of posits that fit in a machine word
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+
+enum NativeOpcode { NATIVE_ADD, NATIVE_SUB, NATIVE_MUL, NATIVE_DIV, NATIVE_SQRT };
+
+// reference result through the value<> pipeline that the native engine replaces
+template<size_t nbits, size_t es>
+uint64_t ReferenceOperation(NativeOpcode opcode, uint64_t a, uint64_t b) {
+	using namespace sw::unum;
+	using Posit = posit<nbits, es>;
+	Posit pa, pb, presult;
+	pa.set_raw_bits(a);
+	pb.set_raw_bits(b);
+	if (pa.isnar() || pb.isnar()) {
+		presult.setnar();
+		return presult.encoding();
+	}
+	value<Posit::fbits> va, vb;
+	pa.normalize(va);
+	pb.normalize(vb);
+	switch (opcode) {
+	case NATIVE_ADD:
+	case NATIVE_SUB:
+		{
+			if (pa.iszero()) return (opcode == NATIVE_SUB ? (-pb).encoding() : b);
+			if (pb.iszero()) return a;
+			value<Posit::abits + 1> sum;
+			if (opcode == NATIVE_SUB) {
+				module_subtract<Posit::fbits, Posit::abits>(va, vb, sum);
+			}
+			else {
+				module_add<Posit::fbits, Posit::abits>(va, vb, sum);
+			}
+			if (sum.iszero()) return 0;
+			convert(sum, presult);
+		}
+		break;
+	case NATIVE_MUL:
+		{
+			if (pa.iszero() || pb.iszero()) return 0;
+			value<Posit::mbits> product;
+			module_multiply(va, vb, product);
+			convert(product, presult);
+		}
+		break;
+	case NATIVE_DIV:
+		{
+			if (pb.iszero()) {
+				presult.setnar();
+				return presult.encoding();
+			}
+			if (pa.iszero()) return 0;
+			value<Posit::divbits> ratio;
+			module_divide(va, vb, ratio);
+			convert<nbits, es, Posit::divbits>(ratio, presult);
+		}
+		break;
+	case NATIVE_SQRT:
+		if (pa.isneg()) {
+			presult.setnar();
+			return presult.encoding();
+		}
+		presult = std::sqrt((long double)pa);
+		break;
+	}
+	return presult.encoding();
+}
+
+template<size_t nbits, size_t es>
+uint64_t NativeOperation(NativeOpcode opcode, uint64_t a, uint64_t b) {
+	using Native = sw::unum::native_arithmetic<nbits, es>;
+	switch (opcode) {
+	case NATIVE_ADD:  return Native::add(a, b);
+	case NATIVE_SUB:  return Native::sub(a, b);
+	case NATIVE_MUL:  return Native::mul(a, b);
+	case NATIVE_DIV:  return Native::div(a, b);
+	case NATIVE_SQRT: return Native::sqrt(a);
+	}
+	return 0;
+}
+
+template<size_t nbits, size_t es>
+void ReportNativeError(const std::string& test_case, NativeOpcode opcode, uint64_t a, uint64_t b, uint64_t result, uint64_t reference) {
+	static const char* op[] = { " + ", " - ", " * ", " / ", " sqrt " };
+	std::cerr << test_case << std::hex << " 0x" << a << op[opcode] << "0x" << b
+		<< " != 0x" << result << " golden reference is 0x" << reference << std::dec << std::endl;
+}
+
+// enumerate all operand pairs of a small posit configuration
+template<size_t nbits, size_t es>
+int VerifyNativeOperation(const std::string& tag, bool bReportIndividualTestCases, NativeOpcode opcode) {
+	constexpr uint64_t NR_POSITS = (uint64_t(1) << nbits);
+	int nrOfFailedTests = 0;
+	for (uint64_t a = 0; a < NR_POSITS; ++a) {
+		for (uint64_t b = 0; b < (opcode == NATIVE_SQRT ? 1 : NR_POSITS); ++b) {
+			uint64_t result = NativeOperation<nbits, es>(opcode, a, b);
+			uint64_t reference = ReferenceOperation<nbits, es>(opcode, a, b);
+			if (result != reference) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) ReportNativeError<nbits, es>(tag, opcode, a, b, result, reference);
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// sample operand pairs of a large posit configuration, biased towards cancellation and the extreme regimes
+template<size_t nbits, size_t es>
+int VerifyNativeOperationThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, NativeOpcode opcode, size_t nrOfRandoms) {
+	constexpr uint64_t mask = sw::unum::native_arithmetic<nbits, es>::mask;
+	constexpr uint64_t maxpos = sw::unum::native_arithmetic<nbits, es>::maxpos;
+	std::mt19937_64 generator(nbits * 8 + es);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < nrOfRandoms; ++i) {
+		uint64_t a = generator() & mask;
+		uint64_t b = generator() & mask;
+		switch (i % 4) {
+		case 1: b = (a + (generator() & 0xFF)) & mask; break;            // nearby magnitude
+		case 2: b = (~a + 1 + (generator() & 0xF)) & mask; break;        // nearby magnitude of opposite sign
+		case 3: a = (i & 4 ? generator() & 0xFF : maxpos - (generator() & 0xFF)); break;
+		default: break;
+		}
+		if (opcode == NATIVE_SQRT) {
+			a &= maxpos;
+			b = 0;
+		}
+		uint64_t result = NativeOperation<nbits, es>(opcode, a, b);
+		uint64_t reference = ReferenceOperation<nbits, es>(opcode, a, b);
+		if (result != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) ReportNativeError<nbits, es>(tag, opcode, a, b, result, reference);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyNativeArithmetic(const std::string& tag, bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	for (NativeOpcode opcode : { NATIVE_ADD, NATIVE_SUB, NATIVE_MUL, NATIVE_DIV, NATIVE_SQRT }) {
+		nrOfFailedTests += VerifyNativeOperation<nbits, es>(tag, bReportIndividualTestCases, opcode);
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyNativeArithmeticThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	int nrOfFailedTests = 0;
+	// the long double reference of sqrt double rounds for posits wider than 48 bits
+	for (NativeOpcode opcode : { NATIVE_ADD, NATIVE_SUB, NATIVE_MUL, NATIVE_DIV, NATIVE_SQRT }) {
+		if (opcode == NATIVE_SQRT && nbits > 48) continue;
+		nrOfFailedTests += VerifyNativeOperationThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, opcode, nrOfRandoms);
+	}
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Native arithmetic failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeOperation<5, 1>(tag, true, NATIVE_ADD), "posit<5,1>", "native add");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeOperationThroughRandoms<64, 3>(tag, true, NATIVE_DIV, 100), "posit<64,3>", "native div");
+
+#else
+
+	cout << "Posit native integer arithmetic validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<4, 0>(tag, bReportIndividualTestCases), "posit<4,0>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<5, 1>(tag, bReportIndividualTestCases), "posit<5,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<6, 2>(tag, bReportIndividualTestCases), "posit<6,2>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<7, 3>(tag, bReportIndividualTestCases), "posit<7,3>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<8, 0>(tag, bReportIndividualTestCases), "posit<8,0>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<8, 4>(tag, bReportIndividualTestCases), "posit<8,4>", "native arithmetic");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<10, 1>(tag, bReportIndividualTestCases, 10000), "posit<10,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<12, 1>(tag, bReportIndividualTestCases, 10000), "posit<12,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<24, 1>(tag, bReportIndividualTestCases, 10000), "posit<24,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<32, 2>(tag, bReportIndividualTestCases, 10000), "posit<32,2>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<48, 2>(tag, bReportIndividualTestCases, 10000), "posit<48,2>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<64, 3>(tag, bReportIndividualTestCases, 10000), "posit<64,3>", "native arithmetic");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<10, 1>(tag, bReportIndividualTestCases), "posit<10,1>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<56, 4>(tag, bReportIndividualTestCases, 100000), "posit<56,4>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<64, 0>(tag, bReportIndividualTestCases, 100000), "posit<64,0>", "native arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<64, 4>(tag, bReportIndividualTestCases, 100000), "posit<64,4>", "native arithmetic");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,218 @@
+// quire_serialization.cpp: functional tests for the binary encoding of quires
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+#include "common.hpp"
+#include <random>
+#include <sstream>
+
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include "../../posit/posit.hpp"
+#include "../../posit/numeric_limits.hpp"
+#include "../../posit/specializations.hpp"
+#include "../../posit/quire.hpp"
+// posit type manipulators such as pretty printers
+#include "../../posit/posit_manipulators.hpp"
+// test helpers
+#include "../test_helpers.hpp"
+
+// accumulate random products, with every fourth one cancelled again so the sum crosses zero
+template<size_t nbits, size_t es, size_t capacity>
+void Accumulate(sw::unum::quire<nbits, es, capacity>& q, std::mt19937_64& eng, size_t nrOfProducts) {
+	std::uniform_int_distribution<unsigned long long> distr;
+	sw::unum::posit<nbits, es> a, b;
+	for (size_t i = 0; i < nrOfProducts; ++i) {
+		a.set_raw_bits(distr(eng));
+		b.set_raw_bits(distr(eng));
+		if (a.isnar() || b.isnar()) continue;
+		if (i % 4 == 3) q.subtract_product(a, b); else q.add_product(a, b);
+	}
+}
+
+// checkpoints taken through buffers and streams restore the exact state, including the sign and the window of limbs
+template<size_t nbits, size_t es, size_t capacity>
+int VerifyRoundTrip(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	typedef quire<nbits, es, capacity> Quire;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(nbits * 8 + es);
+	Quire q;
+	for (size_t step = 0; step < 64; ++step) {
+		// include the zero quire, and quires holding a single product
+		if (step > 0) Accumulate(q, eng, step % 8);
+		std::vector<uint8_t> buffer = q.encode();
+		Quire restored(int64_t(-5));
+		size_t consumed = restored.decode(buffer.data(), buffer.size());
+		std::stringstream ss;
+		write_binary(ss, q);
+		Quire streamed(int64_t(7));
+		read_binary(ss, streamed);
+		if (consumed != buffer.size() || buffer.size() != q.encoded_size() || restored != q || streamed != q || !ss) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " round trip of " << q << " yields " << restored << " and " << streamed << std::endl;
+		}
+		// the restored quire continues the accumulation exactly
+		Quire continued = restored;
+		continued.add_product(maxpos<nbits, es>(), minpos<nbits, es>());
+		q.add_product(maxpos<nbits, es>(), minpos<nbits, es>());
+		if (continued != q) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " continued accumulation " << continued << " golden reference is " << q << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// partial sums shipped as encodings merge into the sum of the whole accumulation
+template<size_t nbits, size_t es, size_t capacity>
+int VerifyMergeOfCheckpoints(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	typedef quire<nbits, es, capacity> Quire;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 eng(nbits * 8 + es), reference_eng(nbits * 8 + es);
+	std::stringstream channel;
+	for (int part = 0; part < 4; ++part) {
+		Quire partial;
+		Accumulate(partial, eng, 1000);
+		write_binary(channel, partial);
+	}
+	Quire reference;
+	for (int part = 0; part < 4; ++part) Accumulate(reference, reference_eng, 1000);
+	Quire sum, partial;
+	while (read_binary(channel, partial)) sum += partial;
+	if (sum != reference) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " merged checkpoints " << sum << " golden reference is " << reference << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+// invalid encodings are rejected and leave the quire unchanged
+template<size_t nbits, size_t es, size_t capacity>
+int VerifyInvalidEncodings(const std::string& tag, bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	typedef quire<nbits, es, capacity> Quire;
+	int nrOfFailedTests = 0;
+	Quire q;
+	q.add_product(maxpos<nbits, es>(), maxpos<nbits, es>());
+	q.subtract_product(minpos<nbits, es>(), minpos<nbits, es>());
+	std::vector<uint8_t> valid = q.encode();
+
+	std::vector< std::vector<uint8_t> > invalid;
+	invalid.push_back(std::vector<uint8_t>(valid.begin(), valid.end() - 1));    // truncated limbs
+	invalid.push_back(std::vector<uint8_t>(valid.begin(), valid.begin() + 5));  // truncated header
+	invalid.push_back(valid); invalid.back()[0] = 'X';                           // not a quire encoding
+	invalid.push_back(valid); invalid.back()[2] = 99;                            // unknown version
+	invalid.push_back(valid); invalid.back()[5] = uint8_t(es + 1);               // different configuration
+	invalid.push_back(valid); invalid.back()[6] ^= 1;                            // different capacity
+	invalid.push_back(valid); invalid.back()[8] = 2;                             // invalid sign
+	invalid.push_back(valid); invalid.back()[13] = uint8_t(Quire::qlimbs + 1);  // too many limbs
+	invalid.push_back(valid); invalid.back().back() = 0xFF;                      // bits beyond the capacity segment
+	for (size_t i = 0; i < invalid.size(); ++i) {
+		Quire target(int64_t(3));
+		bool rejected = false;
+		try {
+			target.decode(invalid[i].data(), invalid[i].size());
+		}
+		catch (const quire_encoding_error&) {
+			rejected = true;
+		}
+		if (!rejected || target != Quire(int64_t(3))) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cerr << tag << " invalid encoding " << i << " was not rejected" << std::endl;
+		}
+	}
+	// a buffer that is too small
+	std::vector<uint8_t> small(valid.size() - 1);
+	bool rejected = false;
+	try {
+		q.encode(small.data(), small.size());
+	}
+	catch (const quire_encoding_error&) {
+		rejected = true;
+	}
+	if (!rejected) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " encoding into a buffer that is too small" << std::endl;
+	}
+	// a stream that ends early sets the failbit
+	std::stringstream ss(std::string(valid.begin(), valid.end() - 3));
+	Quire target(int64_t(3));
+	if (read_binary(ss, target) || target != Quire(int64_t(3))) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cerr << tag << " truncated stream was not detected" << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "Quire serialization failed: ";
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<16, 1, 10>(tag, true), "quire<16,1,10>", "round trip");
+
+#else
+
+	cout << "Quire binary encoding validation" << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip< 8, 0,  4>(tag, bReportIndividualTestCases), "quire< 8,0,4>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<16, 1, 10>(tag, bReportIndividualTestCases), "quire<16,1,10>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<32, 2, 30>(tag, bReportIndividualTestCases), "quire<32,2,30>", "round trip");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<64, 3, 63>(tag, bReportIndividualTestCases), "quire<64,3,63>", "round trip");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyMergeOfCheckpoints<16, 1, 30>(tag, bReportIndividualTestCases), "quire<16,1,30>", "merge of checkpoints");
+	nrOfFailedTestCases += ReportTestResult(VerifyMergeOfCheckpoints<64, 3, 63>(tag, bReportIndividualTestCases), "quire<64,3,63>", "merge of checkpoints");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyInvalidEncodings< 8, 0,  4>(tag, bReportIndividualTestCases), "quire< 8,0,4>", "invalid encodings");
+	nrOfFailedTestCases += ReportTestResult(VerifyInvalidEncodings<32, 2, 30>(tag, bReportIndividualTestCases), "quire<32,2,30>", "invalid encodings");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<128, 4, 63>(tag, bReportIndividualTestCases), "quire<128,4,63>", "round trip");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
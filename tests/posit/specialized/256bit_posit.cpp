@@ -1,6 +1,6 @@
 // 256bit_posit.cpp: Functionality tests for standard 256-bit posits
 //
-// Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
@@ -8,7 +8,7 @@
 // Configure the posit template environment
 // first: enable fast specialized posit<256,5>
 //#define POSIT_FAST_SPECIALIZATION   // turns on all fast specializations
-#define POSIT_FAST_POSIT_256_5 0
+#define POSIT_FAST_POSIT_256_5 1
 // second: enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 0
 #include <posit>
@@ -44,6 +44,14 @@ try {
 	posit<nbits, es> p;
 	cout << dynamic_range(p) << endl << endl;
 
+	cout << "Arithmetic tests against the value<> pipeline" << endl;
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstValuePipeline<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, 1000), tag, "addition      ");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstValuePipeline<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, 1000), tag, "subtraction   ");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstValuePipeline<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, 1000), tag, "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstValuePipeline<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, 1000), tag, "division      ");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideIntegerConversion<nbits, es>(tag, bReportIndividualTestCases, 1000), tag, "integer conv  ");
+	int nrOfFailedReferenceTestCases = nrOfFailedTestCases;
+
 	// TODO: as we don't have a reference floating point implementation to validate
 	// the arithmetic operations we are going to ignore the failures
 #if STRESS_TESTING
@@ -54,7 +62,8 @@ try {
 	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES), tag, "multiplication");
 	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES), tag, "division      ");
 #endif
-	nrOfFailedTestCases = 0;
+	// only the failures against the value<> pipeline count
+	nrOfFailedTestCases = nrOfFailedReferenceTestCases;
 	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
 catch (char const* msg) {
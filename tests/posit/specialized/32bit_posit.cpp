@@ -13,6 +13,7 @@
 #include <posit>
 #include "../../test_helpers.hpp"
 #include "../../posit_test_randoms.hpp"
+#include "../../posit_fused_helpers.hpp"
 
 /*
 Standard posit with nbits = 32 have es = 2 exponent bits.
@@ -98,6 +99,11 @@ try {
 	nrOfFailedTestCases += ReportTestResult( ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, RND_TEST_CASES),  tag, "subtraction     (native)  ");
 	nrOfFailedTestCases += ReportTestResult( ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES),  tag, "multiplication  (native)  ");
 	nrOfFailedTestCases += ReportTestResult( ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES),  tag, "division        (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateFusedOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, FUSED_FMA, 100000), tag, "fma             (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateFusedOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, FUSED_FAM, 100000), tag, "fam             (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateFusedOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, FUSED_FMMA, 100000), tag, "fmma            (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateFusedOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, FUSED_FMMS, 100000), tag, "fmms            (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateQuireProductsThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, 100000), tag, "fdp             (native)  ");
 
 	// elementary function tests
 	cout << "Elementary function tests " << endl;
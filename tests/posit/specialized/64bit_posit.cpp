@@ -8,7 +8,7 @@
 // Configure the posit template environment
 // first: enable fast specialized posit<64,3>
 // #define POSIT_FAST_SPECIALIZATION
-#define POSIT_FAST_POSIT_64_3 0
+#define POSIT_FAST_POSIT_64_3 1
 // second: enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 #include <posit>
@@ -44,6 +44,14 @@ try {
 	posit<nbits, es> p;
 	cout << dynamic_range(p) << endl << endl;
 
+	cout << "Arithmetic tests against the value<> pipeline" << endl;
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstValuePipeline<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, 10000), tag, "addition      ");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstValuePipeline<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, 10000), tag, "subtraction   ");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstValuePipeline<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, 10000), tag, "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyAgainstValuePipeline<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, 10000), tag, "division      ");
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerConversion<nbits, es>(tag, bReportIndividualTestCases, 10000), tag, "integer conv  ");
+	int nrOfFailedReferenceTestCases = nrOfFailedTestCases;
+
 	// TODO: as we don't have a reference floating point implementation to validate
 	// the arithmetic operations we are going to ignore the failures
 #if STRESS_TESTING
@@ -54,7 +62,8 @@ try {
 	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES), tag, "multiplication");
 	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES), tag, "division      ");
 #endif
-	nrOfFailedTestCases = 0;
+	// only the failures against the value<> pipeline count
+	nrOfFailedTestCases = nrOfFailedReferenceTestCases;
 	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
 catch (char const* msg) {
@@ -15,6 +15,7 @@
 #include "../../test_helpers.hpp"
 #include "../../posit_test_helpers.hpp"
 #include "../../posit_math_helpers.hpp"
+#include "../../posit_fused_helpers.hpp"
 
 /*
 Standard posits with nbits = 8 have no exponent bits, i.e. es = 0.
@@ -71,6 +72,11 @@ try {
 	nrOfFailedTestCases += ReportTestResult( ValidateDivision         <nbits, es>(tag, bReportIndividualTestCases), tag, "divide         (native)  ");
 	nrOfFailedTestCases += ReportTestResult( ValidateNegation         <nbits, es>(tag, bReportIndividualTestCases), tag, "negate         (native)  ");
 	nrOfFailedTestCases += ReportTestResult( ValidateReciprocation    <nbits, es>(tag, bReportIndividualTestCases), tag, "reciprocate    (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateFusedOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, FUSED_FMA, 100000), tag, "fma            (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateFusedOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, FUSED_FAM, 100000), tag, "fam            (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateFusedOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, FUSED_FMMA, 100000), tag, "fmma           (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateFusedOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, FUSED_FMMS, 100000), tag, "fmms           (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateQuireProductsThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, 100000), tag, "fdp            (native)  ");
 
 	// elementary function tests
 	cout << "Elementary function tests " << endl;
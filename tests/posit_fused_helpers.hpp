@@ -0,0 +1,164 @@
+#pragma once
+//  posit_fused_helpers.hpp : functions to aid in testing the fused posit operators fma, fam, and fmma.
+// Needs to be included after the posit and quire types are declared.
+//
+// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+namespace sw {
+	namespace unum {
+
+		enum FusedOpcode { FUSED_FMA, FUSED_FAM, FUSED_FMMA, FUSED_FMMS };
+
+		static const char* fused_operation_string[] = { "fma", "fam", "fmma", "fmms" };
+
+		template<size_t nbits, size_t es>
+		posit<nbits, es> FusedOperation(FusedOpcode opcode, const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c, const posit<nbits, es>& d) {
+			switch (opcode) {
+			case FUSED_FMA:  return fma(a, b, c);
+			case FUSED_FAM:  return fam(a, b, c);
+			case FUSED_FMMA: return fmma(a, b, c, d, true);
+			case FUSED_FMMS: return fmma(a, b, c, d, false);
+			}
+			return a;
+		}
+
+		// the golden reference accumulates the exact products and terms in a quire and rounds once
+		template<size_t nbits, size_t es>
+		posit<nbits, es> FusedReference(FusedOpcode opcode, const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c, const posit<nbits, es>& d) {
+			posit<nbits, es> p;
+			bool nar = a.isnar() || b.isnar() || c.isnar() || (opcode >= FUSED_FMMA && d.isnar());
+			if (nar) {
+				p.setnar();
+				return p;
+			}
+			quire<nbits, es> q;
+			switch (opcode) {
+			case FUSED_FMA:
+				if (!a.iszero() && !b.iszero()) q += quire_mul(a, b);
+				if (!c.iszero()) q += quire_value(c);
+				break;
+			case FUSED_FAM:   // (a + b)*c = a*c + b*c
+				if (!a.iszero() && !c.iszero()) q += quire_mul(a, c);
+				if (!b.iszero() && !c.iszero()) q += quire_mul(b, c);
+				break;
+			case FUSED_FMMA:
+			case FUSED_FMMS:
+				if (!a.iszero() && !b.iszero()) q += quire_mul(a, b);
+				if (!c.iszero() && !d.iszero()) {
+					if (opcode == FUSED_FMMA) q += quire_mul(c, d); else q -= quire_mul(c, d);
+				}
+				break;
+			}
+			return convert(q.to_value(), p);
+		}
+
+		template<size_t nbits, size_t es>
+		void ReportFusedOperatorError(const std::string& test_case, FusedOpcode opcode, const posit<nbits, es>& a, const posit<nbits, es>& b, const posit<nbits, es>& c, const posit<nbits, es>& d, const posit<nbits, es>& presult, const posit<nbits, es>& preference) {
+			std::cerr << test_case << " " << fused_operation_string[opcode] << "(" << a.get() << ", " << b.get() << ", " << c.get();
+			if (opcode >= FUSED_FMMA) std::cerr << ", " << d.get();
+			std::cerr << ") = " << presult.get() << " golden reference is " << preference.get()
+				<< " (" << std::setprecision(20) << presult << " vs " << preference << std::setprecision(5) << ")" << std::endl;
+		}
+
+		// enumerate all operand combinations of a small posit configuration
+		template<size_t nbits, size_t es>
+		int ValidateFusedOperator(const std::string& tag, bool bReportIndividualTestCases, FusedOpcode opcode) {
+			constexpr uint64_t NR_POSITS = (uint64_t(1) << nbits);
+			const uint64_t NR_D = (opcode >= FUSED_FMMA ? NR_POSITS : 1);
+			int nrOfFailedTests = 0;
+			posit<nbits, es> a, b, c, d, presult, preference;
+			for (uint64_t i = 0; i < NR_POSITS; ++i) {
+				a.set_raw_bits(i);
+				for (uint64_t j = 0; j < NR_POSITS; ++j) {
+					b.set_raw_bits(j);
+					for (uint64_t k = 0; k < NR_POSITS; ++k) {
+						c.set_raw_bits(k);
+						for (uint64_t l = 0; l < NR_D; ++l) {
+							d.set_raw_bits(l);
+							presult = FusedOperation(opcode, a, b, c, d);
+							preference = FusedReference(opcode, a, b, c, d);
+							if (presult != preference) {
+								++nrOfFailedTests;
+								if (bReportIndividualTestCases) ReportFusedOperatorError(tag, opcode, a, b, c, d, presult, preference);
+							}
+						}
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// random operands drawn from the full encoding space, with a bias towards products that cancel against the addend
+		template<size_t nbits, size_t es>
+		int ValidateFusedOperatorThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, FusedOpcode opcode, size_t nrOfRandoms) {
+			std::mt19937_64 eng(nbits * 16 + es * 4 + opcode);
+			std::uniform_int_distribution<unsigned long long> distr;
+			int nrOfFailedTests = 0;
+			posit<nbits, es> a, b, c, d, presult, preference;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				a.set_raw_bits(distr(eng));
+				b.set_raw_bits(distr(eng));
+				c.set_raw_bits(distr(eng));
+				d.set_raw_bits(distr(eng));
+				if (i % 4 == 3) {
+					// near cancellation: the addend is the rounded product, or the second product is a perturbation of the first
+					switch (opcode) {
+					case FUSED_FMA:  c = -(a * b); break;
+					case FUSED_FAM:  b = -a; ++b; break;
+					case FUSED_FMMA: c = -a; ++c; d = b; break;
+					case FUSED_FMMS: c = a; d = b; ++d; break;
+					}
+				}
+				presult = FusedOperation(opcode, a, b, c, d);
+				preference = FusedReference(opcode, a, b, c, d);
+				if (presult != preference) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) ReportFusedOperatorError(tag, opcode, a, b, c, d, presult, preference);
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// the quire's multiply-accumulate of posit products must match the accumulation of the value<> products of quire_mul,
+		// and the fused dot product must round that same sum
+		template<size_t nbits, size_t es>
+		int ValidateQuireProductsThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			std::mt19937_64 eng(nbits * 16 + es * 4);
+			std::uniform_int_distribution<unsigned long long> distr;
+			int nrOfFailedTests = 0;
+			std::vector< posit<nbits, es> > x(nrOfRandoms), y(nrOfRandoms);
+			quire<nbits, es> q, qref, dot;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				x[i].set_raw_bits(distr(eng));
+				y[i].set_raw_bits(distr(eng));
+				if (x[i].isnar()) x[i].setzero();
+				if (y[i].isnar()) y[i].setzero();
+				bool subtract = (i % 3 == 1);
+				if (subtract) q.subtract_product(x[i], y[i]); else q.add_product(x[i], y[i]);
+				if (!x[i].iszero() && !y[i].iszero()) {
+					if (subtract) qref -= quire_mul(x[i], y[i]); else qref += quire_mul(x[i], y[i]);
+					dot += quire_mul(x[i], y[i]);
+				}
+				if (q != qref) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cerr << tag << " multiply-accumulate of " << x[i].get() << " * " << y[i].get() << " : " << q << " golden reference is " << qref << std::endl;
+					q = qref;
+				}
+			}
+			posit<nbits, es> presult = fdp(x, y), preference;
+			convert(dot.to_value(), preference);
+			if (presult != preference) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cerr << tag << " fdp = " << presult.get() << " golden reference is " << preference.get() << std::endl;
+			}
+			return nrOfFailedTests;
+		}
+
+	} // namespace unum
+
+} // namespace sw
@@ -10,6 +10,8 @@
 #include <typeinfo>
 #include <random>
 #include <limits>
+#include <cmath>
+#include <string>
 
 namespace sw {
 	namespace unum {
@@ -1106,6 +1108,193 @@ namespace sw {
 			return nrOfFailedTestCases;
 		}
 
+		// operation opcodes
+		const int OPCODE_NOP   =  0;
+		const int OPCODE_ADD   =  1;
+		const int OPCODE_SUB   =  2;
+		const int OPCODE_MUL   =  3;
+		const int OPCODE_DIV   =  4;
+		// elementary functions with one operand
+		const int OPCODE_SQRT  =  5;
+		const int OPCODE_EXP   =  6;
+		const int OPCODE_EXP2  =  7;
+		const int OPCODE_LOG   =  8;
+		const int OPCODE_LOG2  =  9;
+		const int OPCODE_LOG10 = 10;
+		const int OPCODE_SIN   = 11;
+		const int OPCODE_COS   = 12;
+		const int OPCODE_TAN   = 13;
+		const int OPCODE_ASIN  = 14;
+		const int OPCODE_ACOS  = 15;
+		const int OPCODE_ATAN  = 16;
+		const int OPCODE_SINH  = 17;
+		const int OPCODE_COSH  = 18;
+		const int OPCODE_TANH  = 19;
+		const int OPCODE_ASINH = 20;
+		const int OPCODE_ACOSH = 21;
+		const int OPCODE_ATANH = 22;
+		// elementary functions with two operands
+		const int OPCODE_POW   = 30;
+		const int OPCODE_RAN   = 40;
+
+		// verify the operators of a posit against the bit-level value<> pipeline that serves as golden reference
+		template<size_t nbits, size_t es>
+		int VerifyAgainstValuePipeline(const std::string& tag, bool bReportIndividualTestCases, int opcode, size_t nrOfRandoms) {
+			using Posit = posit<nbits, es>;
+			constexpr size_t abits = Posit::fhbits + 3;
+			constexpr size_t mbits = 2 * Posit::fhbits;
+			constexpr size_t divbits = 3 * Posit::fhbits + 4;
+			std::mt19937_64 generator(opcode);
+			std::string op;
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				Posit pa, pb, presult, preference;
+				sw::unum::bitblock<nbits> a, b;
+				for (size_t k = 0; k < nbits; k += 64) {
+					uint64_t wa = generator(), wb = generator();
+					for (size_t bit = 0; bit < 64 && k + bit < nbits; ++bit) {
+						a[k + bit] = ((wa >> bit) & 1) != 0;
+						b[k + bit] = ((wb >> bit) & 1) != 0;
+					}
+				}
+				if (i % 2) {   // exercise cancellation
+					b = a;
+					for (size_t bit = 0; bit < 12; ++bit) b[bit] = (generator() & 1) != 0;
+				}
+				pa.set(a);
+				pb.set(b);
+				if (pa.isnar() || pb.isnar() || pa.iszero() || pb.iszero()) continue;
+				value<Posit::fbits> va, vb;
+				pa.normalize(va);
+				pb.normalize(vb);
+				switch (opcode) {
+				case OPCODE_ADD:
+					{
+						op = " + ";
+						value<abits + 1> sum;
+						module_add<Posit::fbits, abits>(va, vb, sum);
+						if (!sum.iszero()) convert(sum, preference);
+						presult = pa + pb;
+					}
+					break;
+				case OPCODE_SUB:
+					{
+						op = " - ";
+						value<abits + 1> difference;
+						module_subtract<Posit::fbits, abits>(va, vb, difference);
+						if (!difference.iszero()) convert(difference, preference);
+						presult = pa - pb;
+					}
+					break;
+				case OPCODE_MUL:
+					{
+						op = " * ";
+						value<mbits> product;
+						module_multiply(va, vb, product);
+						convert(product, preference);
+						presult = pa * pb;
+					}
+					break;
+				case OPCODE_DIV:
+					{
+						op = " / ";
+						value<divbits> ratio;
+						module_divide(va, vb, ratio);
+						convert(ratio, preference);
+						presult = pa / pb;
+					}
+					break;
+				default:
+					break;
+				}
+				if (presult != preference) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", op, pa, pb, preference, presult);
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// verify the integer conversions against the conversions through long double,
+		// which holds 64-bit integers and the values of posits up to 64 bits exactly
+		template<size_t nbits, size_t es>
+		int VerifyIntegerConversion(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			using Posit = posit<nbits, es>;
+			if (std::numeric_limits<long double>::digits < 64) return 0;
+			std::mt19937_64 generator(nbits);
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				long long v = (long long)(generator() >> (generator() % 64));
+				unsigned long long u = generator() >> (generator() % 64);
+				Posit pv(v), pu(u);
+				if (pv != Posit((long double)v) || pu != Posit((long double)u)) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cerr << tag << " integers " << v << " and " << u << " convert to " << pv << " and " << pu << std::endl;
+				}
+				Posit p;
+				p.set_raw_bits(generator());
+				if (p.isnar()) continue;
+				long double x = std::trunc((long double)p);
+				long long reference = (x >= std::ldexp(1.0l, 63) ? std::numeric_limits<long long>::max() : (x < -std::ldexp(1.0l, 63) ? std::numeric_limits<long long>::min() : (long long)x));
+				if ((long long)p != reference) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cerr << tag << " " << p << " converts to " << (long long)p << " golden reference is " << reference << std::endl;
+				}
+			}
+			return nrOfFailedTests;
+		}
+
+		// verify that 64-bit and 110-bit integers, which are exact values of posits of 128 bits and more,
+		// convert back to themselves, and that the conversions to integers truncate a fraction toward zero
+		template<size_t nbits, size_t es>
+		int VerifyWideIntegerConversion(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+			using Posit = posit<nbits, es>;
+			std::mt19937_64 generator(nbits);
+			int nrOfFailedTests = 0;
+			for (size_t i = 0; i < nrOfRandoms; ++i) {
+				long long v = (long long)(generator() >> (generator() % 64));
+				Posit p(v), q = p + Posit(v < 0 ? -0.5 : 0.5);
+				if ((long long)p != v || (long long)q != v) {
+					++nrOfFailedTests;
+					if (bReportIndividualTestCases) std::cerr << tag << " " << v << " converts back to " << (long long)p << " and " << (long long)q << std::endl;
+				}
+#if defined(__SIZEOF_INT128__)
+				int128_native w = int128_native(v >> 16) * (int128_native(1) << 62) + 1;
+				if (int128_native(Posit(w)) != w) ++nrOfFailedTests;
+#endif
+			}
+			return nrOfFailedTests;
+		}
+
+		// random dot product operands drawn from the full encoding space without NaR, with a second half in which
+		// two of every three products cancel one of the first half, so the sums cross zero and exercise the carries
+		// and borrows of the accumulator. With bExtremes, every sixteenth pair is maxpos * maxpos and minpos * -minpos
+		// to reach the outer digits; keep it off when a quire with a small capacity would overflow.
+		template<size_t nbits, size_t es>
+		void GenerateDotProductOperands(size_t n, std::vector< posit<nbits, es> >& x, std::vector< posit<nbits, es> >& y, bool bExtremes) {
+			std::mt19937_64 eng(nbits * 16 + es * 4 + n);
+			std::uniform_int_distribution<unsigned long long> distr;
+			x.resize(n);
+			y.resize(n);
+			for (size_t i = 0; i < n; ++i) {
+				x[i].set_raw_bits(distr(eng));
+				y[i].set_raw_bits(distr(eng));
+				if (x[i].isnar()) x[i] = maxpos<nbits, es>();
+				if (y[i].isnar()) y[i] = -minpos<nbits, es>();
+				if (bExtremes) {
+					switch (i % 16) {
+					case 5: x[i] = y[i] = maxpos<nbits, es>(); break;
+					case 9: x[i] = minpos<nbits, es>(); y[i] = -minpos<nbits, es>(); break;
+					default: break;
+					}
+				}
+				if (i >= n / 2 && i % 3 != 0) {
+					x[i] = -x[i - n / 2];
+					y[i] = y[i - n / 2];
+				}
+			}
+		}
+
 	} // namespace unum
 
 } // namespace sw
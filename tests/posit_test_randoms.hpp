@@ -26,35 +26,6 @@ namespace sw {
 		// where something special happens in the posit arithmetic, such as rounding,
 		// or the geometric rounding and inward projections.
 
-		// operation opcodes
-		const int OPCODE_NOP   =  0;
-		const int OPCODE_ADD   =  1;
-		const int OPCODE_SUB   =  2;
-		const int OPCODE_MUL   =  3;
-		const int OPCODE_DIV   =  4;
-		// elementary functions with one operand
-		const int OPCODE_SQRT  =  5;
-		const int OPCODE_EXP   =  6;
-		const int OPCODE_EXP2  =  7;
-		const int OPCODE_LOG   =  8;
-		const int OPCODE_LOG2  =  9;
-		const int OPCODE_LOG10 = 10;
-		const int OPCODE_SIN   = 11;
-		const int OPCODE_COS   = 12;
-		const int OPCODE_TAN   = 13;
-		const int OPCODE_ASIN  = 14;
-		const int OPCODE_ACOS  = 15;
-		const int OPCODE_ATAN  = 16;
-		const int OPCODE_SINH  = 17;
-		const int OPCODE_COSH  = 18;
-		const int OPCODE_TANH  = 19;
-		const int OPCODE_ASINH = 20;
-		const int OPCODE_ACOSH = 21;
-		const int OPCODE_ATANH = 22;
-		// elementary functions with two operands
-		const int OPCODE_POW   = 30;
-		const int OPCODE_RAN   = 40;
-
 		// Execute a binary operator
 		template<size_t nbits, size_t es>
 		void executeBinary(int opcode, double da, double db, const posit<nbits, es>& pa, const posit<nbits, es>& pb, posit<nbits, es>& preference, posit<nbits, es>& presult) {